@@ -0,0 +1,296 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Measure the channel statistics store against a per-channel struct
+**
+**  Notes:
+**    1. Replays a precomputed stream of edges on random channels with
+**       random intervals, then reads every channel's high time as the
+**       stats packet does.
+**    2. "soa" is chan_stats.c as gpio_ctrl.c uses it. "aos" is the same
+**       statistics kept in one struct per channel and updated with
+**       branches on the level. Both must produce the same statistics or
+**       the run is reported as failed.
+**    3. Output is CSV: store, channels, edges, nanoseconds per edge and
+**       nanoseconds per channel read.
+**    4. Build on any Linux host with OSAL's common_types.h, e.g.
+**         cc -O2 -I fsw/src -I <osal>/src/os/inc bench/chan_stats_bench.c \
+**            fsw/src/chan_stats.c -o chan_stats_bench
+**
+*/
+
+/*
+** Include Files:
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "chan_stats.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define BENCH_EDGES   (1 << 20)
+#define BENCH_PASSES  8
+#define BENCH_READS   4096
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+typedef struct
+{
+
+   uint64  LastEdgeNs;
+   uint64  HighNs;
+   uint64  MaxHighNs;
+   uint64  MaxLowNs;
+   uint32  ToggleCnt;
+   uint8   Level;
+
+} AosChan_t;
+
+typedef struct
+{
+
+   uint16  Chan;
+   uint32  IntervalNs;   /* Time since the previous edge on any channel */
+
+} Edge_t;
+
+
+/**********************/
+/** Global File Data **/
+/**********************/
+
+static Edge_t    Edge[BENCH_EDGES];
+static AosChan_t Aos[CHAN_STATS_MAX_CHAN];
+static CHAN_STATS_Class_t Soa;
+static uint64    HighNs[CHAN_STATS_MAX_CHAN];
+static volatile uint64 Sink;   /* Keeps the reads live */
+
+
+/*******************************/
+/** Local Function Prototypes **/
+/*******************************/
+
+static void   AosEdge(uint16 Chan, uint64 TimeNs);
+static void   AosGetHighNs(uint16 ChanCnt, uint64 TimeNs);
+static uint64 GetNs(void);
+static void   InitEdges(uint16 ChanCnt);
+static void   Report(const char* Store, uint16 ChanCnt, uint64 EdgeNs, uint64 ReadNs);
+static bool   RunBench(uint16 ChanCnt);
+
+
+/******************************************************************************
+** Function: main
+**
+*/
+int main(void)
+{
+
+   static const uint16 ChanCnt[] = { 4, 8, 16, CHAN_STATS_MAX_CHAN };
+   bool   Match = true;
+   uint16 i;
+
+   printf("store,channels,edges,ns_per_edge,ns_per_chan_read\n");
+   for (i=0; i < sizeof(ChanCnt)/sizeof(ChanCnt[0]); i++)
+   {
+      Match &= RunBench(ChanCnt[i]);
+   }
+
+   return Match ? 0 : 1;
+
+} /* End main() */
+
+
+/******************************************************************************
+** Function: AosEdge
+**
+*/
+static void AosEdge(uint16 Chan, uint64 TimeNs)
+{
+
+   AosChan_t *AosChan = &Aos[Chan];
+   uint64 IntervalNs = TimeNs - AosChan->LastEdgeNs;
+
+   if (AosChan->Level)
+   {
+      AosChan->HighNs += IntervalNs;
+      if (IntervalNs > AosChan->MaxHighNs)
+      {
+         AosChan->MaxHighNs = IntervalNs;
+      }
+   }
+   else if (IntervalNs > AosChan->MaxLowNs)
+   {
+      AosChan->MaxLowNs = IntervalNs;
+   }
+   AosChan->LastEdgeNs = TimeNs;
+   AosChan->ToggleCnt++;
+   AosChan->Level ^= 1;
+
+} /* End AosEdge() */
+
+
+/******************************************************************************
+** Function: AosGetHighNs
+**
+*/
+static void AosGetHighNs(uint16 ChanCnt, uint64 TimeNs)
+{
+
+   uint16 i;
+
+   for (i=0; i < ChanCnt; i++)
+   {
+      HighNs[i] = Aos[i].HighNs + (Aos[i].Level ? TimeNs - Aos[i].LastEdgeNs : 0);
+   }
+
+} /* End AosGetHighNs() */
+
+
+/******************************************************************************
+** Function: GetNs
+**
+*/
+static uint64 GetNs(void)
+{
+
+   struct timespec Now;
+
+   clock_gettime(CLOCK_MONOTONIC, &Now);
+
+   return (uint64)Now.tv_sec * 1000000000ULL + (uint64)Now.tv_nsec;
+
+} /* End GetNs() */
+
+
+/******************************************************************************
+** Function: InitEdges
+**
+*/
+static void InitEdges(uint16 ChanCnt)
+{
+
+   uint32 i;
+
+   srand(ChanCnt);
+   for (i=0; i < BENCH_EDGES; i++)
+   {
+      Edge[i].Chan       = rand() % ChanCnt;
+      Edge[i].IntervalNs = 1000 + rand() % 100000;
+   }
+
+} /* End InitEdges() */
+
+
+/******************************************************************************
+** Function: Report
+**
+*/
+static void Report(const char* Store, uint16 ChanCnt, uint64 EdgeNs, uint64 ReadNs)
+{
+
+   printf("%s,%u,%u,%.2f,%.3f\n", Store, ChanCnt, BENCH_EDGES*BENCH_PASSES,
+          (double)EdgeNs / ((double)BENCH_EDGES * BENCH_PASSES),
+          (double)ReadNs / ((double)BENCH_READS * ChanCnt));
+
+} /* End Report() */
+
+
+/******************************************************************************
+** Function: RunBench
+**
+** Time both stores for a channel count and check that they agree
+**
+*/
+static bool RunBench(uint16 ChanCnt)
+{
+
+   uint64 TimeNs = 0;
+   uint64 StartNs;
+   uint64 EdgeNs;
+   uint64 Out;
+   uint32 i;
+   uint16 Pass;
+   uint16 Ch;
+   bool   Match = true;
+
+   InitEdges(ChanCnt);
+
+   CHAN_STATS_Constructor(&Soa, ChanCnt, 0);
+   StartNs = GetNs();
+   for (Pass=0; Pass < BENCH_PASSES; Pass++)
+   {
+      for (i=0; i < BENCH_EDGES; i++)
+      {
+         TimeNs += Edge[i].IntervalNs;
+         CHAN_STATS_Edge(&Soa, Edge[i].Chan, Soa.Level[Edge[i].Chan] ^ 1, TimeNs);
+      }
+   }
+   EdgeNs = GetNs() - StartNs;
+   Out = 0;
+   StartNs = GetNs();
+   for (i=0; i < BENCH_READS; i++)
+   {
+      CHAN_STATS_GetHighNs(&Soa, TimeNs + i, HighNs);
+      Out ^= HighNs[i % ChanCnt];
+   }
+   Sink = Out;
+   Report("soa", ChanCnt, EdgeNs, GetNs() - StartNs);
+
+   memset(Aos, 0, sizeof(Aos));
+   TimeNs = 0;
+   StartNs = GetNs();
+   for (Pass=0; Pass < BENCH_PASSES; Pass++)
+   {
+      for (i=0; i < BENCH_EDGES; i++)
+      {
+         TimeNs += Edge[i].IntervalNs;
+         AosEdge(Edge[i].Chan, TimeNs);
+      }
+   }
+   EdgeNs = GetNs() - StartNs;
+   Out = 0;
+   StartNs = GetNs();
+   for (i=0; i < BENCH_READS; i++)
+   {
+      AosGetHighNs(ChanCnt, TimeNs + i);
+      Out ^= HighNs[i % ChanCnt];
+   }
+   Sink = Out;
+   Report("aos", ChanCnt, EdgeNs, GetNs() - StartNs);
+
+   for (Ch=0; Ch < ChanCnt && Match; Ch++)
+   {
+      Match = Soa.HighNs[Ch] == Aos[Ch].HighNs && Soa.MaxHighNs[Ch] == Aos[Ch].MaxHighNs &&
+              Soa.MaxLowNs[Ch] == Aos[Ch].MaxLowNs && Soa.ToggleCnt[Ch] == Aos[Ch].ToggleCnt &&
+              Soa.LastEdgeNs[Ch] == Aos[Ch].LastEdgeNs;
+   }
+   if (!Match)
+   {
+      fprintf(stderr, "Stores differ at channel %u with %u channels\n", Ch-1, ChanCnt);
+   }
+
+   return Match;
+
+} /* End RunBench() */
@@ -0,0 +1,282 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Measure the bit-parallel debounce filter against a per-line loop
+**
+**  Notes:
+**    1. Filters a precomputed stream of 54 line samples where each line
+**       changes level every few hundred samples, bounces for a few
+**       samples after each change and has occasional single sample
+**       glitches.
+**    2. "swar" is debounce.c as input_cap.c uses it. "loop" is the same
+**       filter written as one counter per line. Both must produce the
+**       same levels and glitch counts or the run is reported as failed.
+**    3. Output is CSV: filter, debounce samples, lines, samples filtered,
+**       debounced changes, glitches, nanoseconds per sample and
+**       nanoseconds per line sample.
+**    4. Build on any Linux host with OSAL's common_types.h, e.g.
+**         cc -O2 -I fsw/src -I <osal>/src/os/inc bench/debounce_bench.c \
+**            fsw/src/debounce.c -o debounce_bench
+**
+*/
+
+/*
+** Include Files:
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "debounce.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define BENCH_LINES       54
+#define BENCH_SAMPLES     (1 << 20)
+#define BENCH_PASSES      8
+#define BENCH_BOUNCE_LEN  6
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+typedef struct
+{
+
+   uint64  Level;
+   uint32  ChangeCnt;
+   uint32  GlitchCnt;
+   uint8   Cnt[BENCH_LINES];
+
+} LoopFilter_t;
+
+
+/**********************/
+/** Global File Data **/
+/**********************/
+
+static uint64 Sample[BENCH_SAMPLES];
+static volatile uint64 Sink;   /* Keeps the filter outputs live */
+
+
+/*******************************/
+/** Local Function Prototypes **/
+/*******************************/
+
+static uint64 GetNs(void);
+static void   InitSamples(void);
+static uint64 LoopUpdate(LoopFilter_t *Filter, uint8 Samples, uint64 Raw);
+static void   Report(const char* Filter, uint8 Samples, uint32 Changes, uint32 Glitches, uint64 Ns);
+static bool   RunBench(uint8 Samples);
+
+
+/******************************************************************************
+** Function: main
+**
+*/
+int main(void)
+{
+
+   static const uint8 Samples[] = { 1, 3, 5, 10, 15 };
+   bool   Match = true;
+   uint16 i;
+
+   InitSamples();
+
+   printf("filter,debounce_samples,lines,samples,changes,glitches,ns_per_sample,ns_per_line_sample\n");
+   for (i=0; i < sizeof(Samples)/sizeof(Samples[0]); i++)
+   {
+      Match &= RunBench(Samples[i]);
+   }
+
+   return Match ? 0 : 1;
+
+} /* End main() */
+
+
+/******************************************************************************
+** Function: GetNs
+**
+*/
+static uint64 GetNs(void)
+{
+
+   struct timespec Now;
+
+   clock_gettime(CLOCK_MONOTONIC, &Now);
+
+   return (uint64)Now.tv_sec * 1000000000ULL + (uint64)Now.tv_nsec;
+
+} /* End GetNs() */
+
+
+/******************************************************************************
+** Function: InitSamples
+**
+*/
+static void InitSamples(void)
+{
+
+   uint64 Level = 0;
+   uint64 Bounce;
+   uint32 BounceLeft[BENCH_LINES] = { 0 };
+   uint32 i;
+   uint16 Line;
+
+   srand(1);
+   for (i=0; i < BENCH_SAMPLES; i++)
+   {
+
+      Bounce = 0;
+      for (Line=0; Line < BENCH_LINES; Line++)
+      {
+         if (rand() % 400 == 0)
+         {
+            Level ^= 1ULL << Line;
+            BounceLeft[Line] = BENCH_BOUNCE_LEN;
+         }
+         if ((BounceLeft[Line] > 0 && rand() % 2) || rand() % 1000 == 0)
+         {
+            Bounce |= 1ULL << Line;
+         }
+         if (BounceLeft[Line] > 0)
+         {
+            BounceLeft[Line]--;
+         }
+      }
+      Sample[i] = Level ^ Bounce;
+
+   }
+
+} /* End InitSamples() */
+
+
+/******************************************************************************
+** Function: LoopUpdate
+**
+*/
+static uint64 LoopUpdate(LoopFilter_t *Filter, uint8 Samples, uint64 Raw)
+{
+
+   uint64 Changed = 0;
+   uint64 Bit;
+   uint16 Line;
+
+   for (Line=0; Line < BENCH_LINES; Line++)
+   {
+      Bit = 1ULL << Line;
+      if ((Raw ^ Filter->Level) & Bit)
+      {
+         if (++Filter->Cnt[Line] == Samples)
+         {
+            Filter->Level ^= Bit;
+            Filter->Cnt[Line] = 0;
+            Filter->ChangeCnt++;
+            Changed |= Bit;
+         }
+      }
+      else if (Filter->Cnt[Line] > 0)
+      {
+         Filter->Cnt[Line] = 0;
+         Filter->GlitchCnt++;
+      }
+   }
+
+   return Changed;
+
+} /* End LoopUpdate() */
+
+
+/******************************************************************************
+** Function: Report
+**
+*/
+static void Report(const char* Filter, uint8 Samples, uint32 Changes, uint32 Glitches, uint64 Ns)
+{
+
+   double SampleCnt = (double)BENCH_SAMPLES * BENCH_PASSES;
+
+   printf("%s,%u,%u,%u,%u,%u,%.2f,%.3f\n", Filter, Samples, BENCH_LINES,
+          BENCH_SAMPLES*BENCH_PASSES, Changes, Glitches,
+          (double)Ns / SampleCnt, (double)Ns / (SampleCnt * BENCH_LINES));
+
+} /* End Report() */
+
+
+/******************************************************************************
+** Function: RunBench
+**
+** Run both filters for a debounce sample count and check that they agree
+**
+*/
+static bool RunBench(uint8 Samples)
+{
+
+   DEBOUNCE_Class_t Debounce;
+   LoopFilter_t     Loop;
+   uint64 StartNs;
+   uint64 Out;
+   uint32 i;
+   uint16 Pass;
+   bool   Match = true;
+
+   /* Verify on one pass before timing */
+   DEBOUNCE_Constructor(&Debounce, Samples, 0);
+   memset(&Loop, 0, sizeof(Loop));
+   for (i=0; i < BENCH_SAMPLES && Match; i++)
+   {
+      Match = (DEBOUNCE_Update(&Debounce, Sample[i]) == LoopUpdate(&Loop, Samples, Sample[i])) &&
+              Debounce.Level == Loop.Level && Debounce.GlitchCnt == Loop.GlitchCnt;
+   }
+   if (!Match)
+   {
+      fprintf(stderr, "Filters differ at sample %u with %u debounce samples\n", i-1, Samples);
+   }
+
+   DEBOUNCE_Constructor(&Debounce, Samples, 0);
+   Out = 0;
+   StartNs = GetNs();
+   for (Pass=0; Pass < BENCH_PASSES; Pass++)
+   {
+      for (i=0; i < BENCH_SAMPLES; i++)
+      {
+         Out ^= DEBOUNCE_Update(&Debounce, Sample[i]);
+      }
+   }
+   Sink = Out;
+   Report("swar", Samples, Debounce.ChangeCnt, Debounce.GlitchCnt, GetNs() - StartNs);
+
+   memset(&Loop, 0, sizeof(Loop));
+   Out = 0;
+   StartNs = GetNs();
+   for (Pass=0; Pass < BENCH_PASSES; Pass++)
+   {
+      for (i=0; i < BENCH_SAMPLES; i++)
+      {
+         Out ^= LoopUpdate(&Loop, Samples, Sample[i]);
+      }
+   }
+   Sink = Out;
+   Report("loop", Samples, Loop.ChangeCnt, Loop.GlitchCnt, GetNs() - StartNs);
+
+   return Match;
+
+} /* End RunBench() */
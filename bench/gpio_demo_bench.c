@@ -0,0 +1,697 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Measure the app running on the host build
+**
+**  Notes:
+**    1. GPIO_DEMO_AppMain() runs unmodified on its own thread with the
+**       MOCK GPIO backend and BENCH_CHAN output channels. Commands are
+**       sent through the host SB and timed until the app's pipe is idle.
+**    2. Measures the app's memory footprint, command dispatch throughput,
+**       HK request processing time and the output edges per second the
+**       child task achieves in BLINK and PWM mode. The run fails if a
+**       command is rejected or a message is dropped.
+**    3. Dispatch replays a synthetic stream of on/off time, timing and PWM
+**       commands through ProcessCommands() and CMDMGR to the GPIO_CTRL
+**       command functions, once sending their events and once after a
+**       SetQuietCmds command, and reports the quiet mode's throughput gain.
+**       "gpio_demo_bench dispatch" only runs the dispatch benchmark.
+**    4. Sequence tables are loaded to check that the compiler accepts
+**       jumps out of a loop and within it, and rejects jumps into a loop
+**       and branches on pins that aren't configured.
+**    5. Tracing is enabled and the run ends by dumping the trace rings,
+**       which then hold the PWM run's child task events, to
+**       BENCH_TRACE_FILE.
+**    6. "gpio_demo_bench hk_idle" instead runs the default ini with the
+**       MOCK backend and HK_TLM_POLICY set to ON_CHANGE, sends HK requests
+**       at BENCH_HK_IDLE_MS intervals without any command and fails if
+**       HK or a controller packet sent with it (edge histogram, PWM or
+**       sequence) goes out more often than the first and the heartbeats.
+**    7. Output is CSV: metric, value and unit.
+**    8. Built by the host build, see the README's "Host Build" section.
+**
+*/
+
+/*
+** Include Files:
+*/
+
+#include <pthread.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <sys/stat.h>
+
+#include "host_stub.h"
+#include "gpio_demo_app.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define BENCH_CHAN       24   /* Pins 0-23, the longest list that fits an ini string */
+#define BENCH_PIPE_DEPTH "256"
+#define BENCH_CMDS       200000
+#define BENCH_CMD_STREAM 256
+#define BENCH_HK_REQS    20000
+#define BENCH_EDGE_MS    1000
+#define BENCH_TRACE_FILE "/cf/gpio_demo_trace.json"
+#define BENCH_SEQ_FILE   "/cf/gpio_demo_seq_check.json"
+#define BENCH_SEQ_TBL_ID 1   /* Second table registered by the app */
+#define BENCH_HK_IDLE_REQS 40
+#define BENCH_HK_IDLE_MS   100
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+typedef union
+{
+
+   CFE_MSG_Message_t        Msg;
+   GPIO_DEMO_SetOnTime_t    SetOnTime;
+   GPIO_DEMO_SetOffTime_t   SetOffTime;
+   GPIO_DEMO_SetTiming_t    SetTiming;
+   GPIO_DEMO_SetMode_t      SetMode;
+   GPIO_DEMO_SetPwmFreq_t   SetPwmFreq;
+   GPIO_DEMO_SetPwmDuty_t   SetPwmDuty;
+   GPIO_DEMO_SetQuietCmds_t SetQuietCmds;
+   GPIO_DEMO_DumpTrace_t    DumpTrace;
+   GPIO_DEMO_LoadTbl_t      LoadTbl;
+   CFE_MSG_CommandHeader_t  SendHk;
+
+} BenchCmd_t;
+
+typedef struct
+{
+
+   const char* Name;
+   bool        Valid;
+   const char* Program;   /* JSON array elements */
+
+} BenchSeq_t;
+
+
+/**********************/
+/** Global File Data **/
+/**********************/
+
+static BenchCmd_t CmdStream[BENCH_CMD_STREAM];
+
+/* Pin 0-23 are outputs and there are no inputs */
+static const BenchSeq_t SeqCheck[] =
+{
+   { "in_loop",        true,  "\"loop 2\", \"top:\", \"set 0\", \"wait 10\", \"if-high 1 top\", \"next\"" },
+   { "out_of_loop",    true,  "\"loop 2\", \"if-low 1 out\", \"wait 10\", \"next\", \"out:\", \"stop\"" },
+   { "to_loop_start",  true,  "\"top:\", \"loop 2\", \"wait 10\", \"next\", \"goto top\"" },
+   { "into_loop",      false, "\"goto body\", \"loop 2\", \"body:\", \"wait 10\", \"next\"" },
+   { "into_loop_next", false, "\"loop 2\", \"wait 10\", \"end:\", \"next\", \"goto end\"" },
+   { "into_inner",     false, "\"loop 2\", \"if-low 1 inner\", \"loop 3\", \"inner:\", \"wait 10\", \"next\", \"next\"" },
+   { "unconfig_pin",   false, "\"top:\", \"wait 10\", \"if-low 40 top\"" }
+};
+
+
+/*******************************/
+/** Local Function Prototypes **/
+/*******************************/
+
+static void*  AppTask(void* Arg);
+static double BenchDispatch(bool Quiet);
+static bool   BenchEdges(const char* Mode);
+static bool   BenchHk(void);
+static bool   BenchHkIdle(void);
+static void   BenchMemory(void);
+static bool   BenchSeqLoad(void);
+static bool   BenchTrace(void);
+static uint64 GetNs(void);
+static void   InitCmd(BenchCmd_t* Cmd, CFE_SB_MsgId_t MsgId, size_t Size, uint16 FuncCode);
+static void   InitCmdStream(void);
+static void   ReportProcStatus(const char* Field, const char* Metric);
+static bool   SendCmd(BenchCmd_t* Cmd);
+
+
+/******************************************************************************
+** Function: main
+**
+*/
+int main(int argc, char* argv[])
+{
+
+   char      OutPins[INITBL_MAX_CFG_STR_LEN];
+   pthread_t AppThread;
+   bool      DispatchOnly = (argc > 1 && strcmp(argv[1], "dispatch") == 0);
+   bool      HkIdleOnly   = (argc > 1 && strcmp(argv[1], "hk_idle") == 0);
+   bool      Passed = false;
+   double    CmdRate, QuietCmdRate;
+   uint16    i;
+
+   OutPins[0] = '\0';
+   for (i=0; i < BENCH_CHAN; i++)
+   {
+      sprintf(&OutPins[strlen(OutPins)], "%s%u", (i > 0 ? "," : ""), i);
+   }
+   HOST_SetIniConfig("CTRL_GPIO_BACKEND", "MOCK");
+   if (HkIdleOnly)
+   {
+      HOST_SetIniConfig("HK_TLM_POLICY", "ON_CHANGE");
+   }
+   else
+   {
+      HOST_SetIniConfig("CTRL_OUT_PINS", OutPins);
+      HOST_SetIniConfig("APP_CMD_PIPE_DEPTH", BENCH_PIPE_DEPTH);
+      HOST_SetIniConfig("APP_CMD_BATCH_LIMIT", BENCH_PIPE_DEPTH);
+      HOST_SetIniConfig("CAP_IN_PINS", "");
+      HOST_SetIniConfig("TRACE_ENABLE", "1");
+   }
+
+   pthread_create(&AppThread, NULL, AppTask, NULL);
+
+   if (HOST_ES_WaitRunning())
+   {
+      HOST_SB_WaitIdle(GpioDemo.CmdPipe);
+
+      printf("metric,value,unit\n");
+      if (HkIdleOnly)
+      {
+         Passed = BenchHkIdle();
+      }
+      else
+      {
+         if (!DispatchOnly)
+         {
+            BenchMemory();
+         }
+         InitCmdStream();
+         CmdRate      = BenchDispatch(false);
+         QuietCmdRate = BenchDispatch(true);
+         Passed = (CmdRate > 0.0 && QuietCmdRate > 0.0);
+         if (Passed)
+         {
+            printf("dispatch_quiet_gain,%.2f,ratio\n", QuietCmdRate / CmdRate);
+         }
+         if (!DispatchOnly)
+         {
+            Passed = Passed && BenchHk() && BenchEdges("BLINK") && BenchEdges("PWM") && BenchSeqLoad() && BenchTrace();
+            ReportProcStatus("VmHWM:", "peak_rss");
+         }
+      }
+   }
+   else
+   {
+      fprintf(stderr, "GPIO_DEMO app initialization failed\n");
+   }
+
+   HOST_ES_Stop();
+   pthread_join(AppThread, NULL);
+
+   return Passed ? 0 : 1;
+
+} /* End main() */
+
+
+/******************************************************************************
+** Function: AppTask
+**
+*/
+static void* AppTask(void* Arg)
+{
+
+   GPIO_DEMO_AppMain();
+
+   return NULL;
+
+} /* End AppTask() */
+
+
+/******************************************************************************
+** Function: BenchDispatch
+**
+** Replay the command stream as fast as the app's pipe accepts it and return
+** the commands per second
+**
+** Notes:
+**   1. The SetQuietCmds command is sent before the timed run and its event
+**      isn't counted.
+**
+*/
+static double BenchDispatch(bool Quiet)
+{
+
+   const char*  Prefix = Quiet ? "dispatch_quiet" : "dispatch";
+   BenchCmd_t   Cmd;
+   HOST_Stats_t Start, End;
+   uint16 ValidCmdCnt;
+   uint64 StartNs, ElapsedNs;
+   uint32 i;
+
+   InitCmd(&Cmd, GpioDemo.CmdMid, sizeof(GPIO_DEMO_SetQuietCmds_t), GPIO_DEMO_SET_QUIET_CMDS_CC);
+   Cmd.SetQuietCmds.Payload.Quiet = Quiet;
+   if (!SendCmd(&Cmd))
+   {
+      return 0.0;
+   }
+   ValidCmdCnt = GpioDemo.CmdMgr.ValidCmdCnt;
+
+   HOST_GetStats(&Start);
+   StartNs = GetNs();
+   for (i=0; i < BENCH_CMDS; i++)
+   {
+      HOST_SB_SendWait(&CmdStream[i % BENCH_CMD_STREAM].Msg);
+   }
+   HOST_SB_WaitIdle(GpioDemo.CmdPipe);
+   ElapsedNs = GetNs() - StartNs;
+   HOST_GetStats(&End);
+
+   printf("%s_cmds,%u,count\n", Prefix, BENCH_CMDS);
+   printf("%s_rate,%.0f,cmds_per_s\n", Prefix, BENCH_CMDS * 1e9 / ElapsedNs);
+   printf("%s_latency,%.1f,ns_per_cmd\n", Prefix, (double)ElapsedNs / BENCH_CMDS);
+   printf("%s_events,%u,count\n", Prefix, End.EventCnt - Start.EventCnt);
+   printf("%s_sb_msgs,%.2f,msgs_per_cmd\n", Prefix, (double)(End.MsgCnt - Start.MsgCnt) / BENCH_CMDS);
+
+   if ((uint16)(GpioDemo.CmdMgr.ValidCmdCnt - ValidCmdCnt) != (uint16)BENCH_CMDS ||
+       End.PipeOverflowCnt != Start.PipeOverflowCnt)
+   {
+      return 0.0;
+   }
+
+   return BENCH_CMDS * 1e9 / ElapsedNs;
+
+} /* End BenchDispatch() */
+
+
+/******************************************************************************
+** Function: BenchEdges
+**
+** Count the output edges over BENCH_EDGE_MS with every channel toggling as
+** fast as Mode allows: 1ms on/off in BLINK, CTRL_PWM_MAX_FREQ at 50% duty
+** in PWM
+**
+*/
+static bool BenchEdges(const char* Mode)
+{
+
+   BenchCmd_t Cmd;
+   bool   Pwm = (strcmp(Mode, "PWM") == 0);
+   uint32 ToggleCnt = 0;
+   uint32 BankWriteCnt;
+   uint64 StartNs, ElapsedNs;
+   uint16 i;
+   struct timespec Delay = { BENCH_EDGE_MS / 1000, (BENCH_EDGE_MS % 1000) * 1000000L };
+
+   if (Pwm)
+   {
+      InitCmd(&Cmd, GpioDemo.CmdMid, sizeof(GPIO_DEMO_SetPwmFreq_t), GPIO_DEMO_SET_PWM_FREQ_CC);
+      Cmd.SetPwmFreq.Payload.Channel = GPIO_CTRL_ALL_CHAN;
+      Cmd.SetPwmFreq.Payload.FreqHz  = INITBL_GetIntConfig(&GpioDemo.IniTbl, CFG_CTRL_PWM_MAX_FREQ);
+      SendCmd(&Cmd);
+      InitCmd(&Cmd, GpioDemo.CmdMid, sizeof(GPIO_DEMO_SetPwmDuty_t), GPIO_DEMO_SET_PWM_DUTY_CC);
+      Cmd.SetPwmDuty.Payload.Channel = GPIO_CTRL_ALL_CHAN;
+      Cmd.SetPwmDuty.Payload.Duty    = 5000;
+      SendCmd(&Cmd);
+   }
+   else
+   {
+      InitCmd(&Cmd, GpioDemo.CmdMid, sizeof(GPIO_DEMO_SetOnTime_t), GPIO_DEMO_SET_ON_TIME_CC);
+      Cmd.SetOnTime.Payload.OnTime = 1;
+      SendCmd(&Cmd);
+      InitCmd(&Cmd, GpioDemo.CmdMid, sizeof(GPIO_DEMO_SetOffTime_t), GPIO_DEMO_SET_OFF_TIME_CC);
+      Cmd.SetOffTime.Payload.OffTime = 1;
+      SendCmd(&Cmd);
+   }
+   InitCmd(&Cmd, GpioDemo.CmdMid, sizeof(GPIO_DEMO_SetMode_t), GPIO_DEMO_SET_MODE_CC);
+   Cmd.SetMode.Payload.Mode = Pwm ? GPIO_DEMO_CtrlMode_PWM : GPIO_DEMO_CtrlMode_BLINK;
+   if (!SendCmd(&Cmd))
+   {
+      return false;
+   }
+   nanosleep(&Delay, NULL);   /* Let the child task pick up the new timing */
+
+   for (i=0; i < GpioDemo.GpioCtrl.ChanCnt; i++)
+   {
+      ToggleCnt -= __atomic_load_n(&GpioDemo.GpioCtrl.ChanStats.ToggleCnt[i], __ATOMIC_RELAXED);
+   }
+   BankWriteCnt = __atomic_load_n(&GpioDemo.GpioCtrl.BankWriteCnt, __ATOMIC_RELAXED);
+   StartNs = GetNs();
+
+   nanosleep(&Delay, NULL);
+
+   for (i=0; i < GpioDemo.GpioCtrl.ChanCnt; i++)
+   {
+      ToggleCnt += __atomic_load_n(&GpioDemo.GpioCtrl.ChanStats.ToggleCnt[i], __ATOMIC_RELAXED);
+   }
+   BankWriteCnt = __atomic_load_n(&GpioDemo.GpioCtrl.BankWriteCnt, __ATOMIC_RELAXED) - BankWriteCnt;
+   ElapsedNs = GetNs() - StartNs;
+
+   printf("%s_channels,%u,count\n", Pwm ? "pwm" : "blink", GpioDemo.GpioCtrl.ChanCnt);
+   printf("%s_edge_rate,%.0f,edges_per_s\n", Pwm ? "pwm" : "blink", ToggleCnt * 1e9 / ElapsedNs);
+   printf("%s_bank_write_rate,%.0f,writes_per_s\n", Pwm ? "pwm" : "blink", BankWriteCnt * 1e9 / ElapsedNs);
+
+   return (ToggleCnt > 0);
+
+} /* End BenchEdges() */
+
+
+/******************************************************************************
+** Function: BenchHk
+**
+** Send HK requests as fast as the app's pipe accepts them
+**
+*/
+static bool BenchHk(void)
+{
+
+   BenchCmd_t   Cmd;
+   HOST_Stats_t Start, End;
+   uint64 StartNs, ElapsedNs;
+   uint32 i;
+
+   InitCmd(&Cmd, GpioDemo.SendHkMid, sizeof(CFE_MSG_CommandHeader_t), 0);
+
+   HOST_GetStats(&Start);
+   StartNs = GetNs();
+   for (i=0; i < BENCH_HK_REQS; i++)
+   {
+      HOST_SB_SendWait(&Cmd.Msg);
+   }
+   HOST_SB_WaitIdle(GpioDemo.CmdPipe);
+   ElapsedNs = GetNs() - StartNs;
+   HOST_GetStats(&End);
+
+   printf("hk_reqs,%u,count\n", BENCH_HK_REQS);
+   printf("hk_latency,%.1f,ns_per_req\n", (double)ElapsedNs / BENCH_HK_REQS);
+   printf("hk_tlm_msgs,%u,count\n", End.MsgCnt - Start.MsgCnt - BENCH_HK_REQS);
+   printf("hk_tlm_bytes,%.1f,bytes_per_req\n",
+          (double)(End.MsgByteCnt - Start.MsgByteCnt - BENCH_HK_REQS*sizeof(CFE_MSG_CommandHeader_t)) / BENCH_HK_REQS);
+
+   return (End.PipeOverflowCnt == Start.PipeOverflowCnt);
+
+} /* End BenchHk() */
+
+
+/******************************************************************************
+** Function: BenchHkIdle
+**
+** Send HK requests to an idle ON_CHANGE app and check that it only sends
+** the first HK and one per HK_TLM_HEARTBEAT requests, and the same for
+** each controller packet
+**
+*/
+static bool BenchHkIdle(void)
+{
+
+   static const char* CtrlTlmName[GPIO_DEMO_CTRL_TLM_CNT] = { "edge_hist", "pwm", "seq" };
+   const CFE_SB_MsgId_t CtrlTlmMid[GPIO_DEMO_CTRL_TLM_CNT] =
+   {
+      GpioDemo.GpioCtrl.EdgeHistTlmMid,
+      GpioDemo.GpioCtrl.PwmTlmMid,
+      GpioDemo.GpioCtrl.SeqTlmMid
+   };
+   BenchCmd_t Cmd;
+   uint32 Heartbeat = INITBL_GetIntConfig(&GpioDemo.IniTbl, CFG_HK_TLM_HEARTBEAT);
+   uint32 MaxSentCnt;
+   uint32 SentCnt;
+   uint32 CtrlTlmCnt[GPIO_DEMO_CTRL_TLM_CNT];
+   uint16 HkSkipCnt = GpioDemo.HkSkipCnt;
+   bool   Passed;
+   uint32 i;
+
+   for (i=0; i < GPIO_DEMO_CTRL_TLM_CNT; i++)
+   {
+      CtrlTlmCnt[i] = HOST_SB_GetMsgCnt(CtrlTlmMid[i]);
+   }
+   struct timespec Delay = { BENCH_HK_IDLE_MS / 1000, (BENCH_HK_IDLE_MS % 1000) * 1000000L };
+
+   InitCmd(&Cmd, GpioDemo.SendHkMid, sizeof(CFE_MSG_CommandHeader_t), 0);
+
+   for (i=0; i < BENCH_HK_IDLE_REQS; i++)
+   {
+      nanosleep(&Delay, NULL);
+      HOST_SB_SendWait(&Cmd.Msg);
+      HOST_SB_WaitIdle(GpioDemo.CmdPipe);
+   }
+
+   SentCnt    = BENCH_HK_IDLE_REQS - (uint16)(GpioDemo.HkSkipCnt - HkSkipCnt);
+   MaxSentCnt = 1 + ((Heartbeat > 0) ? BENCH_HK_IDLE_REQS / Heartbeat : 0);
+
+   printf("hk_idle_reqs,%u,count\n", BENCH_HK_IDLE_REQS);
+   printf("hk_idle_sent,%u,count\n", SentCnt);
+   printf("hk_idle_max_sent,%u,count\n", MaxSentCnt);
+   printf("hk_idle_ctrl_wakes,%u,count\n", GpioDemo.GpioCtrl.WakeCnt);
+
+   Passed = (SentCnt <= MaxSentCnt);
+   for (i=0; i < GPIO_DEMO_CTRL_TLM_CNT; i++)
+   {
+      SentCnt = HOST_SB_GetMsgCnt(CtrlTlmMid[i]) - CtrlTlmCnt[i];
+      printf("hk_idle_%s_sent,%u,count\n", CtrlTlmName[i], SentCnt);
+      Passed = Passed && (SentCnt <= MaxSentCnt);
+   }
+
+   return Passed;
+
+} /* End BenchHkIdle() */
+
+
+/******************************************************************************
+** Function: BenchMemory
+**
+*/
+static void BenchMemory(void)
+{
+
+   printf("app_obj_size,%zu,bytes\n", sizeof(GpioDemo));
+   printf("gpio_ctrl_size,%zu,bytes\n", sizeof(GpioDemo.GpioCtrl));
+   printf("input_cap_size,%zu,bytes\n", sizeof(GpioDemo.InputCap));
+   printf("logic_cap_size,%zu,bytes\n", sizeof(GpioDemo.LogicCap));
+   printf("tlm_buf_size,%zu,bytes\n", sizeof(GpioDemo.TlmBuf));
+   printf("trace_log_size,%zu,bytes\n", sizeof(GpioDemo.TraceLog));
+   printf("ini_tbl_size,%zu,bytes\n", sizeof(GpioDemo.IniTbl));
+   ReportProcStatus("VmRSS:", "rss");
+
+} /* End BenchMemory() */
+
+
+/******************************************************************************
+** Function: BenchSeqLoad
+**
+** Load each SeqCheck[] program and check that the load is accepted or
+** rejected as expected
+**
+*/
+static bool BenchSeqLoad(void)
+{
+
+   BenchCmd_t Cmd;
+   char   HostPath[OS_MAX_PATH_LEN*2];
+   FILE*  File;
+   uint32 FailCnt = 0;
+   uint16 i;
+
+   InitCmd(&Cmd, GpioDemo.CmdMid, sizeof(GPIO_DEMO_LoadTbl_t), GPIO_DEMO_LOAD_TBL_CC);
+   Cmd.LoadTbl.Payload.Id   = BENCH_SEQ_TBL_ID;
+   Cmd.LoadTbl.Payload.Type = TBLMGR_LOAD_TBL_REPLACE;
+   strncpy(Cmd.LoadTbl.Payload.Filename, BENCH_SEQ_FILE, sizeof(Cmd.LoadTbl.Payload.Filename)-1);
+
+   for (i=0; i < sizeof(SeqCheck)/sizeof(SeqCheck[0]); i++)
+   {
+      File = fopen(HOST_MapPath(BENCH_SEQ_FILE, HostPath, sizeof(HostPath)), "w");
+      if (File == NULL)
+      {
+         return false;
+      }
+      fprintf(File, "{\n   \"name\": \"%s\",\n   \"program\": [%s]\n}\n", SeqCheck[i].Name, SeqCheck[i].Program);
+      fclose(File);
+
+      if (SendCmd(&Cmd) != SeqCheck[i].Valid)
+      {
+         fprintf(stderr, "Sequence %s was %s\n", SeqCheck[i].Name, SeqCheck[i].Valid ? "rejected" : "accepted");
+         FailCnt++;
+      }
+   }
+
+   printf("seq_load_checks,%u,count\n", (unsigned int)(sizeof(SeqCheck)/sizeof(SeqCheck[0])));
+   printf("seq_load_failed,%u,count\n", FailCnt);
+
+   return (FailCnt == 0);
+
+} /* End BenchSeqLoad() */
+
+
+/******************************************************************************
+** Function: BenchTrace
+**
+** Time the DumpTrace command
+**
+*/
+static bool BenchTrace(void)
+{
+
+   BenchCmd_t  Cmd;
+   char        HostPath[OS_MAX_PATH_LEN*2];
+   struct stat FileStat;
+   uint64 StartNs, ElapsedNs;
+   bool   Accepted;
+
+   InitCmd(&Cmd, GpioDemo.CmdMid, sizeof(GPIO_DEMO_DumpTrace_t), GPIO_DEMO_DUMP_TRACE_CC);
+   strncpy(Cmd.DumpTrace.Payload.Filename, BENCH_TRACE_FILE, sizeof(Cmd.DumpTrace.Payload.Filename)-1);
+
+   StartNs  = GetNs();
+   Accepted = SendCmd(&Cmd);
+   ElapsedNs = GetNs() - StartNs;
+
+   if (!Accepted || stat(HOST_MapPath(BENCH_TRACE_FILE, HostPath, sizeof(HostPath)), &FileStat) != 0)
+   {
+      return false;
+   }
+
+   printf("trace_dump_time,%.2f,ms\n", ElapsedNs / 1e6);
+   printf("trace_dump_size,%lld,bytes\n", (long long)FileStat.st_size);
+
+   return true;
+
+} /* End BenchTrace() */
+
+
+/******************************************************************************
+** Function: GetNs
+**
+*/
+static uint64 GetNs(void)
+{
+
+   struct timespec Now;
+
+   clock_gettime(CLOCK_MONOTONIC, &Now);
+
+   return (uint64)Now.tv_sec * 1000000000ULL + (uint64)Now.tv_nsec;
+
+} /* End GetNs() */
+
+
+/******************************************************************************
+** Function: InitCmd
+**
+*/
+static void InitCmd(BenchCmd_t* Cmd, CFE_SB_MsgId_t MsgId, size_t Size, uint16 FuncCode)
+{
+
+   memset(Cmd, 0, sizeof(BenchCmd_t));
+   CFE_MSG_Init(&Cmd->Msg, MsgId, Size);
+   CFE_MSG_SetFcnCode(&Cmd->Msg, FuncCode);
+
+} /* End InitCmd() */
+
+
+/******************************************************************************
+** Function: InitCmdStream
+**
+** Cycle through the accepted timing commands, addressing every channel in
+** turn where the command takes one
+**
+*/
+static void InitCmdStream(void)
+{
+
+   BenchCmd_t* Cmd;
+   uint16 Chan;
+   uint16 i;
+
+   for (i=0; i < BENCH_CMD_STREAM; i++)
+   {
+
+      Cmd  = &CmdStream[i];
+      Chan = (i / 5) % GpioDemo.GpioCtrl.ChanCnt;
+
+      switch (i % 5)
+      {
+         case 0:
+            InitCmd(Cmd, GpioDemo.CmdMid, sizeof(GPIO_DEMO_SetOnTime_t), GPIO_DEMO_SET_ON_TIME_CC);
+            Cmd->SetOnTime.Payload.OnTime = 500 + i;
+            break;
+         case 1:
+            InitCmd(Cmd, GpioDemo.CmdMid, sizeof(GPIO_DEMO_SetOffTime_t), GPIO_DEMO_SET_OFF_TIME_CC);
+            Cmd->SetOffTime.Payload.OffTime = 500 + i;
+            break;
+         case 2:
+            InitCmd(Cmd, GpioDemo.CmdMid, sizeof(GPIO_DEMO_SetTiming_t), GPIO_DEMO_SET_TIMING_CC);
+            Cmd->SetTiming.Payload.Channel = Chan;
+            Cmd->SetTiming.Payload.OnTime  = 100 + i;
+            Cmd->SetTiming.Payload.OffTime = 200 + i;
+            break;
+         case 3:
+            InitCmd(Cmd, GpioDemo.CmdMid, sizeof(GPIO_DEMO_SetPwmFreq_t), GPIO_DEMO_SET_PWM_FREQ_CC);
+            Cmd->SetPwmFreq.Payload.Channel = Chan;
+            Cmd->SetPwmFreq.Payload.FreqHz  = 100 + i;
+            break;
+         default:
+            InitCmd(Cmd, GpioDemo.CmdMid, sizeof(GPIO_DEMO_SetPwmDuty_t), GPIO_DEMO_SET_PWM_DUTY_CC);
+            Cmd->SetPwmDuty.Payload.Channel = Chan;
+            Cmd->SetPwmDuty.Payload.Duty    = (i * 37) % 10000;
+            break;
+      }
+
+   } /* End stream loop */
+
+} /* End InitCmdStream() */
+
+
+/******************************************************************************
+** Function: ReportProcStatus
+**
+** Report a kB field of /proc/self/status in bytes
+**
+*/
+static void ReportProcStatus(const char* Field, const char* Metric)
+{
+
+   FILE* File = fopen("/proc/self/status", "r");
+   char  Line[128];
+   unsigned long Kb;
+
+   if (File == NULL)
+   {
+      return;
+   }
+   while (fgets(Line, sizeof(Line), File) != NULL)
+   {
+      if (strncmp(Line, Field, strlen(Field)) == 0 &&
+          sscanf(&Line[strlen(Field)], "%lu", &Kb) == 1)
+      {
+         printf("%s,%lu,bytes\n", Metric, Kb * 1024);
+      }
+   }
+   fclose(File);
+
+} /* End ReportProcStatus() */
+
+
+/******************************************************************************
+** Function: SendCmd
+**
+** Send one command and return whether the app accepted it
+**
+*/
+static bool SendCmd(BenchCmd_t* Cmd)
+{
+
+   uint16 ValidCmdCnt = GpioDemo.CmdMgr.ValidCmdCnt;
+
+   HOST_SB_SendWait(&Cmd->Msg);
+   HOST_SB_WaitIdle(GpioDemo.CmdPipe);
+
+   return (GpioDemo.CmdMgr.ValidCmdCnt != ValidCmdCnt);
+
+} /* End SendCmd() */
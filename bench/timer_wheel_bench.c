@@ -0,0 +1,239 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Measure blink edge scheduling throughput versus channel count
+**
+**  Notes:
+**    1. Runs the blink scheduler's bookkeeping on simulated time without
+**       sleeping or writing GPIO, so the result is the CPU cost of finding
+**       and rescheduling edges. Each channel toggles with a random on/off
+**       time of 1 to 2000 ms.
+**    2. "wheel" uses timer_wheel.c as gpio_ctrl.c does. "scan" is the
+**       linear minimum search over all channels that it replaced.
+**    3. Output is CSV: channels, scheduler, edges, bank writes, edges per
+**       second and nanoseconds per edge.
+**    4. Build on any Linux host with OSAL's common_types.h, e.g.
+**         cc -O2 -I fsw/src -I <osal>/src/os/inc bench/timer_wheel_bench.c \
+**            fsw/src/timer_wheel.c -o timer_wheel_bench
+**
+*/
+
+/*
+** Include Files:
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "timer_wheel.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define BENCH_MAX_CHAN   4096
+#define BENCH_EDGES      2000000
+#define BENCH_MAX_MS     2000
+
+
+/**********************/
+/** Global File Data **/
+/**********************/
+
+static TIMER_WHEEL_Class_t TimerWheel;
+static TIMER_WHEEL_Node_t  Node[BENCH_MAX_CHAN];
+static uint16 DueChan[BENCH_MAX_CHAN];
+static uint32 NextEdge[BENCH_MAX_CHAN];
+static uint32 Period[BENCH_MAX_CHAN];
+static volatile uint64 BankLevel;   /* Stands in for the bank write */
+
+
+/*******************************/
+/** Local Function Prototypes **/
+/*******************************/
+
+static uint64 GetNs(void);
+static void   InitChannels(uint16 ChanCnt);
+static void   Report(uint16 ChanCnt, const char* Sched, uint32 Edges, uint32 Writes, uint64 Ns);
+static void   RunScan(uint16 ChanCnt);
+static void   RunWheel(uint16 ChanCnt);
+
+
+/******************************************************************************
+** Function: main
+**
+*/
+int main(void)
+{
+
+   static const uint16 ChanCnt[] = { 1, 4, 16, 32, 64, 256, 1024, 4096 };
+   uint16 i;
+
+   printf("channels,scheduler,edges,bank_writes,edges_per_sec,ns_per_edge\n");
+   for (i=0; i < sizeof(ChanCnt)/sizeof(ChanCnt[0]); i++)
+   {
+      RunWheel(ChanCnt[i]);
+      RunScan(ChanCnt[i]);
+   }
+
+   return 0;
+
+} /* End main() */
+
+
+/******************************************************************************
+** Function: GetNs
+**
+*/
+static uint64 GetNs(void)
+{
+
+   struct timespec Now;
+
+   clock_gettime(CLOCK_MONOTONIC, &Now);
+
+   return (uint64)Now.tv_sec * 1000000000ULL + (uint64)Now.tv_nsec;
+
+} /* End GetNs() */
+
+
+/******************************************************************************
+** Function: InitChannels
+**
+** Give every channel the same random periods and first edge for each run
+**
+*/
+static void InitChannels(uint16 ChanCnt)
+{
+
+   uint16 i;
+
+   srand(ChanCnt);
+   for (i=0; i < ChanCnt; i++)
+   {
+      Period[i]   = 1 + rand() % BENCH_MAX_MS;
+      NextEdge[i] = rand() % BENCH_MAX_MS;
+   }
+
+} /* End InitChannels() */
+
+
+/******************************************************************************
+** Function: Report
+**
+*/
+static void Report(uint16 ChanCnt, const char* Sched, uint32 Edges, uint32 Writes, uint64 Ns)
+{
+
+   printf("%u,%s,%u,%u,%.0f,%.1f\n", ChanCnt, Sched, Edges, Writes,
+          (double)Edges * 1e9 / (double)Ns, (double)Ns / (double)Edges);
+
+} /* End Report() */
+
+
+/******************************************************************************
+** Function: RunScan
+**
+*/
+static void RunScan(uint16 ChanCnt)
+{
+
+   uint16 i;
+   uint32 EdgeTime;
+   uint32 Edges  = 0;
+   uint32 Writes = 0;
+   uint64 Mask;
+   uint64 StartNs;
+
+   InitChannels(ChanCnt);
+
+   StartNs = GetNs();
+   while (Edges < BENCH_EDGES)
+   {
+
+      EdgeTime = NextEdge[0];
+      for (i=1; i < ChanCnt; i++)
+      {
+         if ((int32)(NextEdge[i] - EdgeTime) < 0)
+         {
+            EdgeTime = NextEdge[i];
+         }
+      }
+
+      Mask = 0;
+      for (i=0; i < ChanCnt; i++)
+      {
+         if (NextEdge[i] == EdgeTime)
+         {
+            Mask |= 1ULL << (i & 63);
+            NextEdge[i] = EdgeTime + Period[i];
+            Edges++;
+         }
+      }
+      BankLevel ^= Mask;
+      Writes++;
+
+   }
+   Report(ChanCnt, "scan", Edges, Writes, GetNs() - StartNs);
+
+} /* End RunScan() */
+
+
+/******************************************************************************
+** Function: RunWheel
+**
+*/
+static void RunWheel(uint16 ChanCnt)
+{
+
+   uint16 i;
+   uint16 DueCnt;
+   uint32 EdgeTime;
+   uint32 Edges  = 0;
+   uint32 Writes = 0;
+   uint64 Mask;
+   uint64 StartNs;
+
+   InitChannels(ChanCnt);
+   TIMER_WHEEL_Constructor(&TimerWheel, Node, ChanCnt, 0);
+   for (i=0; i < ChanCnt; i++)
+   {
+      TIMER_WHEEL_Add(&TimerWheel, i, NextEdge[i]);
+   }
+
+   StartNs = GetNs();
+   while (Edges < BENCH_EDGES && TIMER_WHEEL_NextTick(&TimerWheel, &EdgeTime))
+   {
+
+      DueCnt = TIMER_WHEEL_Expire(&TimerWheel, EdgeTime, DueChan);
+      Mask = 0;
+      for (i=0; i < DueCnt; i++)
+      {
+         Mask |= 1ULL << (DueChan[i] & 63);
+         TIMER_WHEEL_Add(&TimerWheel, DueChan[i], EdgeTime + Period[DueChan[i]]);
+      }
+      if (DueCnt > 0)
+      {
+         BankLevel ^= Mask;
+         Writes++;
+         Edges += DueCnt;
+      }
+
+   }
+   Report(ChanCnt, "wheel", Edges, Writes, GetNs() - StartNs);
+
+} /* End RunWheel() */
@@ -31,5 +31,10 @@
 #define GPIO_DEMO_CMD_MID         CFE_PLATFORM_CMD_TOPICID_TO_MID(CFE_MISSION_GPIO_DEMO_CMD_TOPICID)
 #define GPIO_DEMO_SEND_HK_MID     CFE_PLATFORM_CMD_TOPICID_TO_MID(CFE_MISSION_GPIO_DEMO_SEND_HK_TOPICID)
 #define GPIO_DEMO_HK_TLM_MID      CFE_PLATFORM_TLM_TOPICID_TO_MID(CFE_MISSION_GPIO_DEMO_HK_TLM_TOPICID)
+#define GPIO_DEMO_EDGE_HIST_TLM_MID  CFE_PLATFORM_TLM_TOPICID_TO_MID(CFE_MISSION_GPIO_DEMO_EDGE_HIST_TLM_TOPICID)
+#define GPIO_DEMO_PWM_TLM_MID        CFE_PLATFORM_TLM_TOPICID_TO_MID(CFE_MISSION_GPIO_DEMO_PWM_TLM_TOPICID)
+#define GPIO_DEMO_INPUT_EDGE_TLM_MID CFE_PLATFORM_TLM_TOPICID_TO_MID(CFE_MISSION_GPIO_DEMO_INPUT_EDGE_TLM_TOPICID)
+#define GPIO_DEMO_SEQ_TLM_MID        CFE_PLATFORM_TLM_TOPICID_TO_MID(CFE_MISSION_GPIO_DEMO_SEQ_TLM_TOPICID)
+#define GPIO_DEMO_CTRL_STATS_TLM_MID CFE_PLATFORM_TLM_TOPICID_TO_MID(CFE_MISSION_GPIO_DEMO_CTRL_STATS_TLM_TOPICID)
 
 #endif /* _gpio_demo_platform_msgids_ */
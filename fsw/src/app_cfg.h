@@ -34,6 +34,7 @@
 */
 
 #include "gpio_demo_eds_typedefs.h"
+#include "gpio_demo_eds_cc.h"
 //#include "gpio_demo_eds_designparameters.h"
 
 #include "gpio_demo_platform_cfg.h"
@@ -78,46 +79,139 @@
 
 #define CFG_CMD_PIPE_NAME    APP_CMD_PIPE_NAME
 #define CFG_CMD_PIPE_DEPTH   APP_CMD_PIPE_DEPTH
+#define CFG_CMD_BATCH_LIMIT  APP_CMD_BATCH_LIMIT
+#define CFG_TLM_ZERO_COPY    APP_TLM_ZERO_COPY
+
+#define CFG_HK_TLM_POLICY      HK_TLM_POLICY
+#define CFG_HK_TLM_DECIMATION  HK_TLM_DECIMATION
+#define CFG_HK_TLM_HEARTBEAT   HK_TLM_HEARTBEAT
 
 #define CFG_GPIO_DEMO_CMD_TOPICID     GPIO_DEMO_CMD_TOPICID
 #define CFG_GPIO_DEMO_SEND_HK_TOPICID GPIO_DEMO_SEND_HK_TOPICID
 #define CFG_GPIO_DEMO_HK_TLM_TOPICID  GPIO_DEMO_HK_TLM_TOPICID
+#define CFG_GPIO_DEMO_EDGE_HIST_TLM_TOPICID  GPIO_DEMO_EDGE_HIST_TLM_TOPICID
+#define CFG_GPIO_DEMO_PWM_TLM_TOPICID        GPIO_DEMO_PWM_TLM_TOPICID
+#define CFG_GPIO_DEMO_INPUT_EDGE_TLM_TOPICID GPIO_DEMO_INPUT_EDGE_TLM_TOPICID
+#define CFG_GPIO_DEMO_SEQ_TLM_TOPICID        GPIO_DEMO_SEQ_TLM_TOPICID
+#define CFG_GPIO_DEMO_CTRL_STATS_TLM_TOPICID GPIO_DEMO_CTRL_STATS_TLM_TOPICID
 
 #define CFG_CHILD_NAME       CHILD_NAME
 #define CFG_CHILD_PERF_ID    CHILD_PERF_ID
 #define CFG_CHILD_STACK_SIZE CHILD_STACK_SIZE
 #define CFG_CHILD_PRIORITY   CHILD_PRIORITY
-
-#define CFG_CTRL_OUT_PIN     CTRL_OUT_PIN
+#define CFG_CHILD_RT_CPU       CHILD_RT_CPU
+#define CFG_CHILD_RT_PRIORITY  CHILD_RT_PRIORITY
+#define CFG_CHILD_RT_LOCK_MEM  CHILD_RT_LOCK_MEM
+
+#define CFG_CTRL_GPIO_BACKEND CTRL_GPIO_BACKEND
+#define CFG_CTRL_SIM_FILE     CTRL_SIM_FILE
+#define CFG_CTRL_GPIO_CHIP    CTRL_GPIO_CHIP
+#define CFG_CTRL_OUT_PINS    CTRL_OUT_PINS
 #define CFG_CTRL_ON_TIME     CTRL_ON_TIME
 #define CFG_CTRL_OFF_TIME    CTRL_OFF_TIME
+#define CFG_CTRL_TIMING_MODE CTRL_TIMING_MODE
+#define CFG_CTRL_EDGE_EVENT_PERIOD CTRL_EDGE_EVENT_PERIOD
+#define CFG_CTRL_QUIET_CMDS   CTRL_QUIET_CMDS
+#define CFG_CTRL_REMAP_MIN_MS CTRL_REMAP_MIN_MS
+#define CFG_CTRL_REMAP_MAX_MS CTRL_REMAP_MAX_MS
+#define CFG_CTRL_MODE         CTRL_MODE
+#define CFG_CTRL_PWM_FREQ     CTRL_PWM_FREQ
+#define CFG_CTRL_PWM_DUTY     CTRL_PWM_DUTY
+#define CFG_CTRL_PWM_MAX_FREQ CTRL_PWM_MAX_FREQ
+#define CFG_CTRL_PWM_SPIN_US  CTRL_PWM_SPIN_US
+#define CFG_CTRL_PWM_SPIN_PCT CTRL_PWM_SPIN_PCT
+#define CFG_CTRL_STATS_MS     CTRL_STATS_MS
+#define CFG_PATTERN_TBL_FILE  PATTERN_TBL_FILE
+#define CFG_SEQ_TBL_FILE      SEQ_TBL_FILE
+
+#define CFG_TRACE_ENABLE      TRACE_ENABLE
+
+#define CFG_CAP_IN_PINS          CAP_IN_PINS
+#define CFG_CAP_SAMPLE_US        CAP_SAMPLE_US
+#define CFG_CAP_CPU              CAP_CPU
+#define CFG_CAP_DRAIN_MS         CAP_DRAIN_MS
+#define CFG_CAP_DEBOUNCE_SAMPLES CAP_DEBOUNCE_SAMPLES
+#define CFG_CAP_CHILD_NAME       CAP_CHILD_NAME
+#define CFG_CAP_CHILD_PERF_ID    CAP_CHILD_PERF_ID
+#define CFG_CAP_CHILD_STACK_SIZE CAP_CHILD_STACK_SIZE
+#define CFG_CAP_CHILD_PRIORITY   CAP_CHILD_PRIORITY
+
+#define CFG_LOGIC_CHILD_NAME       LOGIC_CHILD_NAME
+#define CFG_LOGIC_CHILD_PERF_ID    LOGIC_CHILD_PERF_ID
+#define CFG_LOGIC_CHILD_STACK_SIZE LOGIC_CHILD_STACK_SIZE
+#define CFG_LOGIC_CHILD_PRIORITY   LOGIC_CHILD_PRIORITY
 
 #define APP_CONFIG(XX) \
    XX(APP_CFE_NAME,char*) \
    XX(APP_PERF_ID,uint32) \
    XX(APP_CMD_PIPE_NAME,char*) \
    XX(APP_CMD_PIPE_DEPTH,uint32) \
+   XX(APP_CMD_BATCH_LIMIT,uint32) \
+   XX(APP_TLM_ZERO_COPY,uint32) \
    XX(GPIO_DEMO_CMD_TOPICID,uint32) \
    XX(GPIO_DEMO_SEND_HK_TOPICID,uint32) \
    XX(GPIO_DEMO_HK_TLM_TOPICID,uint32) \
+   XX(GPIO_DEMO_EDGE_HIST_TLM_TOPICID,uint32) \
+   XX(GPIO_DEMO_PWM_TLM_TOPICID,uint32) \
+   XX(GPIO_DEMO_INPUT_EDGE_TLM_TOPICID,uint32) \
+   XX(GPIO_DEMO_SEQ_TLM_TOPICID,uint32) \
+   XX(GPIO_DEMO_CTRL_STATS_TLM_TOPICID,uint32) \
+   XX(HK_TLM_POLICY,char*) \
+   XX(HK_TLM_DECIMATION,uint32) \
+   XX(HK_TLM_HEARTBEAT,uint32) \
    XX(CHILD_NAME,char*) \
    XX(CHILD_PERF_ID,uint32) \
    XX(CHILD_STACK_SIZE,uint32) \
    XX(CHILD_PRIORITY,uint32) \
-   XX(CTRL_OUT_PIN,uint32) \
+   XX(CHILD_RT_CPU,uint32) \
+   XX(CHILD_RT_PRIORITY,uint32) \
+   XX(CHILD_RT_LOCK_MEM,uint32) \
+   XX(CTRL_GPIO_BACKEND,char*) \
+   XX(CTRL_SIM_FILE,char*) \
+   XX(CTRL_GPIO_CHIP,char*) \
+   XX(CTRL_OUT_PINS,char*) \
    XX(CTRL_ON_TIME,uint32) \
    XX(CTRL_OFF_TIME,uint32) \
+   XX(CTRL_TIMING_MODE,char*) \
+   XX(CTRL_EDGE_EVENT_PERIOD,uint32) \
+   XX(CTRL_QUIET_CMDS,uint32) \
+   XX(CTRL_REMAP_MIN_MS,uint32) \
+   XX(CTRL_REMAP_MAX_MS,uint32) \
+   XX(CTRL_MODE,char*) \
+   XX(CTRL_PWM_FREQ,uint32) \
+   XX(CTRL_PWM_DUTY,uint32) \
+   XX(CTRL_PWM_MAX_FREQ,uint32) \
+   XX(CTRL_PWM_SPIN_US,uint32) \
+   XX(CTRL_PWM_SPIN_PCT,uint32) \
+   XX(CTRL_STATS_MS,uint32) \
+   XX(PATTERN_TBL_FILE,char*) \
+   XX(SEQ_TBL_FILE,char*) \
+   XX(TRACE_ENABLE,uint32) \
+   XX(CAP_IN_PINS,char*) \
+   XX(CAP_SAMPLE_US,uint32) \
+   XX(CAP_CPU,uint32) \
+   XX(CAP_DRAIN_MS,uint32) \
+   XX(CAP_DEBOUNCE_SAMPLES,uint32) \
+   XX(CAP_CHILD_NAME,char*) \
+   XX(CAP_CHILD_PERF_ID,uint32) \
+   XX(CAP_CHILD_STACK_SIZE,uint32) \
+   XX(CAP_CHILD_PRIORITY,uint32) \
+   XX(LOGIC_CHILD_NAME,char*) \
+   XX(LOGIC_CHILD_PERF_ID,uint32) \
+   XX(LOGIC_CHILD_STACK_SIZE,uint32) \
+   XX(LOGIC_CHILD_PRIORITY,uint32) \
    
 DECLARE_ENUM(Config,APP_CONFIG)
 
 
 /******************************************************************************
 ** Command Macros
-** - Load/dump table definitions are placeholders for a JSON table
+** - The table load/dump function codes are defined in the EDS after the
+**   app's original commands
 */
 
-#define GPIO_DEMO_TBL_LOAD_CMD_FC      (CMDMGR_APP_START_FC + 0)
-#define GPIO_DEMO_TBL_DUMP_CMD_FC      (CMDMGR_APP_START_FC + 1)
+#define GPIO_DEMO_TBL_LOAD_CMD_FC      GPIO_DEMO_LOAD_TBL_CC
+#define GPIO_DEMO_TBL_DUMP_CMD_FC      GPIO_DEMO_DUMP_TBL_CC
 
 
 /******************************************************************************
@@ -130,6 +224,12 @@ DECLARE_ENUM(Config,APP_CONFIG)
 
 #define GPIO_DEMO_BASE_EID  (OSK_C_FW_APP_BASE_EID +  0)
 #define GPIO_CTRL_BASE_EID  (OSK_C_FW_APP_BASE_EID + 20)
+#define GPIO_DRV_BASE_EID   (OSK_C_FW_APP_BASE_EID + 40)
+#define PATTERN_TBL_BASE_EID (OSK_C_FW_APP_BASE_EID + 60)
+#define INPUT_CAP_BASE_EID   (OSK_C_FW_APP_BASE_EID + 80)
+#define LOGIC_CAP_BASE_EID   (OSK_C_FW_APP_BASE_EID + 100)
+#define SEQ_TBL_BASE_EID     (OSK_C_FW_APP_BASE_EID + 120)
+#define TRACE_LOG_BASE_EID   (OSK_C_FW_APP_BASE_EID + 140)
 
 
 #endif /* _app_cfg_ */
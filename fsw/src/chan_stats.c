@@ -0,0 +1,111 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Implement the per-channel output statistics store
+**
+**  Notes:
+**    1. Masks are all ones or all zeros, built by negating a 0/1 value,
+**       and MaxMask() selects the larger value without a compare branch.
+**
+*/
+
+/*
+** Include Files:
+*/
+
+#include <string.h>
+
+#include "chan_stats.h"
+
+
+/*******************************/
+/** Local Function Prototypes **/
+/*******************************/
+
+static inline uint64 MaxMask(uint64 Max, uint64 Value);
+
+
+/******************************************************************************
+** Function: CHAN_STATS_Constructor
+**
+*/
+void CHAN_STATS_Constructor(CHAN_STATS_Class_t *ChanStats, uint16 ChanCnt, uint64 StartNs)
+{
+
+   uint16 i;
+
+   memset(ChanStats, 0, sizeof(CHAN_STATS_Class_t));
+
+   ChanStats->ChanCnt = (ChanCnt > CHAN_STATS_MAX_CHAN) ? CHAN_STATS_MAX_CHAN : ChanCnt;
+
+   for (i=0; i < ChanStats->ChanCnt; i++)
+   {
+      ChanStats->LastEdgeNs[i] = StartNs;
+   }
+
+} /* End CHAN_STATS_Constructor() */
+
+
+/******************************************************************************
+** Function: CHAN_STATS_Edge
+**
+** Notes:
+**   1. Level is the new level so the interval that ended was high when
+**      Level is 0. High is the all ones mask in that case.
+**
+*/
+void CHAN_STATS_Edge(CHAN_STATS_Class_t *ChanStats, uint16 Chan, uint8 Level, uint64 TimeNs)
+{
+
+   uint64 IntervalNs = TimeNs - ChanStats->LastEdgeNs[Chan];
+   uint64 High       = -(uint64)(1 ^ (Level & 1));
+
+   ChanStats->HighNs[Chan]    += IntervalNs & High;
+   ChanStats->MaxHighNs[Chan]  = MaxMask(ChanStats->MaxHighNs[Chan], IntervalNs & High);
+   ChanStats->MaxLowNs[Chan]   = MaxMask(ChanStats->MaxLowNs[Chan], IntervalNs & ~High);
+   ChanStats->LastEdgeNs[Chan] = TimeNs;
+   ChanStats->ToggleCnt[Chan]++;
+   ChanStats->Level[Chan]      = Level & 1;
+
+} /* End CHAN_STATS_Edge() */
+
+
+/******************************************************************************
+** Function: CHAN_STATS_GetHighNs
+**
+*/
+void CHAN_STATS_GetHighNs(const CHAN_STATS_Class_t *ChanStats, uint64 TimeNs, uint64 *HighNs)
+{
+
+   uint16 i;
+
+   for (i=0; i < ChanStats->ChanCnt; i++)
+   {
+      HighNs[i] = ChanStats->HighNs[i] + ((TimeNs - ChanStats->LastEdgeNs[i]) & -(uint64)ChanStats->Level[i]);
+   }
+
+} /* End CHAN_STATS_GetHighNs() */
+
+
+/******************************************************************************
+** Function: MaxMask
+**
+*/
+static inline uint64 MaxMask(uint64 Max, uint64 Value)
+{
+
+   return Max ^ ((Max ^ Value) & -(uint64)(Value > Max));
+
+} /* End MaxMask() */
@@ -0,0 +1,115 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Define a per-channel output statistics store
+**
+**  Notes:
+**    1. Each statistic is an array indexed by channel (structure of
+**       arrays). An edge writes one entry in each of six arrays and reads
+**       that scan every channel touch only the arrays they need, in
+**       order, so they vectorize.
+**    2. An edge update has no data dependent branches. The interval that
+**       ended is added to the high or low statistics through masks built
+**       from the new level.
+**    3. Times are caller supplied nanoseconds, e.g. CLOCK_MONOTONIC. Every
+**       channel starts low at the constructor's start time.
+**    4. No cFE dependencies so it can be built on a host.
+**
+*/
+
+#ifndef _chan_stats_
+#define _chan_stats_
+
+/*
+** Includes
+*/
+
+#include "common_types.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define CHAN_STATS_MAX_CHAN  32   /* GPIO_CTRL_MAX_CHAN, gpio_ctrl.c checks they match */
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+
+/******************************************************************************
+** Class
+*/
+
+typedef struct
+{
+
+   uint16  ChanCnt;
+
+   uint64  LastEdgeNs[CHAN_STATS_MAX_CHAN];   /* Time of the last transition */
+   uint64  HighNs[CHAN_STATS_MAX_CHAN];       /* Cumulative high time of completed intervals */
+   uint64  MaxHighNs[CHAN_STATS_MAX_CHAN];    /* Longest completed high interval */
+   uint64  MaxLowNs[CHAN_STATS_MAX_CHAN];     /* Longest completed low interval */
+   uint32  ToggleCnt[CHAN_STATS_MAX_CHAN];
+   uint8   Level[CHAN_STATS_MAX_CHAN];        /* 1 while the channel is high */
+
+} CHAN_STATS_Class_t;
+
+
+/************************/
+/** Exported Functions **/
+/************************/
+
+
+/******************************************************************************
+** Function: CHAN_STATS_Constructor
+**
+** Initialize ChanCnt low channels with no history
+**
+** Notes:
+**   1. ChanCnt is limited to CHAN_STATS_MAX_CHAN.
+**
+*/
+void CHAN_STATS_Constructor(CHAN_STATS_Class_t *ChanStats, uint16 ChanCnt, uint64 StartNs);
+
+
+/******************************************************************************
+** Function: CHAN_STATS_Edge
+**
+** Record a transition of channel Chan to Level (0 or 1) at TimeNs
+**
+** Notes:
+**   1. The caller only reports channels that changed level.
+**
+*/
+void CHAN_STATS_Edge(CHAN_STATS_Class_t *ChanStats, uint16 Chan, uint8 Level, uint64 TimeNs);
+
+
+/******************************************************************************
+** Function: CHAN_STATS_GetHighNs
+**
+** Write each channel's cumulative high time at TimeNs to HighNs
+**
+** Notes:
+**   1. Includes the open interval of channels that are high at TimeNs.
+**   2. HighNs must have ChanCnt entries.
+**
+*/
+void CHAN_STATS_GetHighNs(const CHAN_STATS_Class_t *ChanStats, uint64 TimeNs, uint64 *HighNs);
+
+
+#endif /* _chan_stats_ */
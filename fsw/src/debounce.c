@@ -0,0 +1,105 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Implement the bit-parallel debounce and glitch filter
+**
+**  Notes:
+**    1. The counter planes are always all updated, the planes above the
+**       ones Samples needs just stay 0, so the update has no data
+**       dependent branches and the plane loops unroll.
+**
+*/
+
+/*
+** Include Files:
+*/
+
+#include <string.h>
+
+#include "debounce.h"
+
+
+/******************************************************************************
+** Function: DEBOUNCE_Constructor
+**
+*/
+void DEBOUNCE_Constructor(DEBOUNCE_Class_t *Debounce, uint8 Samples, uint64 Level)
+{
+
+   uint16 i;
+
+   memset(Debounce, 0, sizeof(DEBOUNCE_Class_t));
+
+   if (Samples == 0)
+   {
+      Samples = 1;
+   }
+   else if (Samples > DEBOUNCE_MAX_SAMPLES)
+   {
+      Samples = DEBOUNCE_MAX_SAMPLES;
+   }
+
+   Debounce->Samples = Samples;
+   Debounce->Level   = Level;
+
+   for (i=0; i < DEBOUNCE_CNT_BITS; i++)
+   {
+      Debounce->Match[i] = (Samples & (1 << i)) ? UINT64_MAX : 0;
+   }
+
+} /* End DEBOUNCE_Constructor() */
+
+
+/******************************************************************************
+** Function: DEBOUNCE_Update
+**
+** Notes:
+**   1. Lines that match their debounced level clear their counters, the
+**      others count up with a ripple carry through the planes. Lines whose
+**      count equals Samples toggle and clear their counters so a count
+**      never exceeds DEBOUNCE_MAX_SAMPLES.
+**
+*/
+uint64 DEBOUNCE_Update(DEBOUNCE_Class_t *Debounce, uint64 Sample)
+{
+
+   uint64 Diff   = Sample ^ Debounce->Level;
+   uint64 Active = 0;
+   uint64 Carry  = Diff;
+   uint64 Toggle = Diff;
+   uint64 Cnt;
+   uint16 i;
+
+   for (i=0; i < DEBOUNCE_CNT_BITS; i++)
+   {
+      Cnt    = Debounce->Cnt[i];
+      Active |= Cnt;
+      Debounce->Cnt[i] = (Cnt ^ Carry) & Diff;
+      Carry &= Cnt;
+      Toggle &= ~(Debounce->Cnt[i] ^ Debounce->Match[i]);
+   }
+
+   for (i=0; i < DEBOUNCE_CNT_BITS; i++)
+   {
+      Debounce->Cnt[i] &= ~Toggle;
+   }
+
+   Debounce->Level     ^= Toggle;
+   Debounce->ChangeCnt += __builtin_popcountll(Toggle);
+   Debounce->GlitchCnt += __builtin_popcountll(Active & ~Diff);
+
+   return Toggle;
+
+} /* End DEBOUNCE_Update() */
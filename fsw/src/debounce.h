@@ -0,0 +1,103 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Define a bit-parallel debounce and glitch filter
+**
+**  Notes:
+**    1. Filters every line of a sampled 64-bit port word at once. A line
+**       only changes its debounced level after its raw level has differed
+**       for Samples consecutive samples.
+**    2. Each line has a saturating counter of consecutive differing
+**       samples. The counters are stored as a vertical counter: bit i of
+**       every line's counter is packed into Cnt[i], so one update is a few
+**       word-wide logic operations per counter bit and never loops over
+**       lines.
+**    3. A line whose raw level returns to its debounced level before the
+**       count is reached is a glitch and is counted in GlitchCnt.
+**    4. No cFE dependencies so it can be built on a host.
+**
+*/
+
+#ifndef _debounce_
+#define _debounce_
+
+/*
+** Includes
+*/
+
+#include "common_types.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define DEBOUNCE_CNT_BITS     4
+#define DEBOUNCE_MAX_SAMPLES  ((1 << DEBOUNCE_CNT_BITS) - 1)
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+
+/******************************************************************************
+** Class
+*/
+
+typedef struct
+{
+
+   uint8   Samples;                  /* Consecutive samples required to change */
+   uint64  Match[DEBOUNCE_CNT_BITS]; /* Samples as a vertical counter value */
+
+   uint64  Level;                    /* Debounced levels */
+   uint64  Cnt[DEBOUNCE_CNT_BITS];   /* Vertical counter, bit planes LSB first */
+
+   uint32  ChangeCnt;                /* Debounced line changes */
+   uint32  GlitchCnt;                /* Differences shorter than Samples */
+
+} DEBOUNCE_Class_t;
+
+
+/************************/
+/** Exported Functions **/
+/************************/
+
+
+/******************************************************************************
+** Function: DEBOUNCE_Constructor
+**
+** Initialize a filter with debounced levels Level
+**
+** Notes:
+**   1. Samples is limited to 1..DEBOUNCE_MAX_SAMPLES. 1 passes every raw
+**      change through.
+**
+*/
+void DEBOUNCE_Constructor(DEBOUNCE_Class_t *Debounce, uint8 Samples, uint64 Level);
+
+
+/******************************************************************************
+** Function: DEBOUNCE_Update
+**
+** Filter one sample and return the mask of lines whose debounced level
+** changed
+**
+*/
+uint64 DEBOUNCE_Update(DEBOUNCE_Class_t *Debounce, uint64 Sample);
+
+
+#endif /* _debounce_ */
@@ -16,7 +16,33 @@
 **    Implement the GPIO Controller Class methods
 **
 **  Notes:
-**    TODO - Consider adding a map command if it fails during init. 
+**    1. All edges that are due at the same time are passed to the GPIO
+**       driver as one set mask and one clear mask. Blink edges come from
+**       the EdgeWheel timer wheel so no step scans every channel.
+**    2. Edge times are kept on a millisecond timeline that is anchored to
+**       CLOCK_MONOTONIC. In absolute mode the child task sleeps until each
+**       edge deadline so processing time never accumulates into the period.
+**    3. The edge path only updates in-memory counters. Edge events are an
+**       optional, rate limited debug aid controlled by EdgeEventPeriod.
+**    4. Every bank write is timestamped and the difference between the
+**       actual and intended edge time is added to the edge histogram.
+**    5. Timing commands never write the channel state used by the child
+**       task. They publish a new TimingCfg buffer that the child task picks
+**       up without locks, see GPIO_CTRL_Class_t.
+**    6. The child task never polls. It blocks on WakeSem with the next edge
+**       as the deadline, or without a deadline when it has nothing to do,
+**       and commands post WakeSem so changes take effect immediately.
+**    7. A GPIO map failure is recovered on the child task with an
+**       exponential backoff retry or on command, without restarting the app.
+**    8. BLINK mode runs the channels' on/off timing, PATTERN mode walks
+**       the compiled pattern table steps and PWM mode runs each channel's
+**       frequency and duty cycle with nanosecond edge times.
+**    9. Time-tagged actions that fall due are run before the mode's next
+**       bank write and every wait ends at the earliest tag deadline. A due
+**       tag can be delayed by at most the PWM busy-wait before an edge.
+**   10. SEQUENCE mode dispatches the compiled sequence ops until a wait.
+**       A pass runs at most SEQ_OP_BUDGET ops so a sequence that loops
+**       without waiting can't hold the child task.
 **
 **  References:
 **    1. OpenSatKit Object-based Application Developer's Guide.
@@ -28,11 +54,72 @@
 ** Include Files:
 */
 
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE    /* pthread_setaffinity_np() */
+#endif
+
 #include <string.h>
+#include <stdlib.h>
+#include <errno.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/prctl.h>
 
 #include "app_cfg.h"
 #include "gpio_ctrl.h"
-#include "gpio.h"
+#include "mono_time.h"
+#include "trace_log.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+CompileTimeAssert(sizeof(((GPIO_DEMO_EdgeHistTlm_Payload_t*)0)->Bucket) == LAT_HIST_BUCKET_CNT*sizeof(uint32), EdgeHistBucketCntMismatch);
+CompileTimeAssert(sizeof(((GPIO_DEMO_PwmTlm_Payload_t*)0)->AchDuty) == GPIO_CTRL_MAX_CHAN*sizeof(uint16), PwmTlmChanCntMismatch);
+CompileTimeAssert(sizeof(((GPIO_DEMO_SeqTlm_Payload_t*)0)->OpCnt) == SEQ_TBL_OP_CNT*sizeof(uint32), SeqTlmOpCntMismatch);
+CompileTimeAssert(sizeof(((GPIO_DEMO_CtrlStatsTlm_Payload_t*)0)->EdgeCnt) == GPIO_CTRL_MAX_CHAN*sizeof(uint32), CtrlStatsTlmChanCntMismatch);
+CompileTimeAssert(GPIO_CTRL_MAX_CHAN == CHAN_STATS_MAX_CHAN, ChanStatsChanCntMismatch);
+
+
+#define TIMING_ON_TIME   0x01   /* PublishTimingCfg() Fields */
+#define TIMING_OFF_TIME  0x02
+#define TIMING_PWM_FREQ  0x04
+#define TIMING_PWM_DUTY  0x08
+
+#define PWM_DUTY_FULL       10000                       /* Duty units are 0.01% */
+#define PWM_DUTY_WINDOW_NS  (100*MONO_TIME_NS_PER_MS)   /* Achieved duty averaging time */
+#define PWM_SPIN_WINDOW_NS  (100*MONO_TIME_NS_PER_MS)   /* Busy-wait budget window */
+
+#define TAG_RING_MASK  (GPIO_CTRL_TAG_QUEUE_LEN - 1)
+
+#define MODE_REQ_MODE(Req)  ((uint8)((Req) & 0xFF))   /* ModeReq fields */
+#define MODE_REQ_CNT        0x100
+
+#define SEQ_OP_BUDGET  256      /* Ops per sequence pass without a wait */
+#define SEQ_YIELD_NS   100000   /* Wait after a pass that used its budget */
+
+#define WAIT_DUE       0   /* WaitForWake() results: DeadlineNs reached */
+#define WAIT_WOKEN     1   /* WakeSem posted, counted in WakeCnt */
+#define WAIT_TASK_DUE  2   /* A tag or the stats packet is due first */
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+/* PublishTimingCfg() values, only the fields selected by Fields are used */
+typedef struct
+{
+   
+   uint32  OnTime;
+   uint32  OffTime;
+   uint32  PwmFreq;
+   uint16  PwmDuty;
+   
+} ChanTiming_t;
+
 
 /**********************/
 /** Global File Data **/
@@ -45,6 +132,32 @@ static GPIO_CTRL_Class_t*  GpioCtrl = NULL;
 /** Local Function Prototypes **/
 /*******************************/
 
+static bool ConfigChannels(const char* PinList, uint32 OnTime, uint32 OffTime);
+static void ConfigRealTime(void);
+static void PublishTimingCfg(uint16 Channel, uint8 Fields, const ChanTiming_t* Timing);
+static void ApplyTimingCfg(void);
+static void EnterMode(uint8 Mode);
+static const char* ModeStr(uint8 Mode);
+static void OverrideTiming(void);
+static void ReadTimingCfg(void);
+static void ReceiveTags(void);
+static void RemapGpio(void);
+static void ResetChildStatus(void);
+static void RunBlinkEdge(void);
+static void RunPatternStep(void);
+static void RunPwmEdge(void);
+static void RunSequence(void);
+static bool RunTag(const GPIO_CTRL_Tag_t* Tag);
+static void RunTags(void);
+static void RunStats(void);
+static const char* TagActionStr(uint8 Action);
+static uint32 SatUint32(uint64 Value);
+static bool WaitForEdge(uint32 EdgeTime, uint64* IdealNs);
+static uint8 WaitForPwmEdge(uint64 EdgeNs);
+static uint8 WaitForWake(uint64 DeadlineNs);
+static void WakeChild(void);
+static void WriteBank(uint64 SetMask, uint64 ClrMask);
+
 
 /******************************************************************************
 ** Function: GPIO_CTRL_Constructor
@@ -55,30 +168,130 @@ static GPIO_CTRL_Class_t*  GpioCtrl = NULL;
 **   1. This must be called prior to any other function.
 **
 */
-void GPIO_CTRL_Constructor(GPIO_CTRL_Class_t *GpioCtrlPtr, INITBL_Class_t* IniTbl)
+bool GPIO_CTRL_Constructor(GPIO_CTRL_Class_t *GpioCtrlPtr, INITBL_Class_t* IniTbl)
 {
    
+   bool   RetStatus;
+   uint16 i;
+   
    GpioCtrl = GpioCtrlPtr;
    
    memset(GpioCtrl, 0, sizeof(GPIO_CTRL_Class_t));
    
-   if (gpio_map() < 0) // map peripherals
+   GpioCtrl->IniTbl = IniTbl;
+   sem_init(&GpioCtrl->WakeSem, 0, 0);
+   
+   GPIO_DRV_Constructor(&GpioCtrl->GpioDrv, IniTbl);
+   
+   LAT_HIST_Constructor(&GpioCtrl->EdgeHist);
+   GpioCtrl->EdgeHistTlmMid = CFE_SB_ValueToMsgId(INITBL_GetIntConfig(IniTbl, CFG_GPIO_DEMO_EDGE_HIST_TLM_TOPICID));
+   
+   RetStatus = ConfigChannels(INITBL_GetStrConfig(IniTbl, CFG_CTRL_OUT_PINS),
+                              INITBL_GetIntConfig(IniTbl, CFG_CTRL_ON_TIME),
+                              INITBL_GetIntConfig(IniTbl, CFG_CTRL_OFF_TIME));
+   
+   TIMER_WHEEL_Constructor(&GpioCtrl->EdgeWheel, GpioCtrl->EdgeTimer, GPIO_CTRL_MAX_CHAN, 0);
+   for (i=0; i < GpioCtrl->ChanCnt; i++)
    {
+      TIMER_WHEEL_Add(&GpioCtrl->EdgeWheel, i, GpioCtrl->Chan[i].NextEdge);
+   }
    
-      CFE_EVS_SendEvent (GPIO_CTRL_CONSTRUCTOR_EID, CFE_EVS_EventType_ERROR, "GPIO map failed");
-      GpioCtrl->IsMapped = false;
-
+   for (i=0; i < GpioCtrl->ChanCnt; i++)
+   {
+      GpioCtrl->TimingCfg[0].OnTime[i]  = GpioCtrl->Chan[i].OnTime;
+      GpioCtrl->TimingCfg[0].OffTime[i] = GpioCtrl->Chan[i].OffTime;
+   }
+   
+   GpioCtrl->PwmTlmMid = CFE_SB_ValueToMsgId(INITBL_GetIntConfig(IniTbl, CFG_GPIO_DEMO_PWM_TLM_TOPICID));
+   
+   GpioCtrl->PwmMaxFreq = INITBL_GetIntConfig(IniTbl, CFG_CTRL_PWM_MAX_FREQ);
+   GpioCtrl->PwmSpinNs  = INITBL_GetIntConfig(IniTbl, CFG_CTRL_PWM_SPIN_US) * 1000;
+   GpioCtrl->PwmSpinPct = INITBL_GetIntConfig(IniTbl, CFG_CTRL_PWM_SPIN_PCT);
+   if (GpioCtrl->PwmSpinPct > 100)
+   {
+      GpioCtrl->PwmSpinPct = 100;
+   }
+   for (i=0; i < GpioCtrl->ChanCnt; i++)
+   {
+      GpioCtrl->TimingCfg[0].PwmFreq[i] = INITBL_GetIntConfig(IniTbl, CFG_CTRL_PWM_FREQ);
+      GpioCtrl->TimingCfg[0].PwmDuty[i] = INITBL_GetIntConfig(IniTbl, CFG_CTRL_PWM_DUTY);
+      if (GpioCtrl->TimingCfg[0].PwmFreq[i] > GpioCtrl->PwmMaxFreq)
+      {
+         GpioCtrl->TimingCfg[0].PwmFreq[i] = GpioCtrl->PwmMaxFreq;
+      }
+      if (GpioCtrl->TimingCfg[0].PwmDuty[i] > PWM_DUTY_FULL)
+      {
+         GpioCtrl->TimingCfg[0].PwmDuty[i] = PWM_DUTY_FULL;
+      }
+   }
+   GpioCtrl->ChildCfg = GpioCtrl->TimingCfg[0];
+   ApplyTimingCfg();
+   
+   PATTERN_TBL_Constructor(&GpioCtrl->PatternTbl, GpioCtrl->PinMask);
+   SEQ_TBL_Constructor(&GpioCtrl->SeqTbl, GpioCtrl->PinMask);
+   GpioCtrl->SeqTlmMid = CFE_SB_ValueToMsgId(INITBL_GetIntConfig(IniTbl, CFG_GPIO_DEMO_SEQ_TLM_TOPICID));
+   
+   GpioCtrl->StatsPeriodNs   = INITBL_GetIntConfig(IniTbl, CFG_CTRL_STATS_MS) * MONO_TIME_NS_PER_MS;
+   GpioCtrl->CtrlStatsTlmMid = CFE_SB_ValueToMsgId(INITBL_GetIntConfig(IniTbl, CFG_GPIO_DEMO_CTRL_STATS_TLM_TOPICID));
+   
+   TIME_HEAP_Constructor(&GpioCtrl->TagHeap, GpioCtrl->TagNode, GPIO_CTRL_TAG_QUEUE_LEN);
+   for (i=0; i < GPIO_CTRL_TAG_QUEUE_LEN; i++)
+   {
+      GpioCtrl->TagFree[i] = i;
+   }
+   GpioCtrl->TagFreeCnt = GPIO_CTRL_TAG_QUEUE_LEN;
+   
+   if (strcmp(INITBL_GetStrConfig(IniTbl, CFG_CTRL_MODE), "PATTERN") == 0)
+   {
+      GpioCtrl->ModeReq = GPIO_DEMO_CtrlMode_PATTERN;
+   }
+   else if (strcmp(INITBL_GetStrConfig(IniTbl, CFG_CTRL_MODE), "PWM") == 0)
+   {
+      GpioCtrl->ModeReq = GPIO_DEMO_CtrlMode_PWM;
+   }
+   else if (strcmp(INITBL_GetStrConfig(IniTbl, CFG_CTRL_MODE), "SEQUENCE") == 0)
+   {
+      GpioCtrl->ModeReq = GPIO_DEMO_CtrlMode_SEQUENCE;
+   }
+   else
+   {
+      GpioCtrl->ModeReq = GPIO_DEMO_CtrlMode_BLINK;
+   }
+   GpioCtrl->ActiveMode   = GPIO_DEMO_CtrlMode_BLINK;
+   GpioCtrl->ModeApplyReq = GPIO_DEMO_CtrlMode_BLINK;
+   
+   if (strcmp(INITBL_GetStrConfig(IniTbl, CFG_CTRL_TIMING_MODE), "RELATIVE") == 0)
+   {
+      GpioCtrl->TimingMode = GPIO_CTRL_TIMING_RELATIVE;
    }
    else
    {
-      GpioCtrl->IsMapped = true;  
+      GpioCtrl->TimingMode = GPIO_CTRL_TIMING_ABSOLUTE;
+   }
+   
+   GpioCtrl->RtCpu      = INITBL_GetIntConfig(IniTbl, CFG_CHILD_RT_CPU);
+   GpioCtrl->RtPriority = INITBL_GetIntConfig(IniTbl, CFG_CHILD_RT_PRIORITY);
+   GpioCtrl->RtLockMem  = (INITBL_GetIntConfig(IniTbl, CFG_CHILD_RT_LOCK_MEM) != 0);
+   
+   GpioCtrl->EdgeEventPeriod = INITBL_GetIntConfig(IniTbl, CFG_CTRL_EDGE_EVENT_PERIOD);
+   GpioCtrl->QuietCmds       = (INITBL_GetIntConfig(IniTbl, CFG_CTRL_QUIET_CMDS) != 0);
+   
+   GpioCtrl->RemapMinMs = INITBL_GetIntConfig(IniTbl, CFG_CTRL_REMAP_MIN_MS);
+   GpioCtrl->RemapMaxMs = INITBL_GetIntConfig(IniTbl, CFG_CTRL_REMAP_MAX_MS);
+   if (GpioCtrl->RemapMinMs == 0)
+   {
+      GpioCtrl->RemapMinMs = 1;
+   }
+   if (GpioCtrl->RemapMaxMs < GpioCtrl->RemapMinMs)
+   {
+      GpioCtrl->RemapMaxMs = GpioCtrl->RemapMinMs;
    }
+   GpioCtrl->MapRetryMs = GpioCtrl->RemapMinMs;
+   GpioCtrl->MapRetryNs = MONO_TIME_GetNs() + (uint64)GpioCtrl->MapRetryMs * MONO_TIME_NS_PER_MS;
    
-   GpioCtrl->OutPin  = INITBL_GetIntConfig(IniTbl, CFG_CTRL_OUT_PIN);
-   gpio_out(GpioCtrl->OutPin);
+   GpioCtrl->IsMapped = GPIO_DRV_ConfigOut(GpioCtrl->PinMask);
 
-   GpioCtrl->OnTime  = INITBL_GetIntConfig(IniTbl, CFG_CTRL_ON_TIME);
-   GpioCtrl->OffTime = INITBL_GetIntConfig(IniTbl, CFG_CTRL_OFF_TIME);
+   return RetStatus;
    
 } /* End GPIO_CTRL_Constructor() */
 
@@ -86,36 +299,173 @@ void GPIO_CTRL_Constructor(GPIO_CTRL_Class_t *GpioCtrlPtr, INITBL_Class_t* IniTb
 /******************************************************************************
 ** Function: GPIO_CTRL_ChildTask
 **
+** Notes:
+**   1. Each call waits for and writes the next bank update of the active
+**      mode.
+**   2. The first call applies the optional real-time configuration and
+**      anchors the timeline to the monotonic clock.
+**   3. A wakeup before the edge is due (see WakeChild()) returns without
+**      writing so the next call reschedules with the latest state.
+**   4. While the GPIO is unmapped the call waits for the next map retry.
+**   5. Time-tagged actions are run after the mode and timing updates so a
+**      tag always sees, and may override, the latest commanded state.
+**   6. The controller statistics packet is sent from here so its period
+**      is kept by the child task's timeline, not the main task's HK rate.
+**
 */
 bool GPIO_CTRL_ChildTask(CHILDMGR_Class_t* ChildMgr)
 {
    
-   if (GpioCtrl->IsMapped)
+   uint32 ModeReq;
+   
+   if (GpioCtrl->StopRequested)
    {
+      return false;
+   }
+   
+   if (__atomic_exchange_n(&GpioCtrl->ResetRequested, false, __ATOMIC_ACQ_REL))
+   {
+      ResetChildStatus();
+   }
+   
+   if (__atomic_exchange_n(&GpioCtrl->RemapRequested, false, __ATOMIC_ACQ_REL))
+   {
+      RemapGpio();
+   }
+   
+   ReceiveTags();
+   
+   if (GpioCtrl->IsMapped && GpioCtrl->ChanCnt > 0)
+   {
+      
+      if (!GpioCtrl->ChildStarted)
+      {
+         ConfigRealTime();
+         GpioCtrl->EdgeDeadline = MONO_TIME_GetNs();
+         GpioCtrl->LastEdgeNs   = GpioCtrl->EdgeDeadline;
+         GpioCtrl->StatsWindowNs = GpioCtrl->EdgeDeadline;
+         GpioCtrl->StatsNextNs   = GpioCtrl->EdgeDeadline + GpioCtrl->StatsPeriodNs;
+         CHAN_STATS_Constructor(&GpioCtrl->ChanStats, GpioCtrl->ChanCnt, GpioCtrl->EdgeDeadline);
+         GpioCtrl->ChildStarted = true;
+      }
+      
+      ModeReq = __atomic_load_n(&GpioCtrl->ModeReq, __ATOMIC_ACQUIRE);
+      if (ModeReq != GpioCtrl->ModeApplyReq)
+      {
+         GpioCtrl->ModeApplyReq = ModeReq;
+         if (MODE_REQ_MODE(ModeReq) != GpioCtrl->ActiveMode)
+         {
+            EnterMode(MODE_REQ_MODE(ModeReq));
+         }
+      }
       
-      gpio_set(GpioCtrl->OutPin);
-      GpioCtrl->LedOn = true;
-      CFE_EVS_SendEvent (GPIO_CTRL_CHILD_TASK_EID, CFE_EVS_EventType_INFORMATION, "GPIO pin %d on for %u milliseconds", GpioCtrl->OutPin, GpioCtrl->OnTime);
-      OS_TaskDelay(GpioCtrl->OnTime);
-    
-      gpio_clr(GpioCtrl->OutPin);
-      GpioCtrl->LedOn = false;
-      CFE_EVS_SendEvent (GPIO_CTRL_CHILD_TASK_EID, CFE_EVS_EventType_INFORMATION, "GPIO pin %d off for %u milliseconds", GpioCtrl->OutPin, GpioCtrl->OffTime);
-      OS_TaskDelay(GpioCtrl->OffTime);
+      if (__atomic_load_n(&GpioCtrl->CfgSeq, __ATOMIC_ACQUIRE) != GpioCtrl->CfgApplySeq)
+      {
+         ReadTimingCfg();
+         ApplyTimingCfg();
+      }
+      
+      RunTags();
+      
+      RunStats();
+      
+      if (GpioCtrl->ActiveMode == GPIO_DEMO_CtrlMode_PATTERN)
+      {
+         RunPatternStep();
+      }
+      else if (GpioCtrl->ActiveMode == GPIO_DEMO_CtrlMode_PWM)
+      {
+         RunPwmEdge();
+      }
+      else if (GpioCtrl->ActiveMode == GPIO_DEMO_CtrlMode_SEQUENCE)
+      {
+         RunSequence();
+      }
+      else
+      {
+         RunBlinkEdge();
+      }
    
    } /* End if mapped */
+   else if (GpioCtrl->ChanCnt > 0)
+   {
+      
+      if (WaitForWake(GpioCtrl->MapRetryNs) == WAIT_DUE)
+      {
+         RemapGpio();
+      }
+      
+   }
    else
    {
      
-      OS_TaskDelay(2000);
+      TRACE_LOG_Begin(TRACE_LOG_CHILD, TRACE_LOG_SLEEP, 0);
+      while (sem_wait(&GpioCtrl->WakeSem) != 0 && errno == EINTR);
+      TRACE_LOG_End(TRACE_LOG_CHILD, TRACE_LOG_SLEEP);
    
    }
    
-   return true;
+   return !GpioCtrl->StopRequested;
 
 } /* End GPIO_CTRL_ChildTask() */
 
 
+/******************************************************************************
+** Function: GPIO_CTRL_LoadPatternTbl
+**
+*/
+bool GPIO_CTRL_LoadPatternTbl(TBLMGR_Tbl_t* Tbl, uint8 LoadType, const char* Filename)
+{
+   
+   bool RetStatus = PATTERN_TBL_LoadCmd(Tbl, LoadType, Filename);
+   
+   if (RetStatus)
+   {
+      WakeChild();
+   }
+   
+   return RetStatus;
+   
+} /* End GPIO_CTRL_LoadPatternTbl() */
+
+
+/******************************************************************************
+** Function: GPIO_CTRL_LoadSeqTbl
+**
+*/
+bool GPIO_CTRL_LoadSeqTbl(TBLMGR_Tbl_t* Tbl, uint8 LoadType, const char* Filename)
+{
+   
+   bool RetStatus = SEQ_TBL_LoadCmd(Tbl, LoadType, Filename);
+   
+   if (RetStatus)
+   {
+      WakeChild();
+   }
+   
+   return RetStatus;
+   
+} /* End GPIO_CTRL_LoadSeqTbl() */
+
+
+/******************************************************************************
+** Function: GPIO_CTRL_RemapCmd
+**
+*/
+bool GPIO_CTRL_RemapCmd(void* DataObjPtr, const CFE_MSG_Message_t *MsgPtr)
+{
+   
+   __atomic_store_n(&GpioCtrl->RemapRequested, true, __ATOMIC_RELEASE);
+   WakeChild();
+   
+   CFE_EVS_SendEvent (GPIO_CTRL_REMAP_EID, CFE_EVS_EventType_INFORMATION, 
+                      "GPIO remap requested for %s backend", GPIO_DRV_BackendStr(GpioCtrl->GpioDrv.Backend));
+   
+   return true;
+   
+} /* End GPIO_CTRL_RemapCmd() */
+
+
 /******************************************************************************
 ** Function: GPIO_CTRL_ResetStatus
 **
@@ -124,54 +474,2075 @@ bool GPIO_CTRL_ChildTask(CHILDMGR_Class_t* ChildMgr)
 ** Notes:
 **   1. Any counter or variable that is reported in HK telemetry that doesn't
 **      change the functional behavior should be reset.
+**   2. The table load counters are written by the main task, everything
+**      else is reset by ResetChildStatus() on the child task.
 **
 */
 void GPIO_CTRL_ResetStatus(void)
 {
 
-   return;
+   PATTERN_TBL_ResetStatus();
+   SEQ_TBL_ResetStatus();
+   
+   __atomic_store_n(&GpioCtrl->ResetRequested, true, __ATOMIC_RELEASE);
+   WakeChild();
 
 } /* End GPIO_CTRL_ResetStatus() */
 
 
 /******************************************************************************
-** Function: GPIO_CTRL_SetOffTimeCmd
+** Function: GPIO_CTRL_Stop
+**
+*/
+void GPIO_CTRL_Stop(void)
+{
+   
+   GpioCtrl->StopRequested = true;
+   WakeChild();
+   
+} /* End GPIO_CTRL_Stop() */
+
+
+/******************************************************************************
+** Function: GPIO_CTRL_ScheduleActionCmd
 **
 ** Notes:
-**   1. No limits placed on commanded value.
+**   1. The cFE execution time is converted to a CLOCK_MONOTONIC deadline
+**      when the command is received so later cFE time corrections don't
+**      move queued actions.
+**   2. Only the main task writes TagRing and TagHead, see
+**      GPIO_CTRL_Class_t.
 **
 */
-bool GPIO_CTRL_SetOffTimeCmd(void* DataObjPtr, const CFE_MSG_Message_t *MsgPtr)
+bool GPIO_CTRL_ScheduleActionCmd(void* DataObjPtr, const CFE_MSG_Message_t *MsgPtr)
 {
    
-   const GPIO_DEMO_SetOffTime_Payload_t *Cmd = CMDMGR_PAYLOAD_PTR(MsgPtr, GPIO_DEMO_SetOffTime_t);
+   const GPIO_DEMO_ScheduleAction_Payload_t *Cmd = CMDMGR_PAYLOAD_PTR(MsgPtr, GPIO_DEMO_ScheduleAction_t);
+   uint32 Head = GpioCtrl->TagHead;
+   uint32 QueueCnt = Head - __atomic_load_n(&GpioCtrl->TagDoneCnt, __ATOMIC_ACQUIRE);
+   bool   Valid;
+   CFE_TIME_SysTime_t ExecTime;
+   CFE_TIME_SysTime_t Now;
+   CFE_TIME_SysTime_t Delay;
+   GPIO_CTRL_Tag_t *Tag;
+   
+   ExecTime.Seconds    = Cmd->Seconds;
+   ExecTime.Subseconds = Cmd->Subseconds;
+   Now = CFE_TIME_GetTime();
+   
+   if (GpioCtrl->ChanCnt == 0 || QueueCnt >= GPIO_CTRL_TAG_QUEUE_LEN)
+   {
+      CFE_EVS_SendEvent (GPIO_CTRL_SCHEDULE_EID, CFE_EVS_EventType_ERROR, 
+                         "Schedule action rejected, %u channels configured and %u of %u actions queued", 
+                         GpioCtrl->ChanCnt, QueueCnt, GPIO_CTRL_TAG_QUEUE_LEN);
+      return false;
+   }
+   
+   if (CFE_TIME_Compare(ExecTime, Now) == CFE_TIME_A_LT_B)
+   {
+      CFE_EVS_SendEvent (GPIO_CTRL_SCHEDULE_EID, CFE_EVS_EventType_ERROR, 
+                         "Schedule action rejected, execution time %u.%06u is before the current time %u.%06u", 
+                         ExecTime.Seconds, CFE_TIME_Sub2MicroSecs(ExecTime.Subseconds),
+                         Now.Seconds, CFE_TIME_Sub2MicroSecs(Now.Subseconds));
+      return false;
+   }
+   
+   switch (Cmd->Action)
+   {
+      case GPIO_DEMO_TagAction_SET_PINS:
+         Valid = (((Cmd->SetMask | Cmd->ClrMask) & ~GpioCtrl->PinMask) == 0 &&
+                  (Cmd->SetMask & Cmd->ClrMask) == 0);
+         break;
+      case GPIO_DEMO_TagAction_SET_TIMING:
+         Valid = ((Cmd->Channel < GpioCtrl->ChanCnt || Cmd->Channel == GPIO_CTRL_ALL_CHAN) &&
+                  Cmd->OnTime > 0 && Cmd->OffTime > 0);
+         break;
+      case GPIO_DEMO_TagAction_START_PATTERN:
+         Valid = PATTERN_TBL_IsLoaded();
+         break;
+      default:
+         Valid = false;
+         break;
+   }
+   
+   if (!Valid)
+   {
+      CFE_EVS_SendEvent (GPIO_CTRL_SCHEDULE_EID, CFE_EVS_EventType_ERROR, 
+                         "Schedule %s action rejected, invalid action %u, channel %u, zero on/off time %u/%u, pins outside 0x%016llX or pattern not loaded", 
+                         TagActionStr(Cmd->Action), Cmd->Action, Cmd->Channel, Cmd->OnTime, Cmd->OffTime,
+                         (unsigned long long)GpioCtrl->PinMask);
+      return false;
+   }
+   
+   Delay = CFE_TIME_Subtract(ExecTime, Now);
+   
+   Tag = &GpioCtrl->TagRing[Head & TAG_RING_MASK];
+   Tag->TimeNs  = MONO_TIME_GetNs() + (uint64)Delay.Seconds * MONO_TIME_NS_PER_SEC + 
+                  (uint64)CFE_TIME_Sub2MicroSecs(Delay.Subseconds) * 1000;
+   Tag->Action  = Cmd->Action;
+   Tag->Channel = Cmd->Channel;
+   Tag->OnTime  = Cmd->OnTime;
+   Tag->OffTime = Cmd->OffTime;
+   Tag->SetMask = Cmd->SetMask;
+   Tag->ClrMask = Cmd->ClrMask;
+   
+   __atomic_store_n(&GpioCtrl->TagHead, Head + 1, __ATOMIC_RELEASE);
+   WakeChild();
+   
+   CFE_EVS_SendEvent (GPIO_CTRL_SCHEDULE_EID, CFE_EVS_EventType_INFORMATION, 
+                      "%s action scheduled for %u.%06u, %u actions queued", 
+                      TagActionStr(Cmd->Action), ExecTime.Seconds, CFE_TIME_Sub2MicroSecs(ExecTime.Subseconds),
+                      QueueCnt + 1);
+   
+   return true;
+   
+} /* End GPIO_CTRL_ScheduleActionCmd() */
+
+
+/******************************************************************************
+** Function: GPIO_CTRL_SendEdgeHistTlm
+**
+** Notes:
+**   1. The histogram is updated by the child task while this runs on the
+**      main task so a packet may contain a sample that isn't yet reflected
+**      in every field.
+**   2. The change check runs before a buffer is allocated so a skipped
+**      packet costs one compare.
+**
+*/
+bool GPIO_CTRL_SendEdgeHistTlm(bool OnlyIfChanged)
+{
+   
+   GPIO_DEMO_EdgeHistTlm_t *EdgeHistTlm;
+   GPIO_DEMO_EdgeHistTlm_Payload_t *Payload;
+   const LAT_HIST_Class_t *EdgeHist = &GpioCtrl->EdgeHist;
+   uint32 SampleCnt = EdgeHist->SampleCnt;
+   
+   if (OnlyIfChanged && SampleCnt == GpioCtrl->EdgeHistSentCnt)
+   {
+      return false;
+   }
+   GpioCtrl->EdgeHistSentCnt = SampleCnt;
+   
+   EdgeHistTlm = (GPIO_DEMO_EdgeHistTlm_t*)TLM_BUF_Alloc(TLM_BUF_MAIN_TASK, GpioCtrl->EdgeHistTlmMid, sizeof(GPIO_DEMO_EdgeHistTlm_t));
+   Payload = &EdgeHistTlm->Payload;
+   
+   Payload->SampleCnt   = SampleCnt;
+   Payload->NegativeCnt = EdgeHist->NegativeCnt;
+   Payload->MinNs       = (SampleCnt > 0) ? SatUint32(EdgeHist->MinNs) : 0;
+   Payload->MaxNs       = SatUint32(EdgeHist->MaxNs);
+   Payload->P50Ns       = SatUint32(LAT_HIST_GetPercentile(EdgeHist, 500));
+   Payload->P99Ns       = SatUint32(LAT_HIST_GetPercentile(EdgeHist, 990));
+   Payload->P999Ns      = SatUint32(LAT_HIST_GetPercentile(EdgeHist, 999));
+   Payload->SubBits     = LAT_HIST_SUB_BITS;
+   Payload->BucketCnt   = LAT_HIST_BUCKET_CNT;
+   memcpy(Payload->Bucket, EdgeHist->Bucket, sizeof(Payload->Bucket));
+   
+   TLM_BUF_Send((CFE_SB_Buffer_t*)EdgeHistTlm);
+   
+   return true;
+   
+} /* End GPIO_CTRL_SendEdgeHistTlm() */
+
+
+/******************************************************************************
+** Function: GPIO_CTRL_SendPwmTlm
+**
+** Notes:
+**   1. The requested values are read from the main task's latest TimingCfg
+**      buffer so they include updates the child task hasn't applied yet.
+**   2. Achieved duties and spin time only change with PWM edges and the
+**      rest of the payload is fixed by the ini file, so CfgSeq, the edge
+**      count and the skip counts cover every field.
+**
+*/
+bool GPIO_CTRL_SendPwmTlm(bool OnlyIfChanged)
+{
+   
+   GPIO_DEMO_PwmTlm_t *PwmTlm;
+   GPIO_DEMO_PwmTlm_Payload_t *Payload;
+   uint32 CfgSeq        = GpioCtrl->CfgSeq;
+   uint32 EdgeCnt       = GpioCtrl->PwmEdgeCnt;
+   uint32 SpinSkipCnt   = GpioCtrl->PwmSpinSkipCnt;
+   uint32 PeriodSkipCnt = GpioCtrl->PwmPeriodSkipCnt;
+   const GPIO_CTRL_TimingCfg_t *Cfg = &GpioCtrl->TimingCfg[CfgSeq & 1];
+   uint16 i;
+   
+   if (OnlyIfChanged &&
+       CfgSeq        == GpioCtrl->PwmSentCfgSeq  &&
+       EdgeCnt       == GpioCtrl->PwmSentEdgeCnt &&
+       SpinSkipCnt   == GpioCtrl->PwmSentSpinSkipCnt &&
+       PeriodSkipCnt == GpioCtrl->PwmSentPeriodSkipCnt)
+   {
+      return false;
+   }
+   GpioCtrl->PwmSentCfgSeq        = CfgSeq;
+   GpioCtrl->PwmSentEdgeCnt       = EdgeCnt;
+   GpioCtrl->PwmSentSpinSkipCnt   = SpinSkipCnt;
+   GpioCtrl->PwmSentPeriodSkipCnt = PeriodSkipCnt;
+   
+   PwmTlm  = (GPIO_DEMO_PwmTlm_t*)TLM_BUF_Alloc(TLM_BUF_MAIN_TASK, GpioCtrl->PwmTlmMid, sizeof(GPIO_DEMO_PwmTlm_t));
+   Payload = &PwmTlm->Payload;
+   
+   Payload->ChanCnt       = GpioCtrl->ChanCnt;
+   Payload->SpinPct       = GpioCtrl->PwmSpinPct;
+   Payload->SpinUs        = GpioCtrl->PwmSpinNs / 1000;
+   Payload->SpinTotalUs   = SatUint32(GpioCtrl->PwmSpinTotalNs / 1000);
+   Payload->SpinSkipCnt   = SpinSkipCnt;
+   Payload->PeriodSkipCnt = PeriodSkipCnt;
+   Payload->EdgeCnt       = EdgeCnt;
+   for (i=0; i < GpioCtrl->ChanCnt; i++)
+   {
+      Payload->FreqHz[i]  = Cfg->PwmFreq[i];
+      Payload->ReqDuty[i] = Cfg->PwmDuty[i];
+      Payload->AchDuty[i] = __atomic_load_n(&GpioCtrl->Chan[i].PwmAchDuty, __ATOMIC_RELAXED);
+   }
+   
+   TLM_BUF_Send((CFE_SB_Buffer_t*)PwmTlm);
+   
+   return true;
+   
+} /* End GPIO_CTRL_SendPwmTlm() */
+
+
+/******************************************************************************
+** Function: GPIO_CTRL_SendSeqTlm
+**
+** Notes:
+**   1. The profile is updated by the child task while this runs on the
+**      main task so an opcode's count and average may be one op apart.
+**   2. Pc, the yield count and the profile aren't compared. They change
+**      on every pass of a running sequence, which State already reports.
+**
+*/
+bool GPIO_CTRL_SendSeqTlm(bool OnlyIfChanged)
+{
+   
+   GPIO_DEMO_SeqTlm_t *SeqTlm;
+   GPIO_DEMO_SeqTlm_Payload_t *Payload;
+   const SEQ_TBL_Program_t *Program = &GpioCtrl->SeqTbl.Program[GpioCtrl->SeqTbl.PubIdx];
+   uint8  State      = GPIO_DEMO_SeqState_IDLE;
+   uint8  LoadStatus = GpioCtrl->SeqTbl.LastLoadStatus;
+   uint16 LoadCnt    = GpioCtrl->SeqTbl.LoadCnt;
+   uint32 RunCnt     = GpioCtrl->SeqRunCnt;
+   uint32 OpCnt;
+   uint16 i;
+   
+   if (GpioCtrl->ActiveMode == GPIO_DEMO_CtrlMode_SEQUENCE)
+   {
+      State = GpioCtrl->SeqDone ? GPIO_DEMO_SeqState_DONE : GPIO_DEMO_SeqState_RUNNING;
+   }
+   
+   if (OnlyIfChanged &&
+       State      == GpioCtrl->SeqSentState      &&
+       LoadStatus == GpioCtrl->SeqSentLoadStatus &&
+       LoadCnt    == GpioCtrl->SeqSentLoadCnt    &&
+       RunCnt     == GpioCtrl->SeqSentRunCnt)
+   {
+      return false;
+   }
+   GpioCtrl->SeqSentState      = State;
+   GpioCtrl->SeqSentLoadStatus = LoadStatus;
+   GpioCtrl->SeqSentLoadCnt    = LoadCnt;
+   GpioCtrl->SeqSentRunCnt     = RunCnt;
+   
+   SeqTlm  = (GPIO_DEMO_SeqTlm_t*)TLM_BUF_Alloc(TLM_BUF_MAIN_TASK, GpioCtrl->SeqTlmMid, sizeof(GPIO_DEMO_SeqTlm_t));
+   Payload = &SeqTlm->Payload;
+   
+   Payload->LoadStatus   = LoadStatus;
+   Payload->State        = State;
+   Payload->ProgramOpCnt = Program->OpCnt;
+   Payload->Pc           = GpioCtrl->SeqPc;
+   Payload->WriteCnt     = Program->WriteCnt;
+   Payload->LoadCnt      = LoadCnt;
+   Payload->RunCnt       = RunCnt;
+   Payload->YieldCnt     = GpioCtrl->SeqYieldCnt;
+   for (i=0; i < SEQ_TBL_OP_CNT; i++)
+   {
+      OpCnt = GpioCtrl->SeqOpCnt[i];
+      Payload->OpCnt[i]   = OpCnt;
+      Payload->OpAvgNs[i] = (OpCnt > 0) ? SatUint32(GpioCtrl->SeqOpTotalNs[i] / OpCnt) : 0;
+      Payload->OpMaxNs[i] = GpioCtrl->SeqOpMaxNs[i];
+   }
+   
+   TLM_BUF_Send((CFE_SB_Buffer_t*)SeqTlm);
+   
+   return true;
+   
+} /* End GPIO_CTRL_SendSeqTlm() */
+
+
+/******************************************************************************
+** Function: GPIO_CTRL_SetEdgeEventPeriodCmd
+**
+** Notes:
+**   1. A period of 0 disables the edge debug events.
+**   2. Edge events are sent with the DEBUG type so they are also subject to
+**      the EVS filters.
+**
+*/
+bool GPIO_CTRL_SetEdgeEventPeriodCmd(void* DataObjPtr, const CFE_MSG_Message_t *MsgPtr)
+{
+   
+   const GPIO_DEMO_SetEdgeEventPeriod_Payload_t *Cmd = CMDMGR_PAYLOAD_PTR(MsgPtr, GPIO_DEMO_SetEdgeEventPeriod_t);
    bool RetStatus = true;
   
-   GpioCtrl->OffTime = Cmd->OffTime;  
-   CFE_EVS_SendEvent (GPIO_CTRL_SET_OFF_TIME_EID, CFE_EVS_EventType_INFORMATION, "GPIO off time set to %u milliseconds", GpioCtrl->OffTime);
+   GpioCtrl->EdgeEventPeriod = Cmd->Period;
+   GpioCtrl->EdgeEventTime   = GpioCtrl->LastEdgeTime;
+   CFE_EVS_SendEvent (GPIO_CTRL_SET_EDGE_EVENT_PERIOD_EID, CFE_EVS_EventType_INFORMATION, 
+                      "GPIO edge event period set to %u milliseconds", GpioCtrl->EdgeEventPeriod);
   
    return RetStatus;   
    
-} /* End GPIO_CTRL_SetOffTimeCmd() */
+} /* End GPIO_CTRL_SetEdgeEventPeriodCmd() */
 
 
 /******************************************************************************
-** Function: GPIO_CTRL_SetOnTimeCmd
+** Function: GPIO_CTRL_SetModeCmd
 **
 ** Notes:
-**   1. No limits placed on commanded value.
+**   1. Each command publishes a new ModeReq with the next request count so
+**      the child task applies it even if ModeReq's mode hasn't changed
+**      since a time-tagged action switched ActiveMode.
 **
 */
-bool GPIO_CTRL_SetOnTimeCmd(void* DataObjPtr, const CFE_MSG_Message_t *MsgPtr)
+bool GPIO_CTRL_SetModeCmd(void* DataObjPtr, const CFE_MSG_Message_t *MsgPtr)
 {
    
-   const GPIO_DEMO_SetOnTime_Payload_t *Cmd = CMDMGR_PAYLOAD_PTR(MsgPtr, GPIO_DEMO_SetOnTime_t);
-   bool RetStatus = true;
-  
-   GpioCtrl->OnTime = Cmd->OnTime;
-   CFE_EVS_SendEvent (GPIO_CTRL_SET_ON_TIME_EID, CFE_EVS_EventType_INFORMATION, "GPIO on time set to %u milliseconds", GpioCtrl->OnTime);
+   const GPIO_DEMO_SetMode_Payload_t *Cmd = CMDMGR_PAYLOAD_PTR(MsgPtr, GPIO_DEMO_SetMode_t);
+   bool   RetStatus = false;
+   uint32 ModeReq;
+   
+   if (Cmd->Mode == GPIO_DEMO_CtrlMode_BLINK || Cmd->Mode == GPIO_DEMO_CtrlMode_PWM ||
+      (Cmd->Mode == GPIO_DEMO_CtrlMode_PATTERN && PATTERN_TBL_IsLoaded()) ||
+      (Cmd->Mode == GPIO_DEMO_CtrlMode_SEQUENCE && SEQ_TBL_IsLoaded()))
+   {
+      ModeReq = (GpioCtrl->ModeReq & ~(MODE_REQ_CNT-1)) + MODE_REQ_CNT;
+      __atomic_store_n(&GpioCtrl->ModeReq, ModeReq | Cmd->Mode, __ATOMIC_RELEASE);
+      WakeChild();
+      CFE_EVS_SendEvent (GPIO_CTRL_SET_MODE_EID, CFE_EVS_EventType_INFORMATION, 
+                         "GPIO controller mode set to %s", ModeStr(Cmd->Mode));
+      RetStatus = true;
+   }
+   else
+   {
+      CFE_EVS_SendEvent (GPIO_CTRL_SET_MODE_EID, CFE_EVS_EventType_ERROR, 
+                         "Invalid GPIO controller mode %u, PATTERN and SEQUENCE require a loaded table", Cmd->Mode);
+   }
+   
+   return RetStatus;   
+   
+} /* End GPIO_CTRL_SetModeCmd() */
+
+
+/******************************************************************************
+** Function: GPIO_CTRL_SetOffTimeCmd
+**
+** Notes:
+**   1. A zero off time is rejected.
+**   2. The off time is applied to the current phase of all channels.
+**
+*/
+bool GPIO_CTRL_SetOffTimeCmd(void* DataObjPtr, const CFE_MSG_Message_t *MsgPtr)
+{
+   
+   const GPIO_DEMO_SetOffTime_Payload_t *Cmd = CMDMGR_PAYLOAD_PTR(MsgPtr, GPIO_DEMO_SetOffTime_t);
+   bool RetStatus = false;
+   ChanTiming_t Timing;
+   
+   if (Cmd->OffTime > 0)
+   {
+      Timing.OffTime = Cmd->OffTime;
+      PublishTimingCfg(GPIO_CTRL_ALL_CHAN, TIMING_OFF_TIME, &Timing);
+      if (!GpioCtrl->QuietCmds)
+      {
+         CFE_EVS_SendEvent (GPIO_CTRL_SET_OFF_TIME_EID, CFE_EVS_EventType_INFORMATION, "GPIO off time set to %u milliseconds", Cmd->OffTime);
+      }
+      RetStatus = true;
+   }
+   else
+   {
+      CFE_EVS_SendEvent (GPIO_CTRL_SET_OFF_TIME_EID, CFE_EVS_EventType_ERROR, "Set off time rejected, off time must be at least 1 millisecond");
+   }
   
    return RetStatus;   
    
-} /* End GPIO_CTRL_SetOnTimeCmd() */
+} /* End GPIO_CTRL_SetOffTimeCmd() */
+
+
+/******************************************************************************
+** Function: GPIO_CTRL_SetOnTimeCmd
+**
+** Notes:
+**   1. A zero on time is rejected.
+**   2. The on time is applied to the current phase of all channels.
+**
+*/
+bool GPIO_CTRL_SetOnTimeCmd(void* DataObjPtr, const CFE_MSG_Message_t *MsgPtr)
+{
+   
+   const GPIO_DEMO_SetOnTime_Payload_t *Cmd = CMDMGR_PAYLOAD_PTR(MsgPtr, GPIO_DEMO_SetOnTime_t);
+   bool RetStatus = false;
+   ChanTiming_t Timing;
+   
+   if (Cmd->OnTime > 0)
+   {
+      Timing.OnTime = Cmd->OnTime;
+      PublishTimingCfg(GPIO_CTRL_ALL_CHAN, TIMING_ON_TIME, &Timing);
+      if (!GpioCtrl->QuietCmds)
+      {
+         CFE_EVS_SendEvent (GPIO_CTRL_SET_ON_TIME_EID, CFE_EVS_EventType_INFORMATION, "GPIO on time set to %u milliseconds", Cmd->OnTime);
+      }
+      RetStatus = true;
+   }
+   else
+   {
+      CFE_EVS_SendEvent (GPIO_CTRL_SET_ON_TIME_EID, CFE_EVS_EventType_ERROR, "Set on time rejected, on time must be at least 1 millisecond");
+   }
+  
+   return RetStatus;   
+   
+} /* End GPIO_CTRL_SetOnTimeCmd() */
+
+
+/******************************************************************************
+** Function: GPIO_CTRL_SetPwmDutyCmd
+**
+*/
+bool GPIO_CTRL_SetPwmDutyCmd(void* DataObjPtr, const CFE_MSG_Message_t *MsgPtr)
+{
+   
+   const GPIO_DEMO_SetPwmDuty_Payload_t *Cmd = CMDMGR_PAYLOAD_PTR(MsgPtr, GPIO_DEMO_SetPwmDuty_t);
+   bool RetStatus = false;
+   ChanTiming_t Timing;
+   
+   if ((Cmd->Channel < GpioCtrl->ChanCnt || Cmd->Channel == GPIO_CTRL_ALL_CHAN) &&
+       Cmd->Duty <= PWM_DUTY_FULL)
+   {
+      
+      Timing.PwmDuty = Cmd->Duty;
+      PublishTimingCfg(Cmd->Channel, TIMING_PWM_DUTY, &Timing);
+      if (!GpioCtrl->QuietCmds)
+      {
+         CFE_EVS_SendEvent (GPIO_CTRL_SET_PWM_EID, CFE_EVS_EventType_INFORMATION, 
+                            "GPIO channel %u PWM duty set to %u.%02u%%", 
+                            Cmd->Channel, Cmd->Duty/100, Cmd->Duty%100);
+      }
+      RetStatus = true;
+   
+   }
+   else
+   {
+      CFE_EVS_SendEvent (GPIO_CTRL_SET_PWM_EID, CFE_EVS_EventType_ERROR, 
+                         "Set PWM duty rejected, channel %u of %u or duty %u exceeds %u", 
+                         Cmd->Channel, GpioCtrl->ChanCnt, Cmd->Duty, PWM_DUTY_FULL);
+   }
+   
+   return RetStatus;   
+   
+} /* End GPIO_CTRL_SetPwmDutyCmd() */
+
+
+/******************************************************************************
+** Function: GPIO_CTRL_SetPwmFreqCmd
+**
+*/
+bool GPIO_CTRL_SetPwmFreqCmd(void* DataObjPtr, const CFE_MSG_Message_t *MsgPtr)
+{
+   
+   const GPIO_DEMO_SetPwmFreq_Payload_t *Cmd = CMDMGR_PAYLOAD_PTR(MsgPtr, GPIO_DEMO_SetPwmFreq_t);
+   bool RetStatus = false;
+   ChanTiming_t Timing;
+   
+   if ((Cmd->Channel < GpioCtrl->ChanCnt || Cmd->Channel == GPIO_CTRL_ALL_CHAN) &&
+       Cmd->FreqHz <= GpioCtrl->PwmMaxFreq)
+   {
+      
+      Timing.PwmFreq = Cmd->FreqHz;
+      PublishTimingCfg(Cmd->Channel, TIMING_PWM_FREQ, &Timing);
+      if (!GpioCtrl->QuietCmds)
+      {
+         CFE_EVS_SendEvent (GPIO_CTRL_SET_PWM_EID, CFE_EVS_EventType_INFORMATION, 
+                            "GPIO channel %u PWM frequency set to %u Hz", Cmd->Channel, Cmd->FreqHz);
+      }
+      RetStatus = true;
+   
+   }
+   else
+   {
+      CFE_EVS_SendEvent (GPIO_CTRL_SET_PWM_EID, CFE_EVS_EventType_ERROR, 
+                         "Set PWM frequency rejected, channel %u of %u or %u Hz exceeds %u Hz", 
+                         Cmd->Channel, GpioCtrl->ChanCnt, Cmd->FreqHz, GpioCtrl->PwmMaxFreq);
+   }
+   
+   return RetStatus;   
+   
+} /* End GPIO_CTRL_SetPwmFreqCmd() */
+
+
+/******************************************************************************
+** Function: GPIO_CTRL_SetQuietCmdsCmd
+**
+** Notes:
+**   1. This command's own event is always sent so the change is logged.
+**
+*/
+bool GPIO_CTRL_SetQuietCmdsCmd(void* DataObjPtr, const CFE_MSG_Message_t *MsgPtr)
+{
+   
+   const GPIO_DEMO_SetQuietCmds_Payload_t *Cmd = CMDMGR_PAYLOAD_PTR(MsgPtr, GPIO_DEMO_SetQuietCmds_t);
+   bool RetStatus = false;
+   
+   if (Cmd->Quiet <= 1)
+   {
+      GpioCtrl->QuietCmds = (Cmd->Quiet == 1);
+      CFE_EVS_SendEvent (GPIO_CTRL_SET_QUIET_CMDS_EID, CFE_EVS_EventType_INFORMATION, 
+                         "Timing and PWM command events %s", GpioCtrl->QuietCmds ? "disabled" : "enabled");
+      RetStatus = true;
+   }
+   else
+   {
+      CFE_EVS_SendEvent (GPIO_CTRL_SET_QUIET_CMDS_EID, CFE_EVS_EventType_ERROR, 
+                         "Invalid quiet command setting %u, must be 0 or 1", Cmd->Quiet);
+   }
+   
+   return RetStatus;   
+   
+} /* End GPIO_CTRL_SetQuietCmdsCmd() */
+
+
+/******************************************************************************
+** Function: GPIO_CTRL_SetTimingCmd
+**
+** Notes:
+**   1. Zero on or off times are rejected.
+**   2. Both times are published in the same TimingCfg update so a channel
+**      never runs a period with one new and one old time.
+**
+*/
+bool GPIO_CTRL_SetTimingCmd(void* DataObjPtr, const CFE_MSG_Message_t *MsgPtr)
+{
+   
+   const GPIO_DEMO_SetTiming_Payload_t *Cmd = CMDMGR_PAYLOAD_PTR(MsgPtr, GPIO_DEMO_SetTiming_t);
+   bool RetStatus = false;
+   ChanTiming_t Timing;
+   
+   if ((Cmd->Channel < GpioCtrl->ChanCnt || Cmd->Channel == GPIO_CTRL_ALL_CHAN) &&
+       Cmd->OnTime > 0 && Cmd->OffTime > 0)
+   {
+      
+      Timing.OnTime  = Cmd->OnTime;
+      Timing.OffTime = Cmd->OffTime;
+      PublishTimingCfg(Cmd->Channel, TIMING_ON_TIME | TIMING_OFF_TIME, &Timing);
+      if (!GpioCtrl->QuietCmds)
+      {
+         CFE_EVS_SendEvent (GPIO_CTRL_SET_TIMING_EID, CFE_EVS_EventType_INFORMATION, 
+                            "GPIO channel %u timing set to %u milliseconds on, %u milliseconds off", 
+                            Cmd->Channel, Cmd->OnTime, Cmd->OffTime);
+      }
+      RetStatus = true;
+   
+   }
+   else
+   {
+      CFE_EVS_SendEvent (GPIO_CTRL_SET_TIMING_EID, CFE_EVS_EventType_ERROR, 
+                         "Set timing rejected, channel %u of %u or a zero time: %u ms on, %u ms off", 
+                         Cmd->Channel, GpioCtrl->ChanCnt, Cmd->OnTime, Cmd->OffTime);
+   }
+   
+   return RetStatus;   
+   
+} /* End GPIO_CTRL_SetTimingCmd() */
+
+
+/******************************************************************************
+** Function: ConfigChannels
+**
+** Parse the comma separated output pin list from the ini file.
+**
+** Notes:
+**   1. Each entry is "pin" or "pin:on_ms:off_ms". The default on/off times
+**      are used when an entry doesn't define its own.
+**   2. A pin may only be assigned to one channel.
+**   3. On and off times must be at least 1 millisecond, a zero length
+**      period would make the child task spin.
+**
+*/
+static bool ConfigChannels(const char* PinList, uint32 OnTime, uint32 OffTime)
+{
+   
+   bool   RetStatus = true;
+   const char* Next  = PinList;
+   char*  End;
+   uint32 Pin;
+   GPIO_CTRL_Chan_t* Chan;
+   
+   while (RetStatus && *Next != '\0')
+   {
+      
+      Pin = strtoul(Next, &End, 10);
+      if (End == Next || Pin > GPIO_DRV_MAX_PIN || 
+          (GpioCtrl->PinMask & GPIO_DRV_PIN_MASK(Pin)) != 0)
+      {
+         CFE_EVS_SendEvent (GPIO_CTRL_CONFIG_EID, CFE_EVS_EventType_ERROR, 
+                            "Invalid or duplicate output pin in pin list entry %d: '%s'",
+                            GpioCtrl->ChanCnt, Next);
+         RetStatus = false;
+         break;
+      }
+      if (GpioCtrl->ChanCnt >= GPIO_CTRL_MAX_CHAN)
+      {
+         CFE_EVS_SendEvent (GPIO_CTRL_CONFIG_EID, CFE_EVS_EventType_ERROR, 
+                            "Output pin list exceeds the maximum of %d channels", GPIO_CTRL_MAX_CHAN);
+         RetStatus = false;
+         break;
+      }
+      
+      Chan = &GpioCtrl->Chan[GpioCtrl->ChanCnt];
+      Chan->Pin     = Pin;
+      Chan->OnTime  = OnTime;
+      Chan->OffTime = OffTime;
+      
+      Next = End;
+      if (*Next == ':')
+      {
+         Chan->OnTime = strtoul(Next+1, &End, 10);
+         Next = End;
+         if (*Next == ':')
+         {
+            Chan->OffTime = strtoul(Next+1, &End, 10);
+            Next = End;
+         }
+      }
+      
+      if (Chan->OnTime == 0 || Chan->OffTime == 0)
+      {
+         CFE_EVS_SendEvent (GPIO_CTRL_CONFIG_EID, CFE_EVS_EventType_ERROR, 
+                            "Zero on or off time for output pin %u, %u ms on, %u ms off",
+                            Pin, Chan->OnTime, Chan->OffTime);
+         RetStatus = false;
+         break;
+      }
+      
+      GpioCtrl->PinMask |= GPIO_DRV_PIN_MASK(Pin);
+      GpioCtrl->PinChan[Pin] = GpioCtrl->ChanCnt;
+      GpioCtrl->ChanCnt++;
+      
+      while (*Next == ',' || *Next == ' ')
+      {
+         Next++;
+      }
+      
+   } /* End pin list loop */
+   
+   return RetStatus;
+   
+} /* End ConfigChannels() */
+
+
+/******************************************************************************
+** Function: ConfigRealTime
+**
+** Apply the ini file's real-time settings to the calling (child) task.
+**
+** Notes:
+**   1. Failures are reported and the child task continues with the
+**      settings it was created with.
+**   2. Memory locking applies to the whole process.
+**   3. The timer slack is always reduced to 1 ns. The default 50 us slack
+**      would delay every semaphore timeout and PWM edges are shorter.
+**
+*/
+static void ConfigRealTime(void)
+{
+   
+   int Status;
+   cpu_set_t CpuSet;
+   struct sched_param SchedParam;
+   
+   prctl(PR_SET_TIMERSLACK, 1UL, 0UL, 0UL, 0UL);
+   
+   if (GpioCtrl->RtCpu < GPIO_CTRL_RT_CPU_ANY)
+   {
+      CPU_ZERO(&CpuSet);
+      CPU_SET(GpioCtrl->RtCpu, &CpuSet);
+      Status = pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &CpuSet);
+      if (Status == 0)
+      {
+         GpioCtrl->RtStatus |= GPIO_CTRL_RT_PINNED;
+      }
+      else
+      {
+         CFE_EVS_SendEvent (GPIO_CTRL_RT_CONFIG_EID, CFE_EVS_EventType_ERROR, 
+                            "Failed to pin child task to CPU %u, errno %d", GpioCtrl->RtCpu, Status);
+      }
+   }
+   
+   if (GpioCtrl->RtPriority > 0)
+   {
+      memset(&SchedParam, 0, sizeof(SchedParam));
+      SchedParam.sched_priority = GpioCtrl->RtPriority;
+      Status = pthread_setschedparam(pthread_self(), SCHED_FIFO, &SchedParam);
+      if (Status == 0)
+      {
+         GpioCtrl->RtStatus |= GPIO_CTRL_RT_FIFO;
+      }
+      else
+      {
+         CFE_EVS_SendEvent (GPIO_CTRL_RT_CONFIG_EID, CFE_EVS_EventType_ERROR, 
+                            "Failed to set child task SCHED_FIFO priority %u, errno %d", GpioCtrl->RtPriority, Status);
+      }
+   }
+
+   if (GpioCtrl->RtLockMem)
+   {
+      if (mlockall(MCL_CURRENT | MCL_FUTURE) == 0)
+      {
+         GpioCtrl->RtStatus |= GPIO_CTRL_RT_LOCKED;
+      }
+      else
+      {
+         CFE_EVS_SendEvent (GPIO_CTRL_RT_CONFIG_EID, CFE_EVS_EventType_ERROR, 
+                            "Failed to lock process memory, errno %d", errno);
+      }
+   }
+   
+} /* End ConfigRealTime() */
+
+
+/******************************************************************************
+** Function: PublishTimingCfg
+**
+** Publish a timing configuration update for the child task.
+**
+** Notes:
+**   1. Only called from the main task so there is a single writer.
+**   2. The update is built in the inactive buffer. The child task only
+**      reads that buffer if its copy started before the previous publish,
+**      in which case CfgSeq has changed and the child retries the copy.
+**   3. On and off time updates are stamped with the current time so the
+**      child task can tell whether they replace a tagged timing override.
+**
+*/
+static void PublishTimingCfg(uint16 Channel, uint8 Fields, const ChanTiming_t* Timing)
+{
+   
+   uint32 Seq = GpioCtrl->CfgSeq;
+   GPIO_CTRL_TimingCfg_t *NextCfg = &GpioCtrl->TimingCfg[(Seq + 1) & 1];
+   uint16 First = 0;
+   uint16 Last  = GpioCtrl->ChanCnt;
+   uint16 i;
+   uint64 Now = MONO_TIME_GetNs();
+   
+   if (Channel != GPIO_CTRL_ALL_CHAN)
+   {
+      First = Channel;
+      Last  = Channel + 1;
+   }
+   
+   *NextCfg = GpioCtrl->TimingCfg[Seq & 1];
+   for (i=First; i < Last; i++)
+   {
+      if (Fields & TIMING_ON_TIME)
+      {
+         NextCfg->OnTime[i] = Timing->OnTime;
+      }
+      if (Fields & TIMING_OFF_TIME)
+      {
+         NextCfg->OffTime[i] = Timing->OffTime;
+      }
+      if (Fields & (TIMING_ON_TIME | TIMING_OFF_TIME))
+      {
+         NextCfg->TimingCmdNs[i] = Now;
+      }
+      if (Fields & TIMING_PWM_FREQ)
+      {
+         NextCfg->PwmFreq[i] = Timing->PwmFreq;
+      }
+      if (Fields & TIMING_PWM_DUTY)
+      {
+         NextCfg->PwmDuty[i] = Timing->PwmDuty;
+      }
+   }
+   
+   __atomic_store_n(&GpioCtrl->CfgSeq, Seq + 1, __ATOMIC_RELEASE);
+   WakeChild();
+   
+} /* End PublishTimingCfg() */
+
+
+/******************************************************************************
+** Function: ApplyTimingCfg
+**
+** Apply ChildCfg to the channels.
+**
+** Notes:
+**   1. The current phase's end is recomputed from the channel's last edge
+**      so a shortened phase that has already elapsed ends at the next bank
+**      write.
+**   2. A PWM change is applied to the current period. A channel that was
+**      held low starts a period immediately and a channel set to 0 Hz is
+**      cleared.
+**
+*/
+static void ApplyTimingCfg(void)
+{
+   
+   GPIO_CTRL_Chan_t* Chan;
+   uint32 PeriodNs;
+   uint32 HighNs;
+   uint64 ClrMask = 0;
+   uint16 i;
+   
+   for (i=0; i < GpioCtrl->ChanCnt; i++)
+   {
+      
+      Chan = &GpioCtrl->Chan[i];
+      Chan->OnTime  = GpioCtrl->ChildCfg.OnTime[i];
+      Chan->OffTime = GpioCtrl->ChildCfg.OffTime[i];
+      
+      if (Chan->Started)
+      {
+         Chan->NextEdge = Chan->PhaseStart + (Chan->On ? Chan->OnTime : Chan->OffTime);
+         if ((int32)(Chan->NextEdge - GpioCtrl->Timeline) < 0)
+         {
+            Chan->NextEdge = GpioCtrl->Timeline;
+         }
+         TIMER_WHEEL_Add(&GpioCtrl->EdgeWheel, i, Chan->NextEdge);
+      }
+      
+      PeriodNs = (GpioCtrl->ChildCfg.PwmFreq[i] > 0) ? MONO_TIME_NS_PER_SEC / GpioCtrl->ChildCfg.PwmFreq[i] : 0;
+      HighNs   = (uint64)PeriodNs * GpioCtrl->ChildCfg.PwmDuty[i] / PWM_DUTY_FULL;
+      
+      if (PeriodNs == 0)
+      {
+         if (Chan->PwmHigh && GpioCtrl->ActiveMode == GPIO_DEMO_CtrlMode_PWM)
+         {
+            ClrMask |= GPIO_DRV_PIN_MASK(Chan->Pin);
+            Chan->PwmHigh = false;
+         }
+         __atomic_store_n(&Chan->PwmAchDuty, 0, __ATOMIC_RELAXED);
+      }
+      else if (Chan->PwmPeriodNs == 0)
+      {
+         Chan->PwmAtStart  = true;
+         Chan->PwmNextNs   = MONO_TIME_GetNs();
+         Chan->PwmWindowNs = Chan->PwmNextNs;
+         Chan->PwmHighAccNs = 0;
+      }
+      else if (HighNs > 0 && HighNs < PeriodNs && Chan->PwmHigh)
+      {
+         Chan->PwmAtStart = false;
+         Chan->PwmNextNs  = Chan->PwmStartNs + HighNs;
+      }
+      else
+      {
+         Chan->PwmAtStart = true;
+         Chan->PwmNextNs  = Chan->PwmStartNs + ((Chan->PwmHigh && HighNs == 0) ? 0 : PeriodNs);
+      }
+      Chan->PwmPeriodNs = PeriodNs;
+      Chan->PwmHighNs   = HighNs;
+   
+   } /* End channel loop */
+   
+   if (ClrMask != 0)
+   {
+      WriteBank(0, ClrMask);
+   }
+   
+} /* End ApplyTimingCfg() */
+
+
+/******************************************************************************
+** Function: EnterMode
+**
+** Switch the child task to a new mode
+**
+** Notes:
+**   1. Must only be called from the child task.
+**   2. Blink mode resumes each channel's interrupted phase from the current
+**      time. PWM mode starts a period on every channel. Sequence mode
+**      starts the sequence from its first op.
+**
+*/
+static void EnterMode(uint8 Mode)
+{
+   
+   uint64 OnMask = 0;
+   uint64 Now;
+   GPIO_CTRL_Chan_t* Chan;
+   uint16 i;
+   
+   if (Mode != GPIO_DEMO_CtrlMode_PATTERN)
+   {
+      PATTERN_TBL_Release();
+   }
+   if (Mode != GPIO_DEMO_CtrlMode_SEQUENCE)
+   {
+      SEQ_TBL_Release();
+   }
+   
+   if (Mode == GPIO_DEMO_CtrlMode_PATTERN)
+   {
+      
+      GpioCtrl->Pattern = NULL;
+      WriteBank(0, GpioCtrl->PinMask);
+   
+   }
+   else if (Mode == GPIO_DEMO_CtrlMode_SEQUENCE)
+   {
+      
+      GpioCtrl->Sequence = NULL;
+      WriteBank(0, GpioCtrl->PinMask);
+   
+   }
+   else if (Mode == GPIO_DEMO_CtrlMode_PWM)
+   {
+      
+      WriteBank(0, GpioCtrl->PinMask);
+      Now = MONO_TIME_GetNs();
+      for (i=0; i < GpioCtrl->ChanCnt; i++)
+      {
+         Chan = &GpioCtrl->Chan[i];
+         Chan->PwmHigh      = false;
+         Chan->PwmAtStart   = true;
+         Chan->PwmNextNs    = Now;
+         Chan->PwmWindowNs  = Now;
+         Chan->PwmHighAccNs = 0;
+      }
+      GpioCtrl->PwmSpinWindowStart = Now;
+      GpioCtrl->PwmSpinWindowNs    = 0;
+   
+   }
+   else
+   {
+      
+      for (i=0; i < GpioCtrl->ChanCnt; i++)
+      {
+         if (GpioCtrl->Chan[i].On)
+         {
+            OnMask |= GPIO_DRV_PIN_MASK(GpioCtrl->Chan[i].Pin);
+         }
+      }
+      WriteBank(OnMask, GpioCtrl->PinMask & ~OnMask);
+      
+      GpioCtrl->EdgeDeadline = MONO_TIME_GetNs();
+      GpioCtrl->LastEdgeNs   = GpioCtrl->EdgeDeadline;
+   
+   }
+   
+   GpioCtrl->ActiveMode = Mode;
+   
+} /* End EnterMode() */
+
+
+/******************************************************************************
+** Function: ModeStr
+**
+*/
+static const char* ModeStr(uint8 Mode)
+{
+   
+   const char* Str = "BLINK";
+   
+   if (Mode == GPIO_DEMO_CtrlMode_PATTERN)
+   {
+      Str = "PATTERN";
+   }
+   else if (Mode == GPIO_DEMO_CtrlMode_PWM)
+   {
+      Str = "PWM";
+   }
+   else if (Mode == GPIO_DEMO_CtrlMode_SEQUENCE)
+   {
+      Str = "SEQUENCE";
+   }
+   
+   return Str;
+   
+} /* End ModeStr() */
+
+
+/******************************************************************************
+** Function: OverrideTiming
+**
+** Replace ChildCfg's on and off times with the tagged timing overrides
+**
+** Notes:
+**   1. Only called from the child task. An override ends when a timing
+**      command for its channel was received after the override's deadline.
+**
+*/
+static void OverrideTiming(void)
+{
+   
+   uint16 i;
+   
+   for (i=0; i < GpioCtrl->ChanCnt; i++)
+   {
+      if (GpioCtrl->TagTimingNs[i] == 0)
+      {
+         continue;
+      }
+      if (GpioCtrl->ChildCfg.TimingCmdNs[i] > GpioCtrl->TagTimingNs[i])
+      {
+         GpioCtrl->TagTimingNs[i] = 0;
+      }
+      else
+      {
+         GpioCtrl->ChildCfg.OnTime[i]  = GpioCtrl->TagOnTime[i];
+         GpioCtrl->ChildCfg.OffTime[i] = GpioCtrl->TagOffTime[i];
+      }
+   }
+   
+} /* End OverrideTiming() */
+
+
+/******************************************************************************
+** Function: ReadTimingCfg
+**
+** Copy the latest published timing configuration into ChildCfg.
+**
+** Notes:
+**   1. Only called from the child task. The copy is repeated whenever
+**      CfgSeq changed while it was in progress, i.e. after any publish
+**      during the copy, not only one that overwrote the copied buffer.
+**
+*/
+static void ReadTimingCfg(void)
+{
+   
+   uint32 Seq;
+   
+   do
+   {
+      Seq = __atomic_load_n(&GpioCtrl->CfgSeq, __ATOMIC_ACQUIRE);
+      GpioCtrl->ChildCfg = GpioCtrl->TimingCfg[Seq & 1];
+      __atomic_thread_fence(__ATOMIC_ACQUIRE);
+   
+   } while (Seq != __atomic_load_n(&GpioCtrl->CfgSeq, __ATOMIC_RELAXED));
+   
+   GpioCtrl->CfgApplySeq = Seq;
+   
+   OverrideTiming();
+   
+} /* End ReadTimingCfg() */
+
+
+/******************************************************************************
+** Function: ReceiveTags
+**
+** Move the actions posted by commands from TagRing into the tag heap
+**
+** Notes:
+**   1. Only called from the child task. A free pool entry always exists
+**      because the command limits the queued actions to the pool size.
+**
+*/
+static void ReceiveTags(void)
+{
+   
+   uint32 Head = __atomic_load_n(&GpioCtrl->TagHead, __ATOMIC_ACQUIRE);
+   uint16 Id;
+   
+   while (GpioCtrl->TagTail != Head)
+   {
+      
+      Id = GpioCtrl->TagFree[--GpioCtrl->TagFreeCnt];
+      GpioCtrl->TagPool[Id] = GpioCtrl->TagRing[GpioCtrl->TagTail & TAG_RING_MASK];
+      TIME_HEAP_Push(&GpioCtrl->TagHeap, GpioCtrl->TagPool[Id].TimeNs, Id);
+      GpioCtrl->TagTail++;
+   
+   }
+   
+} /* End ReceiveTags() */
+
+
+/******************************************************************************
+** Function: RemapGpio
+**
+** Map the GPIO backend and configure the output pins
+**
+** Notes:
+**   1. Must only be called from the child task.
+**   2. On success the outputs are restored to OutLevel and the timeline is
+**      re-anchored to the current time so the interrupted phases resume
+**      instead of being replayed.
+**   3. On failure the next retry is scheduled after the current backoff
+**      which is then doubled up to RemapMaxMs. The driver has reported the
+**      failure's cause so the retry is only a debug event.
+**
+*/
+static void RemapGpio(void)
+{
+   
+   uint64 Now;
+   
+   GpioCtrl->MapAttemptCnt++;
+   GpioCtrl->IsMapped = GPIO_DRV_Map() && GPIO_DRV_ConfigOut(GpioCtrl->PinMask);
+   Now = MONO_TIME_GetNs();
+   
+   if (GpioCtrl->IsMapped)
+   {
+      
+      GPIO_DRV_Write(GpioCtrl->OutLevel, GpioCtrl->PinMask & ~GpioCtrl->OutLevel);
+      GpioCtrl->EdgeDeadline = Now;
+      GpioCtrl->LastEdgeNs   = Now;
+      
+      CFE_EVS_SendEvent (GPIO_CTRL_REMAP_EID, CFE_EVS_EventType_INFORMATION, 
+                         "GPIO remapped in %u ns, %u failed map retries since reset", 
+                         GpioCtrl->GpioDrv.MapNs, GpioCtrl->MapFailCnt);
+      
+      GpioCtrl->MapRetryMs = GpioCtrl->RemapMinMs;
+   
+   }
+   else
+   {
+      
+      GpioCtrl->MapFailCnt++;
+      GpioCtrl->MapRetryNs = Now + (uint64)GpioCtrl->MapRetryMs * MONO_TIME_NS_PER_MS;
+      
+      CFE_EVS_SendEvent (GPIO_CTRL_REMAP_EID, CFE_EVS_EventType_DEBUG, 
+                         "GPIO map attempt %u failed, retrying in %u milliseconds", 
+                         GpioCtrl->MapAttemptCnt, GpioCtrl->MapRetryMs);
+      
+      GpioCtrl->MapRetryMs = (GpioCtrl->MapRetryMs > GpioCtrl->RemapMaxMs/2) ? 
+                             GpioCtrl->RemapMaxMs : 2*GpioCtrl->MapRetryMs;
+   
+   }
+   
+} /* End RemapGpio() */
+
+
+/******************************************************************************
+** Function: ResetChildStatus
+**
+** Reset the statistics written by the child task
+**
+** Notes:
+**   1. Must only be called from the child task, see GPIO_CTRL_ResetStatus().
+**
+*/
+static void ResetChildStatus(void)
+{
+   
+   GPIO_DRV_ResetStatus();
+   
+   GpioCtrl->MaxOverrunNs  = 0;
+   GpioCtrl->ResyncCnt     = 0;
+   GpioCtrl->ResyncDriftNs = 0;
+   GpioCtrl->EdgeCnt       = 0;
+   GpioCtrl->EdgeEventCnt  = 0;
+   GpioCtrl->OnTimeTotal   = 0;
+   GpioCtrl->WakeCnt       = 0;
+   GpioCtrl->MapAttemptCnt = 0;
+   GpioCtrl->MapFailCnt    = 0;
+   GpioCtrl->PatternCycleCnt  = 0;
+   GpioCtrl->PwmSpinTotalNs   = 0;
+   GpioCtrl->PwmSpinSkipCnt   = 0;
+   GpioCtrl->PwmPeriodSkipCnt = 0;
+   GpioCtrl->PwmEdgeCnt       = 0;
+   GpioCtrl->TagExecCnt   = 0;
+   GpioCtrl->TagFailCnt   = 0;
+   GpioCtrl->TagMaxLateNs = 0;
+   GpioCtrl->SeqRunCnt    = 0;
+   GpioCtrl->SeqYieldCnt  = 0;
+   memset(GpioCtrl->SeqOpCnt, 0, sizeof(GpioCtrl->SeqOpCnt));
+   memset(GpioCtrl->SeqOpTotalNs, 0, sizeof(GpioCtrl->SeqOpTotalNs));
+   memset(GpioCtrl->SeqOpMaxNs, 0, sizeof(GpioCtrl->SeqOpMaxNs));
+   
+   LAT_HIST_Reset(&GpioCtrl->EdgeHist);
+   
+} /* End ResetChildStatus() */
+
+
+/******************************************************************************
+** Function: RunBlinkEdge
+**
+** Wait for the next EdgeWheel tick and write every edge that expires at that
+** tick in one bank update.
+**
+** Notes:
+**   1. Timeline comparisons use signed differences so the millisecond
+**      timeline can wrap.
+**   2. A tick where the wheel only cascades timers from a higher level has
+**      no edges and doesn't write the bank. This happens at most once per
+**      TIMER_WHEEL_L0_SLOTS milliseconds.
+**
+*/
+static void RunBlinkEdge(void)
+{
+   
+   uint16 i;
+   uint16 DueCnt;
+   uint32 EdgeTime;
+   uint64 IdealNs;
+   uint64 SetMask = 0;
+   uint64 ClrMask = 0;
+   GPIO_CTRL_Chan_t* Chan;
+   
+   if (!TIMER_WHEEL_NextTick(&GpioCtrl->EdgeWheel, &EdgeTime))
+   {
+      WaitForWake(UINT64_MAX);
+      return;
+   }
+   
+   if (!WaitForEdge(EdgeTime, &IdealNs))
+   {
+      return;
+   }
+   
+   DueCnt = TIMER_WHEEL_Expire(&GpioCtrl->EdgeWheel, EdgeTime, GpioCtrl->DueChan);
+   for (i=0; i < DueCnt; i++)
+   {
+      
+      Chan = &GpioCtrl->Chan[GpioCtrl->DueChan[i]];
+      if (Chan->On)
+      {
+         ClrMask |= GPIO_DRV_PIN_MASK(Chan->Pin);
+         Chan->NextEdge = EdgeTime + Chan->OffTime;
+         GpioCtrl->OnTimeTotal += EdgeTime - Chan->PhaseStart;
+      }
+      else
+      {
+         SetMask |= GPIO_DRV_PIN_MASK(Chan->Pin);
+         Chan->NextEdge = EdgeTime + Chan->OnTime;
+      }
+      Chan->On = !Chan->On;
+      Chan->Started    = true;
+      Chan->PhaseStart = EdgeTime;
+      TIMER_WHEEL_Add(&GpioCtrl->EdgeWheel, GpioCtrl->DueChan[i], Chan->NextEdge);
+      
+   } /* End due channel loop */
+   
+   if (DueCnt == 0)
+   {
+      return;
+   }
+   
+   WriteBank(SetMask, ClrMask);
+   LAT_HIST_AddSample(&GpioCtrl->EdgeHist, (int64)(MONO_TIME_GetNs() - IdealNs));
+   GpioCtrl->EdgeCnt     += __builtin_popcountll(SetMask | ClrMask);
+   GpioCtrl->LastEdgeTime = EdgeTime;
+   
+   if (GpioCtrl->EdgeEventPeriod > 0 && (int32)(EdgeTime - GpioCtrl->EdgeEventTime) >= 0)
+   {
+      CFE_EVS_SendEvent (GPIO_CTRL_CHILD_TASK_EID, CFE_EVS_EventType_DEBUG,
+                         "%u GPIO edges since last report, bank write at %u ms: set 0x%016llX, clear 0x%016llX",
+                         GpioCtrl->EdgeCnt - GpioCtrl->EdgeEventCnt, EdgeTime, 
+                         (unsigned long long)SetMask, (unsigned long long)ClrMask);
+      GpioCtrl->EdgeEventTime = EdgeTime + GpioCtrl->EdgeEventPeriod;
+      GpioCtrl->EdgeEventCnt  = GpioCtrl->EdgeCnt;
+   }
+   
+} /* End RunBlinkEdge() */
+
+
+/******************************************************************************
+** Function: RunPatternStep
+**
+** Wait for and write the next pattern step
+**
+** Notes:
+**   1. A newly published pattern restarts from its first step.
+**   2. A step more than GPIO_CTRL_RESYNC_MS late re-anchors the pattern to
+**      the current time.
+**
+*/
+static void RunPatternStep(void)
+{
+   
+   const PATTERN_TBL_Pattern_t* Pattern = PATTERN_TBL_GetPattern();
+   const PATTERN_TBL_Step_t*    Step;
+   uint64 Now;
+   uint8  Wait;
+   
+   if (Pattern != GpioCtrl->Pattern)
+   {
+      GpioCtrl->Pattern       = Pattern;
+      GpioCtrl->PatternStep   = 0;
+      GpioCtrl->PatternNextNs = MONO_TIME_GetNs();
+   }
+   
+   if (Pattern->StepCnt == 0)
+   {
+      WaitForWake(UINT64_MAX);
+      return;
+   }
+   
+   Wait = WaitForWake(GpioCtrl->PatternNextNs);
+   if (Wait != WAIT_DUE)
+   {
+      GpioCtrl->WakeCnt += (Wait == WAIT_WOKEN);
+      return;
+   }
+   
+   Step = &Pattern->Step[GpioCtrl->PatternStep];
+   WriteBank(Step->SetMask, Step->ClrMask);
+   Now = MONO_TIME_GetNs();
+   LAT_HIST_AddSample(&GpioCtrl->EdgeHist, (int64)(Now - GpioCtrl->PatternNextNs));
+   GpioCtrl->EdgeCnt += __builtin_popcountll(Step->SetMask | Step->ClrMask);
+   
+   if (Now > GpioCtrl->PatternNextNs &&
+       Now - GpioCtrl->PatternNextNs > (uint64)GPIO_CTRL_RESYNC_MS * MONO_TIME_NS_PER_MS)
+   {
+      GpioCtrl->PatternNextNs = Now;
+      GpioCtrl->ResyncCnt++;
+   }
+   GpioCtrl->PatternNextNs += Step->HoldNs;
+   
+   GpioCtrl->PatternStep = (GpioCtrl->PatternStep + 1 < Pattern->StepCnt) ? GpioCtrl->PatternStep + 1 : 0;
+   GpioCtrl->PatternCycleCnt += (GpioCtrl->PatternStep == 0);
+   
+} /* End RunPatternStep() */
+
+
+/******************************************************************************
+** Function: RunPwmEdge
+**
+** Wait for the earliest PWM edge and write every PWM edge due by then in
+** one bank update.
+**
+** Notes:
+**   1. Each period starts with a set and ends with the clear at the high
+**      time. 0% and 100% duty channels have no clear edge and only check
+**      their level at each period start.
+**   2. Period starts stay on the intended timeline. A start that is a full
+**      period or more late skips the missed periods instead of writing
+**      them back to back.
+**   3. Achieved duty is the measured high time over the actual elapsed
+**      time, published every PWM_DUTY_WINDOW_NS at a period start.
+**
+*/
+static void RunPwmEdge(void)
+{
+   
+   uint16 i;
+   uint64 EdgeNs = UINT64_MAX;
+   uint64 Now;
+   uint64 Skip;
+   uint64 SetMask = 0;
+   uint64 ClrMask = 0;
+   uint64 PinMask;
+   bool   High;
+   bool   PeriodStart;
+   uint8  Wait;
+   GPIO_CTRL_Chan_t* Chan;
+   
+   for (i=0; i < GpioCtrl->ChanCnt; i++)
+   {
+      if (GpioCtrl->Chan[i].PwmPeriodNs > 0 && GpioCtrl->Chan[i].PwmNextNs < EdgeNs)
+      {
+         EdgeNs = GpioCtrl->Chan[i].PwmNextNs;
+      }
+   }
+   
+   if (EdgeNs == UINT64_MAX)
+   {
+      WaitForWake(UINT64_MAX);
+      return;
+   }
+   
+   Wait = WaitForPwmEdge(EdgeNs);
+   if (Wait != WAIT_DUE)
+   {
+      GpioCtrl->WakeCnt += (Wait == WAIT_WOKEN);
+      return;
+   }
+   
+   Now = MONO_TIME_GetNs();
+   for (i=0; i < GpioCtrl->ChanCnt; i++)
+   {
+      
+      Chan = &GpioCtrl->Chan[i];
+      if (Chan->PwmPeriodNs == 0 || Chan->PwmNextNs > Now)
+      {
+         continue;
+      }
+      
+      PinMask = GPIO_DRV_PIN_MASK(Chan->Pin);
+      PeriodStart = Chan->PwmAtStart;
+      if (PeriodStart)
+      {
+         if (Now - Chan->PwmNextNs >= Chan->PwmPeriodNs)
+         {
+            Skip = (Now - Chan->PwmNextNs) / Chan->PwmPeriodNs;
+            Chan->PwmNextNs += Skip * Chan->PwmPeriodNs;
+            GpioCtrl->PwmPeriodSkipCnt += Skip;
+         }
+         Chan->PwmStartNs = Chan->PwmNextNs;
+         High = (Chan->PwmHighNs > 0);
+         Chan->PwmAtStart = !(High && Chan->PwmHighNs < Chan->PwmPeriodNs);
+         Chan->PwmNextNs  = Chan->PwmStartNs + (Chan->PwmAtStart ? Chan->PwmPeriodNs : Chan->PwmHighNs);
+      }
+      else
+      {
+         High = false;
+         Chan->PwmAtStart = true;
+         Chan->PwmNextNs  = Chan->PwmStartNs + Chan->PwmPeriodNs;
+      }
+      
+      if (High && !Chan->PwmHigh)
+      {
+         SetMask |= PinMask;
+         Chan->PwmHighSinceNs = Now;
+      }
+      else if (!High && Chan->PwmHigh)
+      {
+         ClrMask |= PinMask;
+         Chan->PwmHighAccNs += Now - Chan->PwmHighSinceNs;
+      }
+      Chan->PwmHigh = High;
+      
+      if (PeriodStart && Now - Chan->PwmWindowNs >= PWM_DUTY_WINDOW_NS)
+      {
+         if (Chan->PwmHigh)
+         {
+            Chan->PwmHighAccNs  += Now - Chan->PwmHighSinceNs;
+            Chan->PwmHighSinceNs = Now;
+         }
+         __atomic_store_n(&Chan->PwmAchDuty, (uint16)(Chan->PwmHighAccNs * PWM_DUTY_FULL / (Now - Chan->PwmWindowNs)), __ATOMIC_RELAXED);
+         Chan->PwmWindowNs  = Now;
+         Chan->PwmHighAccNs = 0;
+      }
+      
+   } /* End channel loop */
+   
+   if ((SetMask | ClrMask) != 0)
+   {
+      WriteBank(SetMask, ClrMask);
+      LAT_HIST_AddSample(&GpioCtrl->EdgeHist, (int64)(MONO_TIME_GetNs() - EdgeNs));
+      GpioCtrl->EdgeCnt += __builtin_popcountll(SetMask | ClrMask);
+      GpioCtrl->PwmEdgeCnt++;
+   }
+   
+} /* End RunPwmEdge() */
+
+
+/******************************************************************************
+** Function: RunSequence
+**
+** Wait for the sequence's next op time and dispatch ops until a wait
+**
+** Notes:
+**   1. A newly published sequence starts from its first op.
+**   2. Every op is a few instructions or one bank write or pin read, a
+**      pass stops at a wait, at STOP or after SEQ_OP_BUDGET ops so each
+**      pass is bounded. A pass that used its budget waits SEQ_YIELD_NS.
+**   3. The monotonic clock is read once per op and each op's time is
+**      added to its opcode's profile, so an op's time includes one clock
+**      read.
+**   4. The first write of a pass adds its lateness to the edge histogram.
+**   5. A wait more than GPIO_CTRL_RESYNC_MS late re-anchors the sequence
+**      timeline to the current time.
+**   6. A branch whose pin read fails, e.g. during a remap, isn't taken or
+**      skipped. The pass ends on the branch and it runs again after
+**      SEQ_YIELD_NS.
+**
+*/
+static void RunSequence(void)
+{
+   
+   const SEQ_TBL_Program_t* Program = SEQ_TBL_GetProgram();
+   const SEQ_TBL_Write_t*   Write;
+   SEQ_TBL_Op_t Op;
+   uint16 Pc;
+   uint16 Budget;
+   uint64 Level;
+   uint64 Now;
+   uint64 OpNs;
+   bool   Sampled = false;
+   bool   EndPass = false;
+   uint8  Wait;
+   
+   if (Program != GpioCtrl->Sequence)
+   {
+      GpioCtrl->Sequence  = Program;
+      GpioCtrl->SeqPc     = 0;
+      GpioCtrl->SeqDone   = false;
+      GpioCtrl->SeqNextNs = MONO_TIME_GetNs();
+   }
+   
+   if (Program->OpCnt == 0 || GpioCtrl->SeqDone)
+   {
+      WaitForWake(UINT64_MAX);
+      return;
+   }
+   
+   Wait = WaitForWake(GpioCtrl->SeqNextNs);
+   if (Wait != WAIT_DUE)
+   {
+      GpioCtrl->WakeCnt += (Wait == WAIT_WOKEN);
+      return;
+   }
+   
+   Now = MONO_TIME_GetNs();
+   if (Now > GpioCtrl->SeqNextNs &&
+       Now - GpioCtrl->SeqNextNs > (uint64)GPIO_CTRL_RESYNC_MS * MONO_TIME_NS_PER_MS)
+   {
+      GpioCtrl->SeqNextNs = Now;
+      GpioCtrl->ResyncCnt++;
+   }
+   
+   Pc = GpioCtrl->SeqPc;
+   for (Budget = SEQ_OP_BUDGET; Budget > 0 && !EndPass; Budget--)
+   {
+      
+      Op = Program->Op[Pc++];
+      switch (Op.Op)
+      {
+         case SEQ_TBL_OP_WRITE:
+            Write = &Program->Write[Op.B];
+            WriteBank(Write->SetMask, Write->ClrMask);
+            if (!Sampled)
+            {
+               LAT_HIST_AddSample(&GpioCtrl->EdgeHist, (int64)(Now - GpioCtrl->SeqNextNs));
+               Sampled = true;
+            }
+            GpioCtrl->EdgeCnt += __builtin_popcountll(Write->SetMask | Write->ClrMask);
+            break;
+         case SEQ_TBL_OP_WAIT:
+            GpioCtrl->SeqNextNs += (uint64)SEQ_TBL_WAIT_US(&Op) * 1000;
+            EndPass = true;
+            break;
+         case SEQ_TBL_OP_LOOP:
+            GpioCtrl->SeqCounter[Op.A] = Op.B;
+            break;
+         case SEQ_TBL_OP_NEXT:
+            if (--GpioCtrl->SeqCounter[Op.A] != 0)
+            {
+               Pc = Op.B;
+            }
+            break;
+         case SEQ_TBL_OP_JUMP:
+            Pc = Op.B;
+            break;
+         case SEQ_TBL_OP_IF_HIGH:
+         case SEQ_TBL_OP_IF_LOW:
+            if (!GPIO_DRV_ReadAll(&Level))
+            {
+               Pc--;
+               GpioCtrl->SeqNextNs = Now + SEQ_YIELD_NS;
+               EndPass = true;
+            }
+            else if (((Level >> Op.A) & 1) == (Op.Op == SEQ_TBL_OP_IF_HIGH))
+            {
+               Pc = Op.B;
+            }
+            break;
+         default:
+            GpioCtrl->SeqDone = true;
+            GpioCtrl->SeqRunCnt++;
+            EndPass = true;
+            break;
+      }
+      
+      OpNs = Now;
+      Now  = MONO_TIME_GetNs();
+      OpNs = Now - OpNs;
+      GpioCtrl->SeqOpCnt[Op.Op]++;
+      GpioCtrl->SeqOpTotalNs[Op.Op] += OpNs;
+      if (OpNs > GpioCtrl->SeqOpMaxNs[Op.Op])
+      {
+         GpioCtrl->SeqOpMaxNs[Op.Op] = (uint32)OpNs;
+      }
+   
+   } /* End dispatch loop */
+   
+   if (!EndPass)
+   {
+      GpioCtrl->SeqNextNs = Now + SEQ_YIELD_NS;
+      GpioCtrl->SeqYieldCnt++;
+   }
+   GpioCtrl->SeqPc = Pc;
+   
+} /* End RunSequence() */
+
+
+/******************************************************************************
+** Function: RunStats
+**
+** Send the controller statistics packet when it is due
+**
+** Notes:
+**   1. DutyAch is each channel's cumulative high time less its value at
+**      the start of the window, so the window needs no per-edge state.
+**   2. Missed periods are skipped rather than sent back to back.
+**
+*/
+static void RunStats(void)
+{
+   
+   GPIO_DEMO_CtrlStatsTlm_t *StatsTlm;
+   GPIO_DEMO_CtrlStatsTlm_Payload_t *Payload;
+   const CHAN_STATS_Class_t *ChanStats = &GpioCtrl->ChanStats;
+   uint64 Now;
+   uint64 WindowNs;
+   uint16 i;
+   
+   if (GpioCtrl->StatsPeriodNs == 0)
+   {
+      return;
+   }
+   Now = MONO_TIME_GetNs();
+   if (Now < GpioCtrl->StatsNextNs)
+   {
+      return;
+   }
+   
+   StatsTlm = (GPIO_DEMO_CtrlStatsTlm_t*)TLM_BUF_Alloc(TLM_BUF_CHILD_TASK, GpioCtrl->CtrlStatsTlmMid, sizeof(GPIO_DEMO_CtrlStatsTlm_t));
+   Payload  = &StatsTlm->Payload;
+   WindowNs = Now - GpioCtrl->StatsWindowNs;
+   
+   Payload->TimeNs   = Now;
+   Payload->WindowNs = SatUint32(WindowNs);
+   Payload->ChanCnt  = GpioCtrl->ChanCnt;
+   Payload->PeriodMs = GpioCtrl->StatsPeriodNs / MONO_TIME_NS_PER_MS;
+   memcpy(Payload->LastEdgeNs, ChanStats->LastEdgeNs, GpioCtrl->ChanCnt*sizeof(uint64));
+   memcpy(Payload->EdgeCnt, ChanStats->ToggleCnt, GpioCtrl->ChanCnt*sizeof(uint32));
+   CHAN_STATS_GetHighNs(ChanStats, Now, Payload->HighNs);
+   for (i=0; i < GpioCtrl->ChanCnt; i++)
+   {
+      Payload->MaxHighUs[i] = SatUint32(ChanStats->MaxHighNs[i] / 1000);
+      Payload->MaxLowUs[i]  = SatUint32(ChanStats->MaxLowNs[i] / 1000);
+   }
+   if (WindowNs > 0)
+   {
+      for (i=0; i < GpioCtrl->ChanCnt; i++)
+      {
+         Payload->DutyAch[i] = (uint16)((Payload->HighNs[i] - GpioCtrl->StatsHighNs[i]) * PWM_DUTY_FULL / WindowNs);
+      }
+   }
+   memcpy(GpioCtrl->StatsHighNs, Payload->HighNs, GpioCtrl->ChanCnt*sizeof(uint64));
+   
+   TLM_BUF_Send((CFE_SB_Buffer_t*)StatsTlm);
+   
+   GpioCtrl->StatsWindowNs = Now;
+   GpioCtrl->StatsNextNs  += GpioCtrl->StatsPeriodNs;
+   if (GpioCtrl->StatsNextNs <= Now)
+   {
+      GpioCtrl->StatsNextNs = Now + GpioCtrl->StatsPeriodNs;
+   }
+   
+} /* End RunStats() */
+
+
+/******************************************************************************
+** Function: RunTag
+**
+** Run one time-tagged action
+**
+** Notes:
+**   1. Must only be called from the child task while the GPIO is mapped.
+**   2. Pins set by an action keep their level until a blink or PWM edge of
+**      their channel writes them.
+**   3. A started pattern runs its first step at the tag's deadline, an
+**      active pattern restarts.
+**   4. START_PATTERN only changes ActiveMode. ModeReq is only written by
+**      GPIO_CTRL_SetModeCmd() so a later SetMode command always replaces
+**      the tagged pattern.
+**
+*/
+static bool RunTag(const GPIO_CTRL_Tag_t* Tag)
+{
+   
+   const PATTERN_TBL_Pattern_t* Pattern;
+   bool   RetStatus = true;
+   uint16 First = 0;
+   uint16 Last  = GpioCtrl->ChanCnt;
+   uint16 i;
+   
+   if (Tag->Action == GPIO_DEMO_TagAction_SET_PINS)
+   {
+      
+      WriteBank(Tag->SetMask, Tag->ClrMask);
+      GpioCtrl->EdgeCnt += __builtin_popcountll(Tag->SetMask | Tag->ClrMask);
+   
+   }
+   else if (Tag->Action == GPIO_DEMO_TagAction_SET_TIMING)
+   {
+      
+      if (Tag->Channel != GPIO_CTRL_ALL_CHAN)
+      {
+         First = Tag->Channel;
+         Last  = Tag->Channel + 1;
+      }
+      for (i=First; i < Last; i++)
+      {
+         GpioCtrl->TagTimingNs[i] = Tag->TimeNs;
+         GpioCtrl->TagOnTime[i]   = Tag->OnTime;
+         GpioCtrl->TagOffTime[i]  = Tag->OffTime;
+      }
+      OverrideTiming();
+      ApplyTimingCfg();
+   
+   }
+   else
+   {
+      
+      Pattern = PATTERN_TBL_GetPattern();
+      if (Pattern->StepCnt > 0)
+      {
+         EnterMode(GPIO_DEMO_CtrlMode_PATTERN);
+         GpioCtrl->Pattern       = Pattern;
+         GpioCtrl->PatternStep   = 0;
+         GpioCtrl->PatternNextNs = Tag->TimeNs;
+      }
+      else
+      {
+         if (GpioCtrl->ActiveMode != GPIO_DEMO_CtrlMode_PATTERN)
+         {
+            PATTERN_TBL_Release();
+         }
+         RetStatus = false;
+      }
+   
+   }
+   
+   return RetStatus;
+   
+} /* End RunTag() */
+
+
+/******************************************************************************
+** Function: RunTags
+**
+** Run every time-tagged action that is due, in deadline order
+**
+** Notes:
+**   1. Must only be called from the child task while the GPIO is mapped.
+**   2. TagDoneCnt is stored with release after the action's pool entry is
+**      free so the command never queues more actions than the pool holds.
+**
+*/
+static void RunTags(void)
+{
+   
+   uint64 TimeNs;
+   uint64 LateNs;
+   uint16 Id;
+   
+   while (TIME_HEAP_Peek(&GpioCtrl->TagHeap, &TimeNs) && TimeNs <= MONO_TIME_GetNs())
+   {
+      
+      TIME_HEAP_Pop(&GpioCtrl->TagHeap, &Id);
+      
+      if (RunTag(&GpioCtrl->TagPool[Id]))
+      {
+         LateNs = MONO_TIME_GetNs() - TimeNs;
+         if (LateNs > GpioCtrl->TagMaxLateNs)
+         {
+            GpioCtrl->TagMaxLateNs = LateNs;
+         }
+         GpioCtrl->TagExecCnt++;
+      }
+      else
+      {
+         CFE_EVS_SendEvent (GPIO_CTRL_TAG_EXEC_EID, CFE_EVS_EventType_ERROR, 
+                            "Time-tagged %s action failed, pattern table not loaded", 
+                            TagActionStr(GpioCtrl->TagPool[Id].Action));
+         GpioCtrl->TagFailCnt++;
+      }
+      
+      GpioCtrl->TagFree[GpioCtrl->TagFreeCnt++] = Id;
+      __atomic_store_n(&GpioCtrl->TagDoneCnt, GpioCtrl->TagDoneCnt + 1, __ATOMIC_RELEASE);
+   
+   } /* End due tag loop */
+   
+} /* End RunTags() */
+
+
+/******************************************************************************
+** Function: SatUint32
+**
+*/
+static uint32 SatUint32(uint64 Value)
+{
+   
+   return (Value > UINT32_MAX) ? UINT32_MAX : (uint32)Value;
+   
+} /* End SatUint32() */
+
+
+/******************************************************************************
+** Function: TagActionStr
+**
+*/
+static const char* TagActionStr(uint8 Action)
+{
+   
+   const char* Str = "Unknown";
+   
+   if (Action == GPIO_DEMO_TagAction_SET_PINS)
+   {
+      Str = "SET_PINS";
+   }
+   else if (Action == GPIO_DEMO_TagAction_SET_TIMING)
+   {
+      Str = "SET_TIMING";
+   }
+   else if (Action == GPIO_DEMO_TagAction_START_PATTERN)
+   {
+      Str = "START_PATTERN";
+   }
+   
+   return Str;
+   
+} /* End TagActionStr() */
+
+
+/******************************************************************************
+** Function: WaitForEdge
+**
+** Wait until the edge at EdgeTime is due or the child task is woken.
+**
+** Notes:
+**   1. Returns true when the edge is due. The timeline has then been
+**      advanced to EdgeTime and IdealNs holds the edge's intended monotonic
+**      time. Returns false, without changing the timeline, when WakeSem was
+**      posted or a tag or the stats packet is due first. Only the posted
+**      wakeup is counted in WakeCnt.
+**   2. Relative mode waits for the timeline difference measured from the
+**      previous edge's wakeup so any wakeup latency is added to each period.
+**      Absolute mode waits until the edge's monotonic deadline and doesn't
+**      wait at all when it is already late, so an overrun is absorbed by
+**      the following periods.
+**   3. An absolute edge more than GPIO_CTRL_RESYNC_MS late re-anchors the
+**      deadline to the current time.
+**   4. DriftNs is measured the same way in both modes so they can be
+**      compared. A resync drops the current drift from the timeline so it
+**      is added to ResyncDriftNs, the accumulated drift is their sum.
+**
+*/
+static bool WaitForEdge(uint32 EdgeTime, uint64* IdealNs)
+{
+   
+   int32  Delta = (int32)(EdgeTime - GpioCtrl->Timeline);
+   uint64 Deadline;
+   uint64 Target;
+   uint64 Now;
+   uint8  Wait;
+   
+   if (Delta < 0)
+   {
+      Delta = 0;
+   }
+   Deadline = GpioCtrl->EdgeDeadline + (uint64)Delta * MONO_TIME_NS_PER_MS;
+   
+   if (GpioCtrl->TimingMode == GPIO_CTRL_TIMING_ABSOLUTE)
+   {
+      Target = Deadline;
+   }
+   else
+   {
+      Target = GpioCtrl->LastEdgeNs + (uint64)Delta * MONO_TIME_NS_PER_MS;
+   }
+   
+   Wait = WaitForWake(Target);
+   if (Wait != WAIT_DUE)
+   {
+      GpioCtrl->WakeCnt += (Wait == WAIT_WOKEN);
+      return false;
+   }
+   
+   GpioCtrl->Timeline     = EdgeTime;
+   GpioCtrl->EdgeDeadline = Deadline;
+   *IdealNs = Deadline;
+   
+   Now = MONO_TIME_GetNs();
+   GpioCtrl->LastEdgeNs = Now;
+   
+   if (Now > Target && (Now - Target) > GpioCtrl->MaxOverrunNs)
+   {
+      GpioCtrl->MaxOverrunNs = Now - Target;
+   }
+   GpioCtrl->DriftNs = (int64)(Now - GpioCtrl->EdgeDeadline);
+   
+   if (GpioCtrl->TimingMode == GPIO_CTRL_TIMING_ABSOLUTE &&
+       GpioCtrl->DriftNs > (int64)GPIO_CTRL_RESYNC_MS * (int64)MONO_TIME_NS_PER_MS)
+   {
+      GpioCtrl->ResyncDriftNs += GpioCtrl->DriftNs;
+      GpioCtrl->EdgeDeadline   = Now;
+      GpioCtrl->ResyncCnt++;
+   }
+   
+   return true;
+   
+} /* End WaitForEdge() */
+
+
+/******************************************************************************
+** Function: WaitForPwmEdge
+**
+** Wait until EdgeNs or until the child task is woken.
+**
+** Notes:
+**   1. Returns WaitForWake()'s result, WAIT_DUE once the edge is reached.
+**   2. The semaphore wait ends PwmSpinNs early and the rest of the time is
+**      busy-waited on the monotonic clock, which removes the scheduler's
+**      wakeup latency from the edge.
+**   3. Busy-waiting is limited to PwmSpinPct of each PWM_SPIN_WINDOW_NS.
+**      Once the budget is used the remaining edges of the window only sleep
+**      so high frequencies can't take the whole CPU.
+**   4. The spin's trace span reuses the loop's clock reads.
+**
+*/
+static uint8 WaitForPwmEdge(uint64 EdgeNs)
+{
+   
+   uint64 Now = MONO_TIME_GetNs();
+   uint64 SpinStart;
+   uint8  Wait;
+   
+   if (Now - GpioCtrl->PwmSpinWindowStart >= PWM_SPIN_WINDOW_NS)
+   {
+      GpioCtrl->PwmSpinWindowStart = Now;
+      GpioCtrl->PwmSpinWindowNs    = 0;
+   }
+   
+   if (GpioCtrl->PwmSpinNs == 0)
+   {
+      return WaitForWake(EdgeNs);
+   }
+   
+   if (GpioCtrl->PwmSpinWindowNs >= PWM_SPIN_WINDOW_NS * GpioCtrl->PwmSpinPct / 100)
+   {
+      GpioCtrl->PwmSpinSkipCnt++;
+      return WaitForWake(EdgeNs);
+   }
+   
+   if (EdgeNs > Now + GpioCtrl->PwmSpinNs)
+   {
+      Wait = WaitForWake(EdgeNs - GpioCtrl->PwmSpinNs);
+      if (Wait != WAIT_DUE)
+      {
+         return Wait;
+      }
+   }
+   
+   SpinStart = MONO_TIME_GetNs();
+   Now = SpinStart;
+   while (Now < EdgeNs)
+   {
+      Now = MONO_TIME_GetNs();
+   }
+   TRACE_LOG_Span(TRACE_LOG_CHILD, TRACE_LOG_SPIN, 0, SpinStart, Now);
+   GpioCtrl->PwmSpinWindowNs += Now - SpinStart;
+   GpioCtrl->PwmSpinTotalNs  += Now - SpinStart;
+   
+   return WAIT_DUE;
+   
+} /* End WaitForPwmEdge() */
+
+
+/******************************************************************************
+** Function: WaitForWake
+**
+** Wait for WakeSem until the monotonic clock reaches DeadlineNs
+**
+** Notes:
+**   1. Returns WAIT_WOKEN if WakeSem was posted before the deadline. Posts
+**      that arrived together are consumed as one wakeup.
+**   2. OSAL's counting semaphore timeout is relative and in milliseconds so
+**      the POSIX semaphore is used directly to keep nanosecond deadlines.
+**   3. While the GPIO is mapped the wait also ends at the earliest tag
+**      deadline or the next stats packet and returns WAIT_TASK_DUE so the
+**      caller returns to GPIO_CTRL_ChildTask() to run the tag or send the
+**      packet without counting a wakeup. UINT64_MAX waits only for a
+**      wakeup, a tag or a stats packet.
+**
+*/
+static uint8 WaitForWake(uint64 DeadlineNs)
+{
+   
+   struct timespec Deadline;
+   uint64 TagNs;
+   uint8  Result = WAIT_DUE;
+   int    Status;
+   
+   if (GpioCtrl->IsMapped && TIME_HEAP_Peek(&GpioCtrl->TagHeap, &TagNs) && TagNs < DeadlineNs)
+   {
+      DeadlineNs = TagNs;
+      Result     = WAIT_TASK_DUE;
+   }
+   if (GpioCtrl->IsMapped && GpioCtrl->StatsPeriodNs > 0 && GpioCtrl->StatsNextNs < DeadlineNs)
+   {
+      DeadlineNs = GpioCtrl->StatsNextNs;
+      Result     = WAIT_TASK_DUE;
+   }
+   Deadline = MONO_TIME_ToTimespec(DeadlineNs);
+   
+   TRACE_LOG_Begin(TRACE_LOG_CHILD, TRACE_LOG_SLEEP, 0);
+   do
+   {
+      Status = sem_clockwait(&GpioCtrl->WakeSem, CLOCK_MONOTONIC, &Deadline);
+   } while (Status != 0 && errno == EINTR);
+   TRACE_LOG_End(TRACE_LOG_CHILD, TRACE_LOG_SLEEP);
+   
+   if (Status == 0)
+   {
+      while (sem_trywait(&GpioCtrl->WakeSem) == 0);
+      Result = WAIT_WOKEN;
+   }
+   
+   return Result;
+   
+} /* End WaitForWake() */
+
+
+/******************************************************************************
+** Function: WakeChild
+**
+** Wake the child task so it re-evaluates its state before its deadline
+**
+** Notes:
+**   1. sem_post() doesn't block so this is safe from any task.
+**
+*/
+static void WakeChild(void)
+{
+   
+   sem_post(&GpioCtrl->WakeSem);
+   
+} /* End WakeChild() */
+
+
+/******************************************************************************
+** Function: WriteBank
+**
+** Notes:
+**   1. Each output that changed updates its channel's statistics with the
+**      time after the write, the loop only runs for changed pins and
+**      CHAN_STATS_Edge() has no branches.
+**   2. The write's trace span is recorded after the write from the
+**      driver's start time so tracing adds nothing before the edge.
+**
+*/
+static void WriteBank(uint64 SetMask, uint64 ClrMask)
+{
+   
+   uint64 Level;
+   uint64 Changed;
+   uint64 StartNs;
+   uint64 Now;
+   uint8  Pin;
+   
+   Level   = (GpioCtrl->OutLevel | SetMask) & ~ClrMask;
+   Changed = (Level ^ GpioCtrl->OutLevel) & GpioCtrl->PinMask;
+   
+   StartNs = GPIO_DRV_Write(SetMask, ClrMask);
+   Now = MONO_TIME_GetNs();
+   TRACE_LOG_Span(TRACE_LOG_CHILD, TRACE_LOG_EDGE_WRITE, __builtin_popcountll(Changed), StartNs, Now);
+   
+   GpioCtrl->OutLevel = Level;
+   GpioCtrl->BankWriteCnt++;
+   
+   while (Changed != 0)
+   {
+      Pin = __builtin_ctzll(Changed);
+      CHAN_STATS_Edge(&GpioCtrl->ChanStats, GpioCtrl->PinChan[Pin], (Level >> Pin) & 1, Now);
+      Changed &= Changed - 1;
+   }
+   
+} /* End WriteBank() */
 
@@ -16,7 +16,17 @@
 **    Define GPIO Controller class
 **
 **  Notes:
-**    TODO - Consider adding a map command if it fails during init. 
+**    1. The controller manages up to GPIO_CTRL_MAX_CHAN output channels.
+**       Each channel has its own on/off timing and all edges that fall due
+**       at the same time are written to the GPIO bank as a single set-mask
+**       and a single clear-mask register write.
+**    2. Blink edges are scheduled on a timer wheel so each edge costs the
+**       same no matter how many channels are configured.
+**    3. Time-tagged actions are queued by deadline in a min-heap owned by
+**       the child task and run on its timing path, not when the command
+**       happens to be dispatched.
+**    4. SEQUENCE mode runs the compiled sequence table program on the
+**       child task so scripted steps never wait on the software bus.
 **
 **  References:
 **    1. OpenSatKit Object-based Application Developer's Guide.
@@ -31,12 +41,44 @@
 ** Includes
 */
 
+#include <semaphore.h>
+
 #include "app_cfg.h"
+#include "chan_stats.h"
+#include "lat_hist.h"
+#include "gpio_drv.h"
+#include "pattern_tbl.h"
+#include "seq_tbl.h"
+#include "time_heap.h"
+#include "timer_wheel.h"
+#include "tlm_buf.h"
 
 /***********************/
 /** Macro Definitions **/
 /***********************/
 
+#define GPIO_CTRL_MAX_CHAN  32
+#define GPIO_CTRL_ALL_CHAN  0xFFFF   /* SetTiming command channel for all channels */
+
+#define GPIO_CTRL_TAG_QUEUE_LEN  1024   /* Queued time-tagged actions, must be a power of 2 */
+
+/*
+** Child task timing
+** - In absolute mode an edge more than GPIO_CTRL_RESYNC_MS late re-anchors
+**   the timeline instead of bursting out the missed edges
+** - CHILD_RT_CPU values of GPIO_CTRL_RT_CPU_ANY or greater leave the child
+**   task unpinned and a CHILD_RT_PRIORITY of 0 leaves its policy unchanged
+*/
+
+#define GPIO_CTRL_TIMING_RELATIVE  0
+#define GPIO_CTRL_TIMING_ABSOLUTE  1
+
+#define GPIO_CTRL_RESYNC_MS  1000
+#define GPIO_CTRL_RT_CPU_ANY  255
+
+#define GPIO_CTRL_RT_PINNED  0x01    /* RtStatus bits */
+#define GPIO_CTRL_RT_FIFO    0x02
+#define GPIO_CTRL_RT_LOCKED  0x04
 
 /*
 ** Event Message IDs
@@ -46,6 +88,16 @@
 #define GPIO_CTRL_SET_ON_TIME_EID  (GPIO_CTRL_BASE_EID + 1)
 #define GPIO_CTRL_SET_OFF_TIME_EID (GPIO_CTRL_BASE_EID + 2)
 #define GPIO_CTRL_CHILD_TASK_EID   (GPIO_CTRL_BASE_EID + 3)
+#define GPIO_CTRL_CONFIG_EID       (GPIO_CTRL_BASE_EID + 4)
+#define GPIO_CTRL_RT_CONFIG_EID    (GPIO_CTRL_BASE_EID + 5)
+#define GPIO_CTRL_SET_EDGE_EVENT_PERIOD_EID (GPIO_CTRL_BASE_EID + 6)
+#define GPIO_CTRL_SET_TIMING_EID   (GPIO_CTRL_BASE_EID + 7)
+#define GPIO_CTRL_REMAP_EID        (GPIO_CTRL_BASE_EID + 8)
+#define GPIO_CTRL_SET_MODE_EID     (GPIO_CTRL_BASE_EID + 9)
+#define GPIO_CTRL_SET_PWM_EID      (GPIO_CTRL_BASE_EID + 10)
+#define GPIO_CTRL_SCHEDULE_EID     (GPIO_CTRL_BASE_EID + 11)
+#define GPIO_CTRL_TAG_EXEC_EID     (GPIO_CTRL_BASE_EID + 12)
+#define GPIO_CTRL_SET_QUIET_CMDS_EID (GPIO_CTRL_BASE_EID + 13)
 
 /**********************/
 /** Type Definitions **/
@@ -84,6 +136,78 @@ typedef struct
 */
 
 
+/******************************************************************************
+** GPIO_CTRL_TimingCfg
+**
+** - Commanded channel timing. The controller keeps two buffers that are
+**   published with a sequence counter, see GPIO_CTRL_Class_t.
+*/
+
+typedef struct
+{
+
+   uint32  OnTime[GPIO_CTRL_MAX_CHAN];    /* Time in Milliseconds */
+   uint32  OffTime[GPIO_CTRL_MAX_CHAN];   /* Time in Milliseconds */
+   uint32  PwmFreq[GPIO_CTRL_MAX_CHAN];   /* Hz, 0 holds the pin low */
+   uint16  PwmDuty[GPIO_CTRL_MAX_CHAN];   /* 0.01% */
+   uint64  TimingCmdNs[GPIO_CTRL_MAX_CHAN];   /* Monotonic time of the last on/off time command */
+   
+} GPIO_CTRL_TimingCfg_t;
+
+
+/******************************************************************************
+** GPIO_CTRL_Tag
+**
+** - A time-tagged action, only the fields used by Action are defined
+*/
+
+typedef struct
+{
+
+   uint64  TimeNs;    /* CLOCK_MONOTONIC execution time */
+   uint8   Action;    /* GPIO_DEMO_TagAction */
+   uint16  Channel;
+   uint32  OnTime;
+   uint32  OffTime;
+   uint64  SetMask;
+   uint64  ClrMask;
+   
+} GPIO_CTRL_Tag_t;
+
+
+/******************************************************************************
+** GPIO_CTRL_Chan
+**
+** - NextEdge is on the controller's millisecond timeline so channels with
+**   different periods can be merged into common bank writes
+*/
+
+typedef struct
+{
+
+   uint8   Pin;
+   bool    On;
+   uint32  OnTime;    /* Applied time in Milliseconds */
+   uint32  OffTime;   /* Applied time in Milliseconds */ 
+   bool    Started;     /* First edge written */
+   uint32  NextEdge;    /* Controller timeline in milliseconds */
+   uint32  PhaseStart;  /* Timeline of the last edge */
+   
+   /* PWM mode, Ns times are CLOCK_MONOTONIC */
+   uint32  PwmPeriodNs;    /* 0 holds the pin low */
+   uint32  PwmHighNs;
+   bool    PwmHigh;        /* Pin is high */
+   bool    PwmAtStart;     /* Next edge starts a period */
+   uint16  PwmAchDuty;     /* Achieved duty over PWM_DUTY_WINDOW_NS, 0.01% */
+   uint64  PwmStartNs;     /* Intended start of the current period */
+   uint64  PwmNextNs;      /* Intended time of the next edge */
+   uint64  PwmHighSinceNs; /* Actual time of the last set */
+   uint64  PwmWindowNs;    /* Actual start of the achieved duty window */
+   uint64  PwmHighAccNs;   /* High time in the achieved duty window */
+   
+} GPIO_CTRL_Chan_t;
+
+
 /******************************************************************************
 ** GPIO_CTRL_Class
 */
@@ -102,16 +226,206 @@ typedef struct
    ** Class State Data
    */
 
+   uint32  RtCpu;
+   uint32  RtPriority;
+   bool    RtLockMem;
+   
    bool    IsMapped;
-   bool    LedOn;
-   uint8   OutPin;
-   uint32  OnTime;    /* Time in Milliseconds */
-   uint32  OffTime;   /* Time in Milliseconds */ 
+   bool    ChildStarted;
+   bool    StopRequested;
+   bool    ResetRequested;  /* Statistics reset applied by the child task */
+   uint32  ModeReq;       /* Commanded GPIO_DEMO_CtrlMode and request count, main task only */
+   uint32  ModeApplyReq;  /* ModeReq last seen by the child task */
+   uint8   ActiveMode;    /* Mode run by the child task */
+   uint8   TimingMode;
+   uint8   RtStatus;
+   uint16  ChanCnt;
+   uint16  ResyncCnt;
+   uint32  Timeline;      /* Milliseconds since the child task started */
+   uint32  BankWriteCnt;
+   uint64  EdgeDeadline;  /* Monotonic nanoseconds of the current edge */
+   int64   DriftNs;       /* Actual minus ideal time of the last edge */
+   int64   ResyncDriftNs; /* Sum of the drift dropped by resyncs */
+   uint64  MaxOverrunNs;  /* Worst wakeup past the requested time */
+   uint64  LastEdgeNs;    /* Monotonic nanoseconds of the last edge wakeup */
+   
+   sem_t   WakeSem;       /* Posted to wake the child task before its deadline */
+   uint32  WakeCnt;
+   
+   /*
+   ** GPIO map recovery
+   ** - The child task owns the driver after the constructor so all maps
+   **   after the first run on the child task and never race a bank write
+   ** - A failed map is retried after MapRetryMs, doubling from RemapMinMs
+   **   to RemapMaxMs. A Remap command retries immediately.
+   */
+   
+   uint32  RemapMinMs;
+   uint32  RemapMaxMs;
+   uint32  MapRetryMs;        /* Current backoff */
+   uint64  MapRetryNs;        /* Monotonic time of the next retry */
+   bool    RemapRequested;    /* Set by the Remap command */
+   uint16  MapAttemptCnt;     /* Maps run by the child task */
+   uint16  MapFailCnt;
+   
+   uint32  EdgeCnt;
+   uint32  LastEdgeTime;     /* Timeline of the last bank write */
+   uint64  OnTimeTotal;      /* Milliseconds summed over all channels */
+   
+   bool    QuietCmds;        /* Accepted timing and PWM commands don't send events */
+   uint32  EdgeEventPeriod;  /* Milliseconds, 0 disables edge events */
+   uint32  EdgeEventTime;    /* Timeline of the next allowed edge event */
+   uint32  EdgeEventCnt;     /* EdgeCnt at the last edge event */
+   uint64  PinMask;       /* All configured output pins */
+   uint64  OutLevel;      /* Last level written to the output pins */
+   
+   GPIO_DRV_Class_t GpioDrv;
+   
+   GPIO_CTRL_Chan_t Chan[GPIO_CTRL_MAX_CHAN];
    
    /*
-   ** Telemetry Packets
+   ** Blink edge scheduling
+   ** - Each channel's NextEdge is a timer on the millisecond timeline. The
+   **   child task sleeps until the wheel's next tick and every timer that
+   **   expires at that tick is written in one bank update.
    */
    
+   TIMER_WHEEL_Class_t EdgeWheel;
+   TIMER_WHEEL_Node_t  EdgeTimer[GPIO_CTRL_MAX_CHAN];
+   uint16              DueChan[GPIO_CTRL_MAX_CHAN];
+   
+   /*
+   ** Timing configuration handoff
+   ** - Commands (main task) write TimingCfg[(CfgSeq+1)&1], publish it by
+   **   incrementing CfgSeq and wake the child task. The child task copies
+   **   TimingCfg[CfgSeq&1] into ChildCfg between bank writes and retries if
+   **   CfgSeq changed during the copy so neither task ever waits on the
+   **   other.
+   ** - ChildCfg is applied to each channel's current phase so a new time
+   **   is measured from the channel's last edge
+   */
+   
+   uint32  CfgSeq;
+   uint32  CfgApplySeq;    /* CfgSeq of ChildCfg */
+   GPIO_CTRL_TimingCfg_t TimingCfg[2];
+   GPIO_CTRL_TimingCfg_t ChildCfg;
+   
+   /*
+   ** Time-tagged actions
+   ** - Commands post actions through TagRing, a single-producer/single-
+   **   consumer ring. The child task moves them into TagPool and orders
+   **   them by deadline in TagHeap so only the child task uses the heap.
+   ** - TagHead - TagDoneCnt is the number of queued actions. The command
+   **   limits it to GPIO_CTRL_TAG_QUEUE_LEN so neither the ring nor the
+   **   pool can overflow.
+   ** - A tagged timing change overrides a channel's on and off times until
+   **   a timing command that is received after the tag's deadline
+   */
+   
+   uint32  TagHead;        /* Written by the main task */
+   uint32  TagTail;        /* Child task */
+   uint32  TagDoneCnt;     /* Actions run or failed by the child task */
+   uint32  TagExecCnt;
+   uint16  TagFailCnt;
+   uint16  TagFreeCnt;
+   uint64  TagMaxLateNs;   /* Worst action time past its deadline */
+   
+   GPIO_CTRL_Tag_t    TagRing[GPIO_CTRL_TAG_QUEUE_LEN];
+   GPIO_CTRL_Tag_t    TagPool[GPIO_CTRL_TAG_QUEUE_LEN];
+   uint16             TagFree[GPIO_CTRL_TAG_QUEUE_LEN];
+   TIME_HEAP_Class_t  TagHeap;
+   TIME_HEAP_Node_t   TagNode[GPIO_CTRL_TAG_QUEUE_LEN];
+   
+   uint64  TagTimingNs[GPIO_CTRL_MAX_CHAN];   /* Deadline of the channel's timing override, 0 if none */
+   uint32  TagOnTime[GPIO_CTRL_MAX_CHAN];
+   uint32  TagOffTime[GPIO_CTRL_MAX_CHAN];
+   
+   LAT_HIST_Class_t EdgeHist;   /* Actual minus intended edge time */
+   
+   /*
+   ** Pattern mode
+   ** - Pattern is only used by the child task
+   */
+   
+   PATTERN_TBL_Class_t PatternTbl;
+   const PATTERN_TBL_Pattern_t* Pattern;
+   uint16  PatternStep;
+   uint64  PatternNextNs;    /* Monotonic time of the next step */
+   uint32  PatternCycleCnt;
+   
+   /*
+   ** Sequence mode
+   ** - Sequence is only used by the child task. SeqCounter[] holds the
+   **   remaining iterations of each compiled loop.
+   ** - Each op's execution time is added to its opcode's profile, the
+   **   main task only reads the profile.
+   */
+   
+   SEQ_TBL_Class_t SeqTbl;
+   const SEQ_TBL_Program_t* Sequence;
+   bool    SeqDone;        /* STOP reached */
+   uint16  SeqPc;          /* Next op */
+   uint64  SeqNextNs;      /* Monotonic time of the next op */
+   uint16  SeqCounter[SEQ_TBL_MAX_LOOPS];
+   uint32  SeqRunCnt;      /* Sequences that reached STOP */
+   uint32  SeqYieldCnt;    /* Passes that ran out of op budget */
+   uint32  SeqOpCnt[SEQ_TBL_OP_CNT];
+   uint64  SeqOpTotalNs[SEQ_TBL_OP_CNT];
+   uint32  SeqOpMaxNs[SEQ_TBL_OP_CNT];
+   
+   /*
+   ** PWM mode
+   ** - The child task sleeps until PwmSpinNs before an edge and then
+   **   busy-waits. Busy-waiting is limited to PwmSpinPct of the time and
+   **   edges over the budget only sleep.
+   */
+   
+   uint32  PwmMaxFreq;
+   uint32  PwmSpinNs;
+   uint32  PwmSpinPct;
+   uint64  PwmSpinWindowStart;
+   uint64  PwmSpinWindowNs;    /* Busy-wait time in the current window */
+   uint64  PwmSpinTotalNs;
+   uint32  PwmSpinSkipCnt;     /* Edges that didn't busy-wait because of the budget */
+   uint32  PwmPeriodSkipCnt;   /* Periods skipped because an edge was a full period late */
+   uint32  PwmEdgeCnt;
+   
+   /*
+   ** Controller statistics
+   ** - Only written by the child task. ChanStats holds each statistic as
+   **   an array indexed by channel, the same layout as the stats packet,
+   **   so the packet is built with one linear pass per field.
+   ** - The child task sends the packet every StatsPeriodNs on its own
+   **   timeline, WaitForWake() ends at StatsNextNs like a tag deadline
+   */
+   
+   uint32  StatsPeriodNs;   /* 0 disables the stats packet */
+   uint64  StatsNextNs;
+   uint64  StatsWindowNs;   /* Start of the current duty window */
+   uint8   PinChan[GPIO_DRV_MAX_PIN+1];   /* Output pin's channel */
+   uint64  StatsHighNs[GPIO_CTRL_MAX_CHAN];   /* Cumulative high time at the window start */
+   CHAN_STATS_Class_t ChanStats;
+   
+   /*
+   ** Telemetry Packets, filled in TLM_BUF buffers
+   ** - The *Sent fields hold the values the HK request packets were last
+   **   sent with. A send with OnlyIfChanged skips a packet that matches.
+   */
+   
+   CFE_SB_MsgId_t  EdgeHistTlmMid;
+   CFE_SB_MsgId_t  PwmTlmMid;
+   CFE_SB_MsgId_t  SeqTlmMid;
+   CFE_SB_MsgId_t  CtrlStatsTlmMid;
+   
+   uint32  EdgeHistSentCnt;     /* Histogram SampleCnt */
+   uint32  PwmSentCfgSeq;
+   uint32  PwmSentEdgeCnt;
+   uint32  PwmSentSpinSkipCnt;
+   uint32  PwmSentPeriodSkipCnt;
+   uint8   SeqSentState;
+   uint8   SeqSentLoadStatus;
+   uint16  SeqSentLoadCnt;
+   uint32  SeqSentRunCnt;
    
 } GPIO_CTRL_Class_t;
 
@@ -129,18 +443,68 @@ typedef struct
 **
 ** Notes:
 **   1. This must be called prior to any other function.
+**   2. Returns false if the output pin list or the default on/off times
+**      are invalid.
 **
 */
-void GPIO_CTRL_Constructor(GPIO_CTRL_Class_t *GpioCtrlPtr, INITBL_Class_t* IniTbl);
+bool GPIO_CTRL_Constructor(GPIO_CTRL_Class_t *GpioCtrlPtr, INITBL_Class_t* IniTbl);
 
 
 /******************************************************************************
 ** Function: GPIO_CTRL_ChildTask
 **
+** Notes:
+**   1. Each call waits for the earliest channel edge and writes every edge
+**      due at that time in one bank update.
+**   2. The first call applies the optional real-time configuration and
+**      anchors the timeline to the monotonic clock.
+**   3. Returns false after GPIO_CTRL_Stop() to end the child task.
+**
 */
 bool GPIO_CTRL_ChildTask(CHILDMGR_Class_t* ChildMgr);
 
 
+/******************************************************************************
+** Function: GPIO_CTRL_LoadPatternTbl
+**
+** Load a pattern table and wake the child task
+**
+** Notes:
+**   1. Function signature must match TBLMGR_LoadTblFuncPtr_t.
+**   2. In pattern mode the new pattern starts immediately from its first
+**      step.
+**
+*/
+bool GPIO_CTRL_LoadPatternTbl(TBLMGR_Tbl_t* Tbl, uint8 LoadType, const char* Filename);
+
+
+/******************************************************************************
+** Function: GPIO_CTRL_LoadSeqTbl
+**
+** Load a sequence table and wake the child task
+**
+** Notes:
+**   1. Function signature must match TBLMGR_LoadTblFuncPtr_t.
+**   2. In sequence mode the new sequence starts immediately from its first
+**      op.
+**
+*/
+bool GPIO_CTRL_LoadSeqTbl(TBLMGR_Tbl_t* Tbl, uint8 LoadType, const char* Filename);
+
+
+/******************************************************************************
+** Function: GPIO_CTRL_RemapCmd
+**
+** Map the GPIO backend again and configure the output pins
+**
+** Notes:
+**   1. The remap is performed by the child task. Its result is reported
+**      in an event message.
+**
+*/
+bool GPIO_CTRL_RemapCmd(void* DataObjPtr, const CFE_MSG_Message_t *MsgPtr);
+
+
 /******************************************************************************
 ** Function: GPIO_CTRL_ResetStatus
 **
@@ -149,14 +513,110 @@ bool GPIO_CTRL_ChildTask(CHILDMGR_Class_t* ChildMgr);
 ** Notes:
 **   1. Any counter or variable that is reported in HK telemetry that doesn't
 **      change the functional behavior should be reset.
+**   2. The statistics updated by the child task are reset by the child
+**      task at its next wakeup so they're never written by two tasks.
 **
 */
 void GPIO_CTRL_ResetStatus(void);
 
 
+/******************************************************************************
+** Function: GPIO_CTRL_Stop
+**
+** Request the child task to exit and wake it
+**
+*/
+void GPIO_CTRL_Stop(void);
+
+
+/******************************************************************************
+** Function: GPIO_CTRL_ScheduleActionCmd
+**
+** Queue an action to run at a future time
+**
+** Notes:
+**   1. The action is validated when it is queued. A pattern that is
+**      unloaded before the deadline fails when the action runs.
+**   2. Actions are run in time order by the child task while the GPIO is
+**      mapped, actions that fall due while it is unmapped run late after
+**      the next successful map.
+**
+*/
+bool GPIO_CTRL_ScheduleActionCmd(void* DataObjPtr, const CFE_MSG_Message_t *MsgPtr);
+
+
+/******************************************************************************
+** Function: GPIO_CTRL_SendEdgeHistTlm
+**
+** Send the edge timing error histogram telemetry packet
+**
+** Notes:
+**   1. With OnlyIfChanged the packet isn't sent if no edge was added to
+**      the histogram since the last one. Returns true if it was sent.
+**
+*/
+bool GPIO_CTRL_SendEdgeHistTlm(bool OnlyIfChanged);
+
+
+/******************************************************************************
+** Function: GPIO_CTRL_SendPwmTlm
+**
+** Send the PWM requested and achieved duty telemetry packet
+**
+** Notes:
+**   1. With OnlyIfChanged the packet isn't sent if no PWM edge, skip or
+**      timing configuration change happened since the last one. Returns
+**      true if it was sent.
+**
+*/
+bool GPIO_CTRL_SendPwmTlm(bool OnlyIfChanged);
+
+
+/******************************************************************************
+** Function: GPIO_CTRL_SendSeqTlm
+**
+** Send the sequence state and per-opcode execution time telemetry packet
+**
+** Notes:
+**   1. With OnlyIfChanged the packet isn't sent if the sequence state,
+**      run count and table load status match the last one. Returns true if
+**      it was sent.
+**
+*/
+bool GPIO_CTRL_SendSeqTlm(bool OnlyIfChanged);
+
+
+/******************************************************************************
+** Function: GPIO_CTRL_SetEdgeEventPeriodCmd
+**
+** Notes:
+**   1. A period of 0 disables the edge debug events.
+**
+*/
+bool GPIO_CTRL_SetEdgeEventPeriodCmd(void* DataObjPtr, const CFE_MSG_Message_t *MsgPtr);
+
+
+/******************************************************************************
+** Function: GPIO_CTRL_SetModeCmd
+**
+** Select how the child task drives the output pins
+**
+** Notes:
+**   1. PATTERN and SEQUENCE modes require a loaded pattern or sequence
+**      table.
+**   2. Entering PATTERN or SEQUENCE mode clears all output pins and
+**      returning to BLINK mode restores each channel's level.
+**
+*/
+bool GPIO_CTRL_SetModeCmd(void* DataObjPtr, const CFE_MSG_Message_t *MsgPtr);
+
+
 /******************************************************************************
 ** Function: GPIO_CTRL_SetOffTimeCmd
 **
+** Notes:
+**   1. The off time is applied to the current phase of all channels.
+**
 */
 bool GPIO_CTRL_SetOffTimeCmd(void* DataObjPtr, const CFE_MSG_Message_t *MsgPtr);
 
@@ -164,8 +624,62 @@ bool GPIO_CTRL_SetOffTimeCmd(void* DataObjPtr, const CFE_MSG_Message_t *MsgPtr);
 /******************************************************************************
 ** Function: GPIO_CTRL_SetOnTimeCmd
 **
+** Notes:
+**   1. The on time is applied to the current phase of all channels.
+**
 */
 bool GPIO_CTRL_SetOnTimeCmd(void* DataObjPtr, const CFE_MSG_Message_t *MsgPtr);
 
 
+/******************************************************************************
+** Function: GPIO_CTRL_SetPwmDutyCmd
+**
+** Set the PWM duty cycle of one or all channels
+**
+** Notes:
+**   1. Duty is in 0.01% units, 0 holds the pin low and 10000 high.
+**   2. The new high time starts with the channel's current period.
+**
+*/
+bool GPIO_CTRL_SetPwmDutyCmd(void* DataObjPtr, const CFE_MSG_Message_t *MsgPtr);
+
+
+/******************************************************************************
+** Function: GPIO_CTRL_SetPwmFreqCmd
+**
+** Set the PWM frequency of one or all channels
+**
+** Notes:
+**   1. Frequencies above CTRL_PWM_MAX_FREQ are rejected. 0 disables the
+**      channel's PWM output and holds the pin low.
+**
+*/
+bool GPIO_CTRL_SetPwmFreqCmd(void* DataObjPtr, const CFE_MSG_Message_t *MsgPtr);
+
+
+/******************************************************************************
+** Function: GPIO_CTRL_SetQuietCmdsCmd
+**
+** Set whether accepted timing and PWM commands send an information event
+**
+** Notes:
+**   1. Overrides CTRL_QUIET_CMDS. Rejected commands always send an error
+**      event.
+**
+*/
+bool GPIO_CTRL_SetQuietCmdsCmd(void* DataObjPtr, const CFE_MSG_Message_t *MsgPtr);
+
+
+/******************************************************************************
+** Function: GPIO_CTRL_SetTimingCmd
+**
+** Set the on and off time of one or all channels as a single update
+**
+** Notes:
+**   1. Both times take effect together in the channel's current phase.
+**
+*/
+bool GPIO_CTRL_SetTimingCmd(void* DataObjPtr, const CFE_MSG_Message_t *MsgPtr);
+
+
 #endif /* _gpio_ctrl_ */
@@ -40,7 +40,14 @@
 #define  INITBL_OBJ    (&(GpioDemo.IniTbl))
 #define  CMDMGR_OBJ    (&(GpioDemo.CmdMgr))
 #define  CHILDMGR_OBJ  (&(GpioDemo.ChildMgr))
+#define  CAP_CHILDMGR_OBJ (&(GpioDemo.CapChildMgr))
+#define  LOGIC_CHILDMGR_OBJ (&(GpioDemo.LogicChildMgr))
+#define  TBLMGR_OBJ    (&(GpioDemo.TblMgr))
 #define  GPIO_CTRL_OBJ (&(GpioDemo.GpioCtrl))
+#define  INPUT_CAP_OBJ (&(GpioDemo.InputCap))
+#define  LOGIC_CAP_OBJ (&(GpioDemo.LogicCap))
+#define  TLM_BUF_OBJ   (&(GpioDemo.TlmBuf))
+#define  TRACE_LOG_OBJ (&(GpioDemo.TraceLog))
 
 
 /*******************************/
@@ -49,7 +56,12 @@
 
 static int32 InitApp(void);
 static int32 ProcessCommands(void);
-static void SendHousekeepingPkt(void);
+static void ProcessMsg(const CFE_SB_Buffer_t* SbBufPtr);
+static void CheckSeqCnt(const CFE_MSG_Message_t* MsgPtr, uint16* SeqCnt);
+static bool HkChanged(const GPIO_DEMO_HkTlm_Payload_t* HkTlmPayload);
+static void InitHkPolicy(void);
+static void SendCtrlTlm(bool HkSent);
+static bool SendHousekeepingPkt(void);
 
 
 /**********************/
@@ -103,6 +115,10 @@ void GPIO_DEMO_AppMain(void)
 
    CFE_EVS_SendEvent(GPIO_DEMO_EXIT_EID, CFE_EVS_EventType_CRITICAL, "GPIO_DEMO App terminating, err = 0x%08X", RunStatus);
 
+   GPIO_CTRL_Stop();
+   INPUT_CAP_Stop();
+   LOGIC_CAP_Stop();
+
    CFE_ES_ExitApp(RunStatus);  /* Let cFE kill the task (and any child tasks) */
 
 } /* End of GPIO_DEMO_AppMain() */
@@ -140,8 +156,20 @@ bool GPIO_DEMO_ResetAppCmd(void* ObjDataPtr, const CFE_MSG_Message_t *MsgPtr)
 
    CMDMGR_ResetStatus(CMDMGR_OBJ);
    CHILDMGR_ResetStatus(CHILDMGR_OBJ);
+   if (GpioDemo.CapEnabled)
+   {
+      CHILDMGR_ResetStatus(CAP_CHILDMGR_OBJ);
+   }
+   CHILDMGR_ResetStatus(LOGIC_CHILDMGR_OBJ);
+   
+   GpioDemo.CmdBatchHighWater = 0;
+   GpioDemo.CmdBatchLimitCnt = 0;
+   GpioDemo.CmdDropCnt       = 0;
+   GpioDemo.HkSkipCnt        = 0;
    
    GPIO_CTRL_ResetStatus();
+   INPUT_CAP_ResetStatus();
+   TLM_BUF_ResetStatus();
 	  
    return true;
 
@@ -156,6 +184,8 @@ static int32 InitApp(void)
 {
 
    int32 Status = OSK_C_FW_CFS_ERROR;
+   bool  CtrlValid;
+   uint32 BatchLimit;
    
    CHILDMGR_TaskInit_t ChildTaskInit;
    
@@ -169,26 +199,74 @@ static int32 InitApp(void)
       GpioDemo.PerfId    = INITBL_GetIntConfig(INITBL_OBJ, CFG_APP_PERF_ID);
       GpioDemo.CmdMid    = CFE_SB_ValueToMsgId(INITBL_GetIntConfig(INITBL_OBJ, CFG_GPIO_DEMO_CMD_TOPICID));
       GpioDemo.SendHkMid = CFE_SB_ValueToMsgId(INITBL_GetIntConfig(INITBL_OBJ, CFG_GPIO_DEMO_SEND_HK_TOPICID));
+      BatchLimit = INITBL_GetIntConfig(INITBL_OBJ, CFG_CMD_BATCH_LIMIT);
+      if (BatchLimit == 0 || BatchLimit > UINT16_MAX)
+      {
+         CFE_EVS_SendEvent(GPIO_DEMO_INIT_APP_EID, CFE_EVS_EventType_ERROR,
+                           "Invalid APP_CMD_BATCH_LIMIT %u, must be in [1, %u]. Using %u",
+                           (unsigned int)BatchLimit, (unsigned int)UINT16_MAX,
+                           (unsigned int)((BatchLimit == 0) ? 1 : UINT16_MAX));
+         BatchLimit = (BatchLimit == 0) ? 1 : UINT16_MAX;
+      }
+      GpioDemo.CmdBatchLimit = (uint16)BatchLimit;
       
       CFE_ES_PerfLogEntry(GpioDemo.PerfId);
 
-      /* Constructor sends error events */    
-      ChildTaskInit.TaskName  = INITBL_GetStrConfig(INITBL_OBJ, CFG_CHILD_NAME);
-      ChildTaskInit.PerfId    = INITBL_GetIntConfig(INITBL_OBJ, CHILD_PERF_ID);
-      ChildTaskInit.StackSize = INITBL_GetIntConfig(INITBL_OBJ, CFG_CHILD_STACK_SIZE);
-      ChildTaskInit.Priority  = INITBL_GetIntConfig(INITBL_OBJ, CFG_CHILD_PRIORITY);
-      Status = CHILDMGR_Constructor(CHILDMGR_OBJ, 
-                                    ChildMgr_TaskMainCallback,
-                                    GPIO_CTRL_ChildTask, 
-                                    &ChildTaskInit); 
+      TLM_BUF_Constructor(TLM_BUF_OBJ, INITBL_GetIntConfig(INITBL_OBJ, CFG_TLM_ZERO_COPY));
+      
+      /* Must be constructed before the child tasks start running them */
+      TRACE_LOG_Constructor(TRACE_LOG_OBJ, &GpioDemo.IniTbl);
+      CtrlValid = GPIO_CTRL_Constructor(GPIO_CTRL_OBJ, &GpioDemo.IniTbl);
+      GpioDemo.CapEnabled = INPUT_CAP_Constructor(INPUT_CAP_OBJ, &GpioDemo.IniTbl, GpioDemo.GpioCtrl.PinMask);
+      GpioDemo.CapDrainMs = INITBL_GetIntConfig(INITBL_OBJ, CFG_CAP_DRAIN_MS);
+      if (GpioDemo.CapDrainMs == 0)
+      {
+         GpioDemo.CapDrainMs = 1;
+      }
+      LOGIC_CAP_Constructor(LOGIC_CAP_OBJ, &GpioDemo.IniTbl);
+
+      /* Constructors send error events */    
+      if (CtrlValid)
+      {
+         ChildTaskInit.TaskName  = INITBL_GetStrConfig(INITBL_OBJ, CFG_CHILD_NAME);
+         ChildTaskInit.PerfId    = INITBL_GetIntConfig(INITBL_OBJ, CHILD_PERF_ID);
+         ChildTaskInit.StackSize = INITBL_GetIntConfig(INITBL_OBJ, CFG_CHILD_STACK_SIZE);
+         ChildTaskInit.Priority  = INITBL_GetIntConfig(INITBL_OBJ, CFG_CHILD_PRIORITY);
+         Status = CHILDMGR_Constructor(CHILDMGR_OBJ, 
+                                       ChildMgr_TaskMainCallback,
+                                       GPIO_CTRL_ChildTask, 
+                                       &ChildTaskInit); 
+      }
+      
+      if (Status == CFE_SUCCESS && GpioDemo.CapEnabled)
+      {
+         ChildTaskInit.TaskName  = INITBL_GetStrConfig(INITBL_OBJ, CFG_CAP_CHILD_NAME);
+         ChildTaskInit.PerfId    = INITBL_GetIntConfig(INITBL_OBJ, CFG_CAP_CHILD_PERF_ID);
+         ChildTaskInit.StackSize = INITBL_GetIntConfig(INITBL_OBJ, CFG_CAP_CHILD_STACK_SIZE);
+         ChildTaskInit.Priority  = INITBL_GetIntConfig(INITBL_OBJ, CFG_CAP_CHILD_PRIORITY);
+         Status = CHILDMGR_Constructor(CAP_CHILDMGR_OBJ, 
+                                       ChildMgr_TaskMainCallback,
+                                       INPUT_CAP_SamplerTask, 
+                                       &ChildTaskInit); 
+      }
+      
+      if (Status == CFE_SUCCESS)
+      {
+         ChildTaskInit.TaskName  = INITBL_GetStrConfig(INITBL_OBJ, CFG_LOGIC_CHILD_NAME);
+         ChildTaskInit.PerfId    = INITBL_GetIntConfig(INITBL_OBJ, CFG_LOGIC_CHILD_PERF_ID);
+         ChildTaskInit.StackSize = INITBL_GetIntConfig(INITBL_OBJ, CFG_LOGIC_CHILD_STACK_SIZE);
+         ChildTaskInit.Priority  = INITBL_GetIntConfig(INITBL_OBJ, CFG_LOGIC_CHILD_PRIORITY);
+         Status = CHILDMGR_Constructor(LOGIC_CHILDMGR_OBJ, 
+                                       ChildMgr_TaskMainCallback,
+                                       LOGIC_CAP_ChildTask, 
+                                       &ChildTaskInit); 
+      }
   
    } /* End if INITBL Constructed */
   
    if (Status == CFE_SUCCESS)
    {
 
-      GPIO_CTRL_Constructor(GPIO_CTRL_OBJ, &GpioDemo.IniTbl);
-
       /*
       ** Initialize app level interfaces
       */
@@ -203,8 +281,30 @@ static int32 InitApp(void)
 
       CMDMGR_RegisterFunc(CMDMGR_OBJ, GPIO_DEMO_SET_ON_TIME_CC,  GPIO_CTRL_OBJ, GPIO_CTRL_SetOnTimeCmd,  sizeof(GPIO_DEMO_SetOnTime_Payload_t));
       CMDMGR_RegisterFunc(CMDMGR_OBJ, GPIO_DEMO_SET_OFF_TIME_CC, GPIO_CTRL_OBJ, GPIO_CTRL_SetOffTimeCmd, sizeof(GPIO_DEMO_SetOffTime_Payload_t));
+      CMDMGR_RegisterFunc(CMDMGR_OBJ, GPIO_DEMO_SET_TIMING_CC,   GPIO_CTRL_OBJ, GPIO_CTRL_SetTimingCmd,  sizeof(GPIO_DEMO_SetTiming_Payload_t));
+      CMDMGR_RegisterFunc(CMDMGR_OBJ, GPIO_DEMO_SET_EDGE_EVENT_PERIOD_CC, GPIO_CTRL_OBJ, GPIO_CTRL_SetEdgeEventPeriodCmd, sizeof(GPIO_DEMO_SetEdgeEventPeriod_Payload_t));
+      CMDMGR_RegisterFunc(CMDMGR_OBJ, GPIO_DEMO_REMAP_CC,        GPIO_CTRL_OBJ, GPIO_CTRL_RemapCmd,      0);
+      CMDMGR_RegisterFunc(CMDMGR_OBJ, GPIO_DEMO_SET_MODE_CC,     GPIO_CTRL_OBJ, GPIO_CTRL_SetModeCmd,    sizeof(GPIO_DEMO_SetMode_Payload_t));
+      CMDMGR_RegisterFunc(CMDMGR_OBJ, GPIO_DEMO_SET_PWM_FREQ_CC, GPIO_CTRL_OBJ, GPIO_CTRL_SetPwmFreqCmd, sizeof(GPIO_DEMO_SetPwmFreq_Payload_t));
+      CMDMGR_RegisterFunc(CMDMGR_OBJ, GPIO_DEMO_SET_PWM_DUTY_CC, GPIO_CTRL_OBJ, GPIO_CTRL_SetPwmDutyCmd, sizeof(GPIO_DEMO_SetPwmDuty_Payload_t));
+      CMDMGR_RegisterFunc(CMDMGR_OBJ, GPIO_DEMO_SET_QUIET_CMDS_CC, GPIO_CTRL_OBJ, GPIO_CTRL_SetQuietCmdsCmd, sizeof(GPIO_DEMO_SetQuietCmds_Payload_t));
+      CMDMGR_RegisterFunc(CMDMGR_OBJ, GPIO_DEMO_SCHEDULE_ACTION_CC, GPIO_CTRL_OBJ, GPIO_CTRL_ScheduleActionCmd, sizeof(GPIO_DEMO_ScheduleAction_Payload_t));
+      CMDMGR_RegisterFunc(CMDMGR_OBJ, GPIO_DEMO_START_LOGIC_CAP_CC, LOGIC_CAP_OBJ, LOGIC_CAP_StartCmd, sizeof(GPIO_DEMO_StartLogicCap_Payload_t));
+      CMDMGR_RegisterFunc(CMDMGR_OBJ, GPIO_DEMO_STOP_LOGIC_CAP_CC,  LOGIC_CAP_OBJ, LOGIC_CAP_StopCmd,  0);
+      CMDMGR_RegisterFunc(CMDMGR_OBJ, GPIO_DEMO_DUMP_LOGIC_CAP_CC,  LOGIC_CAP_OBJ, LOGIC_CAP_DumpCmd,  sizeof(GPIO_DEMO_DumpLogicCap_Payload_t));
+      CMDMGR_RegisterFunc(CMDMGR_OBJ, GPIO_DEMO_DUMP_TRACE_CC, TRACE_LOG_OBJ, TRACE_LOG_DumpCmd, sizeof(GPIO_DEMO_DumpTrace_Payload_t));
+
+      CMDMGR_RegisterFunc(CMDMGR_OBJ, GPIO_DEMO_TBL_LOAD_CMD_FC, TBLMGR_OBJ, TBLMGR_LoadTblCmd, sizeof(OSK_C_FW_LoadTbl_Payload_t));
+      CMDMGR_RegisterFunc(CMDMGR_OBJ, GPIO_DEMO_TBL_DUMP_CMD_FC, TBLMGR_OBJ, TBLMGR_DumpTblCmd, sizeof(OSK_C_FW_DumpTbl_Payload_t));
+
+      TBLMGR_Constructor(TBLMGR_OBJ);
+      TBLMGR_RegisterTblWithDef(TBLMGR_OBJ, GPIO_CTRL_LoadPatternTbl, PATTERN_TBL_DumpCmd, 
+                                INITBL_GetStrConfig(INITBL_OBJ, CFG_PATTERN_TBL_FILE));
+      TBLMGR_RegisterTblWithDef(TBLMGR_OBJ, GPIO_CTRL_LoadSeqTbl, SEQ_TBL_DumpCmd, 
+                                INITBL_GetStrConfig(INITBL_OBJ, CFG_SEQ_TBL_FILE));
       
-      CFE_MSG_Init(CFE_MSG_PTR(GpioDemo.HkTlm.TelemetryHeader), CFE_SB_ValueToMsgId(INITBL_GetIntConfig(INITBL_OBJ, CFG_GPIO_DEMO_HK_TLM_TOPICID)), sizeof(GPIO_DEMO_HkTlm_t));
+      GpioDemo.HkTlmMid = CFE_SB_ValueToMsgId(INITBL_GetIntConfig(INITBL_OBJ, CFG_GPIO_DEMO_HK_TLM_TOPICID));
+      InitHkPolicy();
    
       /*
       ** Application startup event message
@@ -223,97 +323,462 @@ static int32 InitApp(void)
 /******************************************************************************
 ** Function: ProcessCommands
 **
+** Notes:
+**   1. Pends for the first message and then polls for up to CmdBatchLimit-1
+**      more so a burst is drained with one wakeup. A limit of 1 processes a
+**      single message per call.
+**   2. With input capture enabled the pend times out after CapDrainMs and
+**      the capture ring is drained after every wakeup so edge telemetry
+**      isn't held up by a quiet command pipe.
+**
 */
 static int32 ProcessCommands(void)
 {
 
    int32  RetStatus = CFE_ES_RunStatus_APP_RUN;
    int32  SysStatus;
+   int32  Timeout = GpioDemo.CapEnabled ? (int32)GpioDemo.CapDrainMs : CFE_SB_PEND_FOREVER;
+   uint16 BatchCnt = 0;
 
    CFE_SB_Buffer_t* SbBufPtr;
-   CFE_SB_MsgId_t   MsgId = CFE_SB_INVALID_MSG_ID;
    
 
    CFE_ES_PerfLogExit(GpioDemo.PerfId);
-   SysStatus = CFE_SB_ReceiveBuffer(&SbBufPtr, GpioDemo.CmdPipe, CFE_SB_PEND_FOREVER);
+   TRACE_LOG_Begin(TRACE_LOG_MAIN, TRACE_LOG_SB_RECEIVE, (uint32)Timeout);
+   SysStatus = CFE_SB_ReceiveBuffer(&SbBufPtr, GpioDemo.CmdPipe, Timeout);
+   TRACE_LOG_End(TRACE_LOG_MAIN, TRACE_LOG_SB_RECEIVE);
    CFE_ES_PerfLogEntry(GpioDemo.PerfId);
 
-   if (SysStatus == CFE_SUCCESS)
+   while (SysStatus == CFE_SUCCESS)
    {
       
-      SysStatus = CFE_MSG_GetMsgId(&SbBufPtr->Msg, &MsgId);
-   
-      if (SysStatus == CFE_SUCCESS)
+      ProcessMsg(SbBufPtr);
+      
+      if (++BatchCnt >= GpioDemo.CmdBatchLimit)
       {
+         GpioDemo.CmdBatchLimitCnt++;
+         break;
+      }
+      
+      TRACE_LOG_Begin(TRACE_LOG_MAIN, TRACE_LOG_SB_RECEIVE, (uint32)CFE_SB_POLL);
+      SysStatus = CFE_SB_ReceiveBuffer(&SbBufPtr, GpioDemo.CmdPipe, CFE_SB_POLL);
+      TRACE_LOG_End(TRACE_LOG_MAIN, TRACE_LOG_SB_RECEIVE);
+      
+   } /* End batch loop */
+   
+   if (BatchCnt > GpioDemo.CmdBatchHighWater)
+   {
+      GpioDemo.CmdBatchHighWater = BatchCnt;
+   }
+   
+   if (GpioDemo.CapEnabled)
+   {
+      INPUT_CAP_SendEdgeTlm();
+   }
+   
+   if (SysStatus != CFE_SUCCESS && SysStatus != CFE_SB_NO_MESSAGE && SysStatus != CFE_SB_TIME_OUT) 
+   {
+   
+         CFE_ES_WriteToSysLog("GPIO_DEMO software bus error. Status = 0x%08X\n", SysStatus);   /* Use SysLog, events may not be working */
+         RetStatus = CFE_ES_RunStatus_APP_ERROR;
+   }  
+      
+   return RetStatus;
+
+} /* End ProcessCommands() */
+
+
+/******************************************************************************
+** Function: ProcessMsg
+**
+*/
+static void ProcessMsg(const CFE_SB_Buffer_t* SbBufPtr)
+{
+
+   int32  SysStatus;
+   CFE_SB_MsgId_t   MsgId = CFE_SB_INVALID_MSG_ID;
+   CFE_MSG_FcnCode_t FcnCode = 0;
+   
+   SysStatus = CFE_MSG_GetMsgId(&SbBufPtr->Msg, &MsgId);
+
+   if (SysStatus == CFE_SUCCESS)
+   {
   
-         if (CFE_SB_MsgId_Equal(MsgId, GpioDemo.CmdMid)) 
-         {
-            
-            CMDMGR_DispatchFunc(CMDMGR_OBJ, &SbBufPtr->Msg);
+      if (CFE_SB_MsgId_Equal(MsgId, GpioDemo.CmdMid)) 
+      {
          
-         } 
-         else if (CFE_SB_MsgId_Equal(MsgId, GpioDemo.SendHkMid))
-         {
-
-            SendHousekeepingPkt();
-            
-         }
-         else
-         {
-            
-            CFE_EVS_SendEvent(GPIO_DEMO_INVALID_MID_EID, CFE_EVS_EventType_ERROR,
-                              "Received invalid command packet, MID = 0x%08X",
-                              CFE_SB_MsgIdToValue(MsgId));
-         } 
+         CheckSeqCnt(&SbBufPtr->Msg, &GpioDemo.CmdSeqCnt);
+         CFE_MSG_GetFcnCode(&SbBufPtr->Msg, &FcnCode);
+         TRACE_LOG_Begin(TRACE_LOG_MAIN, TRACE_LOG_DISPATCH, FcnCode);
+         CMDMGR_DispatchFunc(CMDMGR_OBJ, &SbBufPtr->Msg);
+         TRACE_LOG_End(TRACE_LOG_MAIN, TRACE_LOG_DISPATCH);
+      
+      } 
+      else if (CFE_SB_MsgId_Equal(MsgId, GpioDemo.SendHkMid))
+      {
 
+         CheckSeqCnt(&SbBufPtr->Msg, &GpioDemo.SendHkSeqCnt);
+         TRACE_LOG_Begin(TRACE_LOG_MAIN, TRACE_LOG_HK_BUILD, 0);
+         SendCtrlTlm(SendHousekeepingPkt());
+         TRACE_LOG_End(TRACE_LOG_MAIN, TRACE_LOG_HK_BUILD);
+         
       }
       else
       {
          
          CFE_EVS_SendEvent(GPIO_DEMO_INVALID_MID_EID, CFE_EVS_EventType_ERROR,
-                           "CFE couldn't retrieve message ID from the message, Status = %d", SysStatus);
-      }
+                           "Received invalid command packet, MID = 0x%08X",
+                           CFE_SB_MsgIdToValue(MsgId));
+      } 
+
+   }
+   else
+   {
       
-   } /* Valid SB receive */ 
-   else 
+      CFE_EVS_SendEvent(GPIO_DEMO_INVALID_MID_EID, CFE_EVS_EventType_ERROR,
+                        "CFE couldn't retrieve message ID from the message, Status = %d", SysStatus);
+   }
+   
+} /* End ProcessMsg() */
+
+
+/******************************************************************************
+** Function: CheckSeqCnt
+**
+** Count the messages that were dropped before reaching the pipe.
+**
+** Notes:
+**   1. The pipe doesn't report overflows to its owner so drops are inferred
+**      from gaps in each message ID's 14-bit CCSDS sequence count. Sources
+**      that don't increment the count don't contribute.
+**   2. SeqCnt holds the expected count (last plus 1) so 0 means nothing has
+**      been received yet.
+**
+*/
+static void CheckSeqCnt(const CFE_MSG_Message_t* MsgPtr, uint16* SeqCnt)
+{
+
+   CFE_MSG_SequenceCount_t MsgSeqCnt;
+   uint16 Gap;
+   
+   if (CFE_MSG_GetSequenceCount(MsgPtr, &MsgSeqCnt) == CFE_SUCCESS)
+   {
+      if (*SeqCnt != 0)
+      {
+         Gap = (MsgSeqCnt - *SeqCnt) & GPIO_DEMO_SEQ_CNT_MASK;
+         if (Gap < GPIO_DEMO_SEQ_CNT_MAX_GAP)
+         {
+            GpioDemo.CmdDropCnt += Gap;
+         }
+      }
+      *SeqCnt = MsgSeqCnt + 1;
+   }
+
+} /* End CheckSeqCnt() */
+
+
+/******************************************************************************
+** Function: HkChanged
+**
+** Return true if a payload field selected by HkMask differs from the last
+** HK sent
+**
+** Notes:
+**   1. The bytes are compared without branching so the loop costs the same
+**      whether or not anything changed.
+**
+*/
+static bool HkChanged(const GPIO_DEMO_HkTlm_Payload_t* HkTlmPayload)
+{
+   
+   const uint8 *New  = (const uint8*)HkTlmPayload;
+   const uint8 *Last = (const uint8*)&GpioDemo.HkLast;
+   const uint8 *Mask = (const uint8*)&GpioDemo.HkMask;
+   uint8  Diff = 0;
+   uint16 i;
+   
+   for (i=0; i < sizeof(GPIO_DEMO_HkTlm_Payload_t); i++)
    {
+      Diff |= (New[i] ^ Last[i]) & Mask[i];
+   }
    
-         CFE_ES_WriteToSysLog("GPIO_DEMO software bus error. Status = 0x%08X\n", SysStatus);   /* Use SysLog, events may not be working */
-         RetStatus = CFE_ES_RunStatus_APP_ERROR;
-   }  
-      
-   return RetStatus;
+   return (Diff != 0);
+   
+} /* End HkChanged() */
 
-} /* End ProcessCommands() */
+
+/******************************************************************************
+** Function: InitHkPolicy
+**
+** Notes:
+**   1. ON_CHANGE ignores fields that change while the controller runs
+**      without any command or fault: edge, write, wakeup and sample
+**      counters, output and input levels, latency maxima and rates. Fault
+**      counters such as resyncs, map failures, write errors and drops are
+**      still compared. Ignored fields are still reported when HK is sent.
+**   2. The controller packets' request counts start at the heartbeat so
+**      ON_CHANGE sends each of them on the first HK request.
+**   3. "gpio_demo_bench hk_idle" checks that an idle controller with the
+**      default ini skips HK requests.
+**
+*/
+static void InitHkPolicy(void)
+{
+   
+   GPIO_DEMO_HkTlm_Payload_t *HkMask = &GpioDemo.HkMask;
+   const char *Policy = INITBL_GetStrConfig(INITBL_OBJ, CFG_HK_TLM_POLICY);
+   uint16 i;
+   
+   if (strcmp(Policy, "ON_CHANGE") == 0)
+   {
+      GpioDemo.HkPolicy = GPIO_DEMO_HkPolicy_ON_CHANGE;
+   }
+   else if (strcmp(Policy, "DECIMATE") == 0)
+   {
+      GpioDemo.HkPolicy = GPIO_DEMO_HkPolicy_DECIMATE;
+   }
+   else
+   {
+      GpioDemo.HkPolicy = GPIO_DEMO_HkPolicy_ALWAYS;
+   }
+   
+   GpioDemo.HkDecimation = INITBL_GetIntConfig(INITBL_OBJ, CFG_HK_TLM_DECIMATION);
+   if (GpioDemo.HkDecimation == 0)
+   {
+      GpioDemo.HkDecimation = 1;
+   }
+   GpioDemo.HkHeartbeat = INITBL_GetIntConfig(INITBL_OBJ, CFG_HK_TLM_HEARTBEAT);
+   for (i=0; i < GPIO_DEMO_CTRL_TLM_CNT; i++)
+   {
+      GpioDemo.CtrlTlmReqCnt[i] = GpioDemo.HkHeartbeat;
+   }
+   
+   memset(HkMask, 0xFF, sizeof(GPIO_DEMO_HkTlm_Payload_t));
+   HkMask->CtrlLedOn        = 0;
+   HkMask->CtrlBankWriteCnt = 0;
+   HkMask->CtrlOutLevel     = 0;
+   HkMask->CtrlDriftUs      = 0;
+   HkMask->CtrlMaxOverrunUs = 0;
+   HkMask->CtrlEdgeCnt      = 0;
+   HkMask->CtrlLastEdgeTime = 0;
+   HkMask->CtrlOnTimeTotal  = 0;
+   HkMask->CtrlWakeCnt      = 0;
+   HkMask->PatternCycleCnt  = 0;
+   HkMask->DrvWriteCnt      = 0;
+   HkMask->DrvWriteP50Ns    = 0;
+   HkMask->DrvWriteP99Ns    = 0;
+   HkMask->DrvWriteMaxNs    = 0;
+   HkMask->CapSampleCnt     = 0;
+   HkMask->CapRecordCnt     = 0;
+   HkMask->CapOverrunCnt    = 0;
+   HkMask->CapInLevel       = 0;
+   HkMask->CapChangeCnt     = 0;
+   HkMask->CapGlitchCnt     = 0;
+   HkMask->LogicSampleCnt   = 0;
+   HkMask->LogicRunCnt      = 0;
+   HkMask->LogicArenaUsed   = 0;
+   HkMask->LogicDumpByteCnt = 0;
+   HkMask->HkSkipCnt        = 0;
+   HkMask->TlmPktCnt        = 0;
+   HkMask->TlmByteRate      = 0;
+   HkMask->TlmCopyByteRate  = 0;
+   
+} /* End InitHkPolicy() */
+
+
+/******************************************************************************
+** Function: SendCtrlTlm
+**
+** Send the controller's edge histogram, PWM and sequence packets for an HK
+** request
+**
+** Notes:
+**   1. DECIMATE sends them with HK. ON_CHANGE sends a packet when its
+**      GPIO_CTRL function finds a change since the packet was last sent or
+**      after HK_TLM_HEARTBEAT requests without one.
+**   2. Each packet has its own request count so an HK sent because of a
+**      change doesn't restart the other packets' heartbeat.
+**
+*/
+static void SendCtrlTlm(bool HkSent)
+{
+   
+   static bool (*const SendTlm[GPIO_DEMO_CTRL_TLM_CNT])(bool OnlyIfChanged) =
+   {
+      GPIO_CTRL_SendEdgeHistTlm,
+      GPIO_CTRL_SendPwmTlm,
+      GPIO_CTRL_SendSeqTlm
+   };
+   bool   OnlyIfChanged;
+   uint16 i;
+   
+   if (GpioDemo.HkPolicy == GPIO_DEMO_HkPolicy_DECIMATE && !HkSent)
+   {
+      return;
+   }
+   
+   for (i=0; i < GPIO_DEMO_CTRL_TLM_CNT; i++)
+   {
+      GpioDemo.CtrlTlmReqCnt[i]++;
+      OnlyIfChanged = (GpioDemo.HkPolicy == GPIO_DEMO_HkPolicy_ON_CHANGE) &&
+                      (GpioDemo.HkHeartbeat == 0 || GpioDemo.CtrlTlmReqCnt[i] < GpioDemo.HkHeartbeat);
+      if (SendTlm[i](OnlyIfChanged))
+      {
+         GpioDemo.CtrlTlmReqCnt[i] = 0;
+      }
+   }
+   
+} /* End SendCtrlTlm() */
 
 
 /******************************************************************************
 ** Function: SendHousekeepingPkt
 **
+** Notes:
+**   1. DECIMATE skips requests before building the packet. ON_CHANGE has to
+**      build it to compare it with the last HK sent.
+**   2. Returns true if HK was sent.
+**
 */
-static void SendHousekeepingPkt(void)
+static bool SendHousekeepingPkt(void)
 {
    
-   GPIO_DEMO_HkTlm_Payload_t *HkTlmPayload = &GpioDemo.HkTlm.Payload;
+   GPIO_DEMO_HkTlm_t         *HkTlm;
+   GPIO_DEMO_HkTlm_Payload_t *HkTlmPayload;
+   const GPIO_DRV_Class_t    *GpioDrv = &GpioDemo.GpioCtrl.GpioDrv;
+   int64 DriftUs;
+   
+   GpioDemo.HkReqCnt++;
+   if (GpioDemo.HkPolicy == GPIO_DEMO_HkPolicy_DECIMATE && GpioDemo.HkReqCnt < GpioDemo.HkDecimation)
+   {
+      GpioDemo.HkSkipCnt++;
+      return false;
+   }
+   
+   HkTlm = (GPIO_DEMO_HkTlm_t*)TLM_BUF_Alloc(TLM_BUF_MAIN_TASK, GpioDemo.HkTlmMid, sizeof(GPIO_DEMO_HkTlm_t));
+   HkTlmPayload = &HkTlm->Payload;
    
    HkTlmPayload->ValidCmdCnt   = GpioDemo.CmdMgr.ValidCmdCnt;
    HkTlmPayload->InvalidCmdCnt = GpioDemo.CmdMgr.InvalidCmdCnt;
+   
+   HkTlmPayload->CmdBatchHighWater = GpioDemo.CmdBatchHighWater;
+   HkTlmPayload->CmdBatchLimitCnt = GpioDemo.CmdBatchLimitCnt;
+   HkTlmPayload->CmdDropCnt       = GpioDemo.CmdDropCnt;
 
    /*
    ** Controller 
    */ 
    
    HkTlmPayload->CtrlIsMapped = GpioDemo.GpioCtrl.IsMapped;
-   HkTlmPayload->CtrlOutPin   = GpioDemo.GpioCtrl.OutPin;
+   HkTlmPayload->CtrlOutPin   = GpioDemo.GpioCtrl.Chan[0].Pin;
    
-   HkTlmPayload->CtrlLedOn    = GpioDemo.GpioCtrl.LedOn;
-   HkTlmPayload->CtrlSpare    = 5;
+   HkTlmPayload->CtrlLedOn    = GpioDemo.GpioCtrl.Chan[0].On;
          
-   HkTlmPayload->CtrlOnTime   = GpioDemo.GpioCtrl.OnTime;
-   HkTlmPayload->CtrlOffTime  = GpioDemo.GpioCtrl.OffTime;
+   HkTlmPayload->CtrlOnTime   = GpioDemo.GpioCtrl.Chan[0].OnTime;
+   HkTlmPayload->CtrlOffTime  = GpioDemo.GpioCtrl.Chan[0].OffTime;
+   
+   HkTlmPayload->CtrlChanCnt      = GpioDemo.GpioCtrl.ChanCnt;
+   HkTlmPayload->CtrlBankWriteCnt = GpioDemo.GpioCtrl.BankWriteCnt;
+   HkTlmPayload->CtrlOutLevel     = GpioDemo.GpioCtrl.OutLevel;
+   
+   DriftUs = (GpioDemo.GpioCtrl.ResyncDriftNs + GpioDemo.GpioCtrl.DriftNs) / 1000;
+   HkTlmPayload->CtrlDriftUs      = (DriftUs > INT32_MAX) ? INT32_MAX : (DriftUs < INT32_MIN) ? INT32_MIN : (int32)DriftUs;
+   HkTlmPayload->CtrlMaxOverrunUs = (uint32)(GpioDemo.GpioCtrl.MaxOverrunNs / 1000);
+   HkTlmPayload->CtrlResyncCnt    = GpioDemo.GpioCtrl.ResyncCnt;
+   HkTlmPayload->CtrlTimingMode   = GpioDemo.GpioCtrl.TimingMode;
+   HkTlmPayload->CtrlRtStatus     = GpioDemo.GpioCtrl.RtStatus;
+   
+   HkTlmPayload->CtrlEdgeCnt         = GpioDemo.GpioCtrl.EdgeCnt;
+   HkTlmPayload->CtrlLastEdgeTime    = GpioDemo.GpioCtrl.LastEdgeTime;
+   HkTlmPayload->CtrlEdgeEventPeriod = GpioDemo.GpioCtrl.EdgeEventPeriod;
+   HkTlmPayload->CtrlOnTimeTotal     = GpioDemo.GpioCtrl.OnTimeTotal;
+   HkTlmPayload->CtrlCfgSeq          = GpioDemo.GpioCtrl.CfgSeq;
+   HkTlmPayload->CtrlCfgApplySeq     = GpioDemo.GpioCtrl.CfgApplySeq;
+   HkTlmPayload->CtrlWakeCnt         = GpioDemo.GpioCtrl.WakeCnt;
+   HkTlmPayload->CtrlMapRetryMs      = GpioDemo.GpioCtrl.MapRetryMs;
+   HkTlmPayload->CtrlMapAttemptCnt   = GpioDemo.GpioCtrl.MapAttemptCnt;
+   HkTlmPayload->CtrlMapFailCnt      = GpioDemo.GpioCtrl.MapFailCnt;
+   HkTlmPayload->CtrlMode            = GpioDemo.GpioCtrl.ActiveMode;
+   HkTlmPayload->PatternLoadStatus   = GpioDemo.GpioCtrl.PatternTbl.LastLoadStatus;
+   HkTlmPayload->PatternStepCnt      = GpioDemo.GpioCtrl.PatternTbl.Pattern[GpioDemo.GpioCtrl.PatternTbl.PubIdx].StepCnt;
+   HkTlmPayload->PatternLoadCnt      = GpioDemo.GpioCtrl.PatternTbl.LoadCnt;
+   HkTlmPayload->PatternPeriodUs     = GpioDemo.GpioCtrl.PatternTbl.Pattern[GpioDemo.GpioCtrl.PatternTbl.PubIdx].PeriodUs;
+   HkTlmPayload->PatternCycleCnt     = GpioDemo.GpioCtrl.PatternCycleCnt;
+   HkTlmPayload->CtrlTagQueueCnt     = GpioDemo.GpioCtrl.TagHead - __atomic_load_n(&GpioDemo.GpioCtrl.TagDoneCnt, __ATOMIC_ACQUIRE);
+   HkTlmPayload->CtrlTagFailCnt      = GpioDemo.GpioCtrl.TagFailCnt;
+   HkTlmPayload->CtrlTagExecCnt      = GpioDemo.GpioCtrl.TagExecCnt;
+   HkTlmPayload->CtrlTagMaxLateUs    = (uint32)(GpioDemo.GpioCtrl.TagMaxLateNs / 1000);
    
-   CFE_SB_TimeStampMsg(CFE_MSG_PTR(GpioDemo.HkTlm.TelemetryHeader));
-   CFE_SB_TransmitMsg(CFE_MSG_PTR(GpioDemo.HkTlm.TelemetryHeader), true);
+   /*
+   ** Input Capture
+   */
+   
+   HkTlmPayload->CapInPinCnt    = GpioDemo.InputCap.InPinCnt;
+   HkTlmPayload->CapRtStatus    = GpioDemo.InputCap.RtStatus;
+   HkTlmPayload->CapSampleCnt   = GpioDemo.InputCap.SampleCnt;
+   HkTlmPayload->CapRecordCnt   = GpioDemo.InputCap.RecordCnt;
+   HkTlmPayload->CapOverflowCnt = GpioDemo.InputCap.OverflowCnt;
+   HkTlmPayload->CapOverrunCnt  = GpioDemo.InputCap.OverrunCnt;
+   HkTlmPayload->CapInLevel     = GpioDemo.InputCap.Debounce.Level;
+   HkTlmPayload->CapChangeCnt   = GpioDemo.InputCap.Debounce.ChangeCnt;
+   HkTlmPayload->CapGlitchCnt   = GpioDemo.InputCap.Debounce.GlitchCnt;
+   
+   /*
+   ** Logic Capture
+   */
+   
+   HkTlmPayload->LogicState       = GpioDemo.LogicCap.State;
+   HkTlmPayload->LogicArenaFull   = GpioDemo.LogicCap.ArenaFull;
+   HkTlmPayload->LogicDumpCnt     = GpioDemo.LogicCap.DumpCnt;
+   HkTlmPayload->LogicSampleCnt   = (uint32)GpioDemo.LogicCap.Hdr.SampleCnt;
+   HkTlmPayload->LogicRunCnt      = GpioDemo.LogicCap.Hdr.RunCnt;
+   HkTlmPayload->LogicArenaUsed   = GpioDemo.LogicCap.ArenaUsed;
+   HkTlmPayload->LogicDumpByteCnt = GpioDemo.LogicCap.DumpByteCnt;
+   
+   /*
+   ** GPIO Driver
+   */
+   
+   HkTlmPayload->CtrlBackend   = GpioDrv->Backend;
+   HkTlmPayload->DrvIsMapped   = GpioDrv->IsMapped;
+   HkTlmPayload->DrvOutPinCnt  = __builtin_popcountll(GpioDrv->OutMask);
+   HkTlmPayload->DrvMapNs      = GpioDrv->MapNs;
+   HkTlmPayload->DrvWriteCnt   = GpioDrv->WriteCnt;
+   HkTlmPayload->DrvWriteErrCnt = GpioDrv->WriteErrCnt;
+   HkTlmPayload->DrvWriteP50Ns = (uint32)LAT_HIST_GetPercentile(&GpioDrv->WriteHist, 500);
+   HkTlmPayload->DrvWriteP99Ns = (uint32)LAT_HIST_GetPercentile(&GpioDrv->WriteHist, 990);
+   HkTlmPayload->DrvWriteMaxNs = (uint32)GpioDrv->WriteHist.MaxNs;
+   
+   /*
+   ** Telemetry
+   */
+   
+   TLM_BUF_UpdateRates();
+   HkTlmPayload->HkPolicy        = GpioDemo.HkPolicy;
+   HkTlmPayload->HkSkipCnt       = GpioDemo.HkSkipCnt;
+   HkTlmPayload->TlmZeroCopy     = GpioDemo.TlmBuf.ZeroCopy;
+   HkTlmPayload->TlmAllocFailCnt = GpioDemo.TlmBuf.AllocFailCnt;
+   HkTlmPayload->TlmSendErrCnt   = GpioDemo.TlmBuf.SendErrCnt;
+   HkTlmPayload->TlmPktCnt       = GpioDemo.TlmBuf.PktCnt;
+   HkTlmPayload->TlmByteRate     = GpioDemo.TlmBuf.ByteRate;
+   HkTlmPayload->TlmCopyByteRate = GpioDemo.TlmBuf.CopyByteRate;
+   
+   if (GpioDemo.HkPolicy == GPIO_DEMO_HkPolicy_ON_CHANGE)
+   {
+      if ((GpioDemo.HkHeartbeat == 0 || GpioDemo.HkReqCnt < GpioDemo.HkHeartbeat) &&
+          !HkChanged(HkTlmPayload))
+      {
+         TLM_BUF_Release((CFE_SB_Buffer_t*)HkTlm);
+         GpioDemo.HkSkipCnt++;
+         return false;
+      }
+      GpioDemo.HkLast = *HkTlmPayload;
+   }
+   
+   GpioDemo.HkReqCnt = 0;
+   TLM_BUF_Send((CFE_SB_Buffer_t*)HkTlm);
+   
+   return true;
    
 } /* End SendHousekeepingPkt() */
 
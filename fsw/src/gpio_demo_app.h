@@ -36,7 +36,12 @@
 #include "app_cfg.h"
 #include "childmgr.h"
 #include "initbl.h"
+#include "tblmgr.h"
 #include "gpio_ctrl.h"
+#include "input_cap.h"
+#include "logic_cap.h"
+#include "tlm_buf.h"
+#include "trace_log.h"
 
 /***********************/
 /** Macro Definitions **/
@@ -51,6 +56,15 @@
 #define GPIO_DEMO_EXIT_EID        (GPIO_DEMO_BASE_EID + 2)
 #define GPIO_DEMO_INVALID_MID_EID (GPIO_DEMO_BASE_EID + 3)
 
+/*
+** Command pipe
+*/
+
+#define GPIO_DEMO_SEQ_CNT_MASK     0x3FFF   /* CCSDS 14-bit sequence count */
+#define GPIO_DEMO_SEQ_CNT_MAX_GAP  0x2000   /* Larger gaps are treated as a source restart */
+
+#define GPIO_DEMO_CTRL_TLM_CNT     3        /* Controller packets sent with HK: edge histogram, PWM and sequence */
+
 
 /**********************/
 /** Type Definitions **/
@@ -107,12 +121,25 @@ typedef struct
    CFE_SB_PipeId_t    CmdPipe;
    CMDMGR_Class_t     CmdMgr;
    CHILDMGR_Class_t   ChildMgr;   
+   CHILDMGR_Class_t   CapChildMgr;   /* Input capture sampler, only created with input pins */
+   CHILDMGR_Class_t   LogicChildMgr;
+   TBLMGR_Class_t     TblMgr;
    
    /*
    ** Telemetry Packets
    */
    
-   GPIO_DEMO_HkTlm_t  HkTlm;
+   CFE_SB_MsgId_t     HkTlmMid;
+   TLM_BUF_Class_t    TlmBuf;
+   
+   uint8              HkPolicy;
+   uint16             HkDecimation;
+   uint16             HkHeartbeat;        /* ON_CHANGE requests between forced sends, 0 = none */
+   uint32             HkReqCnt;           /* HK requests since HK was last sent */
+   uint32             HkSkipCnt;
+   GPIO_DEMO_HkTlm_Payload_t  HkLast;     /* Last HK payload sent */
+   GPIO_DEMO_HkTlm_Payload_t  HkMask;     /* ON_CHANGE compares the payload bytes set here */
+   uint32             CtrlTlmReqCnt[GPIO_DEMO_CTRL_TLM_CNT];   /* HK requests since each controller packet was last sent */
 
    /*
    ** App State & Objects
@@ -122,7 +149,20 @@ typedef struct
    CFE_SB_MsgId_t     CmdMid;
    CFE_SB_MsgId_t     SendHkMid;
    
+   uint16             CmdBatchLimit;
+   uint16             CmdBatchHighWater;  /* Most messages processed in one wakeup */
+   uint16             CmdBatchLimitCnt;   /* Wakeups that stopped at CmdBatchLimit */
+   uint16             CmdSeqCnt;          /* Last sequence count + 1, 0 = none */
+   uint16             SendHkSeqCnt;
+   uint32             CmdDropCnt;         /* Sequence count gaps */
+   
+   bool               CapEnabled;
+   uint32             CapDrainMs;         /* Command pipe timeout that drains the capture ring */
+   
    GPIO_CTRL_Class_t  GpioCtrl;
+   INPUT_CAP_Class_t  InputCap;
+   LOGIC_CAP_Class_t  LogicCap;
+   TRACE_LOG_Class_t  TraceLog;
  
 } GPIO_DEMO_Class_t;
 
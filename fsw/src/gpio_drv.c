@@ -0,0 +1,1043 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Implement the GPIO Driver Class methods
+**
+**  Notes:
+**    1. See gpio_drv.h for the backend descriptions.
+**
+**  References:
+**    1. OpenSatKit Object-based Application Developer's Guide.
+**    2. cFS Application Developer's Guide.
+**
+*/
+
+/*
+** Include Files:
+*/
+
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <linux/gpio.h>
+
+#include "app_cfg.h"
+#include "gpio_drv.h"
+#include "mono_time.h"
+#include "gpio.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define GPIO_REG_DEV        "/dev/gpiomem"
+#define GPIO_REG_BLOCK_LEN  4096
+
+#define GPIO_DRV_MAP_POLL_NS  10000   /* GPIO_DRV_Map() sleep while readers finish */
+
+/* 32-bit word offsets into the GPIO register block */
+#define GPIO_REG_GPSET0  7
+#define GPIO_REG_GPSET1  8
+#define GPIO_REG_GPCLR0  10
+#define GPIO_REG_GPCLR1  11
+#define GPIO_REG_GPLEV0  13
+#define GPIO_REG_GPLEV1  14
+
+/* RegUnmap() releases PI and SIM register blocks with the same length */
+CompileTimeAssert(GPIO_REG_BLOCK_LEN == GPIO_DRV_SIM_FILE_LEN, RegBlockLenMismatch);
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+typedef struct
+{
+   
+   const char* Name;
+   bool   (*Map)(void);
+   void   (*Unmap)(void);
+   bool   (*ConfigOut)(uint64 PinMask);
+   bool   (*ConfigIn)(uint64 PinMask);
+   void   (*Write)(uint64 SetMask, uint64 ClrMask);
+   uint64 (*Read)(void);
+   uint64 (*ReadIn)(void);
+   uint64 (*ReadAll)(void);
+   
+} BackendOps_t;
+
+
+/*******************************/
+/** Local Function Prototypes **/
+/*******************************/
+
+static bool   PiMap(void);
+static void   RegUnmap(void);
+static bool   PiConfigOut(uint64 PinMask);
+static bool   PiConfigIn(uint64 PinMask);
+static bool   SimMap(void);
+static bool   SimConfigOut(uint64 PinMask);
+static bool   SimConfigIn(uint64 PinMask);
+static void   SimWrite(uint64 SetMask, uint64 ClrMask);
+static void   RegWrite(uint64 SetMask, uint64 ClrMask);
+static uint64 RegRead(void);
+static bool   ChipMap(void);
+static void   ChipUnmap(void);
+static bool   ChipConfigOut(uint64 PinMask);
+static bool   ChipConfigIn(uint64 PinMask);
+static void   ChipWrite(uint64 SetMask, uint64 ClrMask);
+static uint64 ChipRead(void);
+static uint64 ChipReadIn(void);
+static uint64 ChipReadAll(void);
+static bool   MockMap(void);
+static void   MockUnmap(void);
+static bool   MockConfigOut(uint64 PinMask);
+static bool   MockConfigIn(uint64 PinMask);
+static void   MockWrite(uint64 SetMask, uint64 ClrMask);
+static uint64 MockRead(void);
+static uint64 ChipLineBits(uint64 PinMask);
+static uint64 ChipGetLines(int LineFd, uint8 LineCnt, const uint8* LineIdx, uint64 PinMask);
+static int    ChipRequestLines(uint64 PinMask, uint64 Flags, uint8* LineCnt, uint8* LineIdx);
+static bool   GatedRead(uint64 (*ReadFunc)(void), uint64* Level);
+
+
+/**********************/
+/** Global File Data **/
+/**********************/
+
+static GPIO_DRV_Class_t*  GpioDrv = NULL;
+
+/* Indexed by GPIO_DRV_BACKEND_x */
+static const BackendOps_t BackendOps[GPIO_DRV_BACKEND_CNT] =
+{
+   { "PI",   PiMap,   RegUnmap,  PiConfigOut,   PiConfigIn,   RegWrite,  RegRead,  RegRead,    RegRead     },
+   { "SIM",  SimMap,  RegUnmap,  SimConfigOut,  SimConfigIn,  SimWrite,  RegRead,  RegRead,    RegRead     },
+   { "CHIP", ChipMap, ChipUnmap, ChipConfigOut, ChipConfigIn, ChipWrite, ChipRead, ChipReadIn, ChipReadAll },
+   { "MOCK", MockMap, MockUnmap, MockConfigOut, MockConfigIn, MockWrite, MockRead, MockRead,   MockRead    }
+};
+
+
+/******************************************************************************
+** Function: GPIO_DRV_Constructor
+**
+** Initialize the GPIO Driver object and map the configured backend
+**
+** Notes:
+**   1. This must be called prior to any other function.
+**   2. An unknown backend name defaults to PI.
+**
+*/
+void GPIO_DRV_Constructor(GPIO_DRV_Class_t *GpioDrvPtr, INITBL_Class_t* IniTbl)
+{
+   
+   const char* BackendName = INITBL_GetStrConfig(IniTbl, CFG_CTRL_GPIO_BACKEND);
+   uint8 i;
+   
+   GpioDrv = GpioDrvPtr;
+   
+   memset(GpioDrv, 0, sizeof(GPIO_DRV_Class_t));
+   
+   GpioDrv->ChipFd    = -1;
+   GpioDrv->OutLineFd = -1;
+   GpioDrv->InLineFd  = -1;
+   strncpy(GpioDrv->SimFile, INITBL_GetStrConfig(IniTbl, CFG_CTRL_SIM_FILE), OS_MAX_PATH_LEN-1);
+   strncpy(GpioDrv->ChipDev, INITBL_GetStrConfig(IniTbl, CFG_CTRL_GPIO_CHIP), OS_MAX_PATH_LEN-1);
+   
+   GpioDrv->Backend = GPIO_DRV_BACKEND_CNT;
+   for (i=0; i < GPIO_DRV_BACKEND_CNT; i++)
+   {
+      if (strcmp(BackendName, BackendOps[i].Name) == 0)
+      {
+         GpioDrv->Backend = i;
+      }
+   }
+   if (GpioDrv->Backend == GPIO_DRV_BACKEND_CNT)
+   {
+      CFE_EVS_SendEvent (GPIO_DRV_CONSTRUCTOR_EID, CFE_EVS_EventType_ERROR, 
+                         "Unknown GPIO backend %s, using %s", BackendName, BackendOps[GPIO_DRV_BACKEND_PI].Name);
+      GpioDrv->Backend = GPIO_DRV_BACKEND_PI;
+   }
+   
+   LAT_HIST_Constructor(&GpioDrv->WriteHist);
+   
+   GPIO_DRV_Map();
+   
+} /* End GPIO_DRV_Constructor() */
+
+
+/******************************************************************************
+** Function: GPIO_DRV_BackendStr
+**
+*/
+const char* GPIO_DRV_BackendStr(uint8 Backend)
+{
+   
+   return (Backend < GPIO_DRV_BACKEND_CNT) ? BackendOps[Backend].Name : "UNDEF";
+   
+} /* End GPIO_DRV_BackendStr() */
+
+
+/******************************************************************************
+** Function: GPIO_DRV_ConfigIn
+**
+** Notes:
+**   1. A backend reports its own failures so each failure sends one event.
+**
+*/
+bool GPIO_DRV_ConfigIn(uint64 PinMask)
+{
+   
+   bool RetStatus = true;
+   
+   GpioDrv->InMask = PinMask;
+   
+   if (GpioDrv->IsMapped)
+   {
+      RetStatus = BackendOps[GpioDrv->Backend].ConfigIn(PinMask);
+   }
+   
+   return RetStatus;
+   
+} /* End GPIO_DRV_ConfigIn() */
+
+
+/******************************************************************************
+** Function: GPIO_DRV_ConfigOut
+**
+** Notes:
+**   1. An unmapped backend fails without an event, the map failure has
+**      already been reported.
+**
+*/
+bool GPIO_DRV_ConfigOut(uint64 PinMask)
+{
+   
+   bool RetStatus = false;
+   
+   if (GpioDrv->IsMapped)
+   {
+      RetStatus = BackendOps[GpioDrv->Backend].ConfigOut(PinMask);
+   }
+   
+   if (RetStatus)
+   {
+      GpioDrv->OutMask = PinMask;
+   }
+   
+   return RetStatus;
+   
+} /* End GPIO_DRV_ConfigOut() */
+
+
+/******************************************************************************
+** Function: GPIO_DRV_GetInMask
+**
+*/
+uint64 GPIO_DRV_GetInMask(void)
+{
+   
+   return GpioDrv->InMask;
+   
+} /* End GPIO_DRV_GetInMask() */
+
+
+/******************************************************************************
+** Function: GPIO_DRV_Map
+**
+** Notes:
+**   1. A mapped backend is unmapped first so Map() can be used to recover
+**      a backend that stopped working.
+**   2. Mapping and ReaderCnt form a Dekker style handshake with the
+**      readers, see GatedRead(). Both are sequentially consistent so either
+**      a reader sees Mapping and backs off or this waits for its read.
+**      The wait sleeps instead of spinning so a lower priority reader
+**      preempted on the same CPU can finish its read.
+**
+*/
+bool GPIO_DRV_Map(void)
+{
+   
+   uint64 StartNs = MONO_TIME_GetNs();
+   
+   __atomic_store_n(&GpioDrv->Mapping, true, __ATOMIC_SEQ_CST);
+   while (__atomic_load_n(&GpioDrv->ReaderCnt, __ATOMIC_SEQ_CST) != 0)
+   {
+      MONO_TIME_SleepUntilNs(MONO_TIME_GetNs() + GPIO_DRV_MAP_POLL_NS);
+   }
+   
+   if (GpioDrv->IsMapped)
+   {
+      BackendOps[GpioDrv->Backend].Unmap();
+      GpioDrv->IsMapped = false;
+      GpioDrv->OutMask  = 0;
+   }
+   
+   GpioDrv->IsMapped = BackendOps[GpioDrv->Backend].Map();
+   GpioDrv->MapNs    = (uint32)(MONO_TIME_GetNs() - StartNs);
+   
+   if (GpioDrv->IsMapped)
+   {
+      CFE_EVS_SendEvent (GPIO_DRV_MAP_EID, CFE_EVS_EventType_INFORMATION, 
+                         "%s GPIO backend mapped in %u ns", 
+                         BackendOps[GpioDrv->Backend].Name, GpioDrv->MapNs);
+      if (GpioDrv->InMask != 0)
+      {
+         GPIO_DRV_ConfigIn(GpioDrv->InMask);
+      }
+   }
+   
+   __atomic_store_n(&GpioDrv->Mapping, false, __ATOMIC_RELEASE);
+   
+   return GpioDrv->IsMapped;
+   
+} /* End GPIO_DRV_Map() */
+
+
+/******************************************************************************
+** Function: GPIO_DRV_Read
+**
+*/
+uint64 GPIO_DRV_Read(void)
+{
+   
+   return GpioDrv->IsMapped ? BackendOps[GpioDrv->Backend].Read() : 0;
+   
+} /* End GPIO_DRV_Read() */
+
+
+/******************************************************************************
+** Function: GPIO_DRV_ReadAll
+**
+*/
+bool GPIO_DRV_ReadAll(uint64* Level)
+{
+   
+   return GatedRead(BackendOps[GpioDrv->Backend].ReadAll, Level);
+   
+} /* End GPIO_DRV_ReadAll() */
+
+
+/******************************************************************************
+** Function: GPIO_DRV_ReadIn
+**
+*/
+bool GPIO_DRV_ReadIn(uint64* Level)
+{
+   
+   bool RetStatus = GatedRead(BackendOps[GpioDrv->Backend].ReadIn, Level);
+   
+   *Level &= GpioDrv->InMask;
+   
+   return RetStatus;
+   
+} /* End GPIO_DRV_ReadIn() */
+
+
+/******************************************************************************
+** Function: GPIO_DRV_ResetStatus
+**
+*/
+void GPIO_DRV_ResetStatus(void)
+{
+   
+   GpioDrv->WriteCnt    = 0;
+   GpioDrv->WriteErrCnt = 0;
+   LAT_HIST_Reset(&GpioDrv->WriteHist);
+   
+} /* End GPIO_DRV_ResetStatus() */
+
+
+/******************************************************************************
+** Function: GPIO_DRV_Write
+**
+*/
+uint64 GPIO_DRV_Write(uint64 SetMask, uint64 ClrMask)
+{
+   
+   uint64 StartNs = MONO_TIME_GetNs();
+   
+   BackendOps[GpioDrv->Backend].Write(SetMask, ClrMask);
+   
+   LAT_HIST_AddSample(&GpioDrv->WriteHist, (int64)(MONO_TIME_GetNs() - StartNs));
+   GpioDrv->WriteCnt++;
+   
+   return StartNs;
+   
+} /* End GPIO_DRV_Write() */
+
+
+/******************************************************************************
+** Function: PiMap
+**
+** Map the peripherals with pi_iolib and the GPIO register block used for
+** the bank set/clear writes.
+**
+** Notes:
+**   1. The pi_iolib peripheral map is made once and kept for the life of
+**      the app so a remap doesn't leak its mapping and file descriptor.
+**      Only the register block is released by RegUnmap().
+**
+*/
+static bool PiMap(void)
+{
+   
+   bool  RetStatus = false;
+   int   Fd;
+   void* RegBlock = MAP_FAILED;
+   
+   if (!GpioDrv->PiIoMapped)
+   {
+      if (gpio_map() < 0) // map peripherals
+      {
+         CFE_EVS_SendEvent (GPIO_DRV_MAP_EID, CFE_EVS_EventType_ERROR, "GPIO map failed");
+         return false;
+      }
+      GpioDrv->PiIoMapped = true;
+   }
+   
+   Fd = open(GPIO_REG_DEV, O_RDWR | O_SYNC);
+   if (Fd >= 0)
+   {
+      RegBlock = mmap(NULL, GPIO_REG_BLOCK_LEN, PROT_READ | PROT_WRITE, MAP_SHARED, Fd, 0);
+      close(Fd);
+   }
+      
+   if (RegBlock != MAP_FAILED)
+   {
+      GpioDrv->Reg = (volatile uint32*)RegBlock;
+      RetStatus = true;
+   }
+   else
+   {
+      CFE_EVS_SendEvent (GPIO_DRV_MAP_EID, CFE_EVS_EventType_ERROR, 
+                         "GPIO register block map of %s failed, errno %d", GPIO_REG_DEV, errno);
+   }
+   
+   return RetStatus;
+   
+} /* End PiMap() */
+
+
+/******************************************************************************
+** Function: PiConfigOut
+**
+*/
+static bool PiConfigOut(uint64 PinMask)
+{
+   
+   uint64 Pins = PinMask;
+   
+   while (Pins != 0)
+   {
+      gpio_out(__builtin_ctzll(Pins));
+      Pins &= Pins - 1;
+   }
+   
+   return true;
+   
+} /* End PiConfigOut() */
+
+
+/******************************************************************************
+** Function: PiConfigIn
+**
+*/
+static bool PiConfigIn(uint64 PinMask)
+{
+   
+   uint64 Pins = PinMask;
+   
+   while (Pins != 0)
+   {
+      gpio_in(__builtin_ctzll(Pins));
+      Pins &= Pins - 1;
+   }
+   
+   return true;
+   
+} /* End PiConfigIn() */
+
+
+/******************************************************************************
+** Function: RegUnmap
+**
+*/
+static void RegUnmap(void)
+{
+   
+   if (GpioDrv->Reg != NULL)
+   {
+      munmap((void*)GpioDrv->Reg, GPIO_REG_BLOCK_LEN);
+      GpioDrv->Reg       = NULL;
+      GpioDrv->SimStatus = NULL;
+   }
+   
+} /* End RegUnmap() */
+
+
+/******************************************************************************
+** Function: SimMap
+**
+** Map the simulated GPIO register file, creating it if needed.
+**
+** Notes:
+**   1. A file under /dev/shm gives a shared memory segment that external
+**      tools can map read-only.
+**
+*/
+static bool SimMap(void)
+{
+   
+   bool  RetStatus = false;
+   int   Fd;
+   void* RegBlock = MAP_FAILED;
+   
+   Fd = open(GpioDrv->SimFile, O_RDWR | O_CREAT, 0644);
+   if (Fd >= 0)
+   {
+      
+      if (ftruncate(Fd, GPIO_DRV_SIM_FILE_LEN) == 0)
+      {
+         RegBlock = mmap(NULL, GPIO_DRV_SIM_FILE_LEN, PROT_READ | PROT_WRITE, MAP_SHARED, Fd, 0);
+      }
+      close(Fd);
+      
+   }
+   
+   if (RegBlock != MAP_FAILED)
+   {
+      
+      memset(RegBlock, 0, GPIO_DRV_SIM_FILE_LEN);
+      GpioDrv->Reg       = (volatile uint32*)RegBlock;
+      GpioDrv->SimStatus = (volatile GPIO_DRV_SimStatus_t*)((uint8*)RegBlock + GPIO_DRV_SIM_STATUS_OFFSET);
+      GpioDrv->SimStatus->Magic = GPIO_DRV_SIM_MAGIC;
+      RetStatus = true;
+   
+   }
+   else
+   {
+      CFE_EVS_SendEvent (GPIO_DRV_MAP_EID, CFE_EVS_EventType_ERROR, 
+                         "Simulated GPIO register file map of %s failed, errno %d", GpioDrv->SimFile, errno);
+   }
+   
+   return RetStatus;
+   
+} /* End SimMap() */
+
+
+/******************************************************************************
+** Function: SimConfigOut
+**
+*/
+static bool SimConfigOut(uint64 PinMask)
+{
+   
+   return true;
+   
+} /* End SimConfigOut() */
+
+
+/******************************************************************************
+** Function: SimConfigIn
+**
+** Notes:
+**   1. Input levels are written to GPLEVn by an external tool.
+**
+*/
+static bool SimConfigIn(uint64 PinMask)
+{
+   
+   return true;
+   
+} /* End SimConfigIn() */
+
+
+/******************************************************************************
+** Function: SimWrite
+**
+** Notes:
+**   1. Performs the register writes and then mirrors the levels into
+**      GPLEVn and publishes the write in the shared SimStatus.
+**
+*/
+static void SimWrite(uint64 SetMask, uint64 ClrMask)
+{
+   
+   volatile uint32* Reg = GpioDrv->Reg;
+   volatile GPIO_DRV_SimStatus_t* Sim = GpioDrv->SimStatus;
+   uint64 Level;
+   
+   RegWrite(SetMask, ClrMask);
+   
+   Level = ((((uint64)Reg[GPIO_REG_GPLEV1]) << 32) | Reg[GPIO_REG_GPLEV0]);
+   Level = (Level | SetMask) & ~ClrMask;
+   
+   Sim->Seq++;
+   __atomic_thread_fence(__ATOMIC_RELEASE);
+   Reg[GPIO_REG_GPLEV0] = (uint32)Level;
+   Reg[GPIO_REG_GPLEV1] = (uint32)(Level >> 32);
+   Sim->Level      = Level;
+   Sim->EdgeTimeNs = MONO_TIME_GetNs();
+   Sim->WriteCnt++;
+   __atomic_thread_fence(__ATOMIC_RELEASE);
+   Sim->Seq++;
+   
+} /* End SimWrite() */
+
+
+/******************************************************************************
+** Function: RegWrite
+**
+** Notes:
+**   1. All pins in SetMask are raised by one GPSETn write and all pins in
+**      ClrMask are lowered by one GPCLRn write. Bank 1 (GPIO 32..53) is only
+**      written when one of its pins changes.
+**
+*/
+static void RegWrite(uint64 SetMask, uint64 ClrMask)
+{
+   
+   volatile uint32* Reg = GpioDrv->Reg;
+   
+   if ((uint32)SetMask != 0)
+   {
+      Reg[GPIO_REG_GPSET0] = (uint32)SetMask;
+   }
+   if ((SetMask >> 32) != 0)
+   {
+      Reg[GPIO_REG_GPSET1] = (uint32)(SetMask >> 32);
+   }
+   if ((uint32)ClrMask != 0)
+   {
+      Reg[GPIO_REG_GPCLR0] = (uint32)ClrMask;
+   }
+   if ((ClrMask >> 32) != 0)
+   {
+      Reg[GPIO_REG_GPCLR1] = (uint32)(ClrMask >> 32);
+   }
+   
+} /* End RegWrite() */
+
+
+/******************************************************************************
+** Function: RegRead
+**
+*/
+static uint64 RegRead(void)
+{
+   
+   return ((((uint64)GpioDrv->Reg[GPIO_REG_GPLEV1]) << 32) | GpioDrv->Reg[GPIO_REG_GPLEV0]);
+   
+} /* End RegRead() */
+
+
+/******************************************************************************
+** Function: ChipMap
+**
+*/
+static bool ChipMap(void)
+{
+   
+   if (GpioDrv->ChipFd < 0)
+   {
+      GpioDrv->ChipFd = open(GpioDrv->ChipDev, O_RDWR | O_CLOEXEC);
+   }
+   
+   if (GpioDrv->ChipFd < 0)
+   {
+      CFE_EVS_SendEvent (GPIO_DRV_MAP_EID, CFE_EVS_EventType_ERROR, 
+                         "GPIO chip open of %s failed, errno %d", GpioDrv->ChipDev, errno);
+   }
+   
+   return (GpioDrv->ChipFd >= 0);
+   
+} /* End ChipMap() */
+
+
+/******************************************************************************
+** Function: ChipUnmap
+**
+** Release the input and output lines and the chip
+**
+*/
+static void ChipUnmap(void)
+{
+   
+   if (GpioDrv->OutLineFd >= 0)
+   {
+      close(GpioDrv->OutLineFd);
+      GpioDrv->OutLineFd = -1;
+   }
+   
+   if (GpioDrv->InLineFd >= 0)
+   {
+      close(GpioDrv->InLineFd);
+      GpioDrv->InLineFd = -1;
+   }
+   
+   if (GpioDrv->ChipFd >= 0)
+   {
+      close(GpioDrv->ChipFd);
+      GpioDrv->ChipFd = -1;
+   }
+   
+} /* End ChipUnmap() */
+
+
+/******************************************************************************
+** Function: ChipConfigOut
+**
+** Request all output pins as lines of a single line request.
+**
+** Notes:
+**   1. An empty PinMask releases the lines without a new request.
+**
+*/
+static bool ChipConfigOut(uint64 PinMask)
+{
+   
+   if (GpioDrv->OutLineFd >= 0)
+   {
+      close(GpioDrv->OutLineFd);
+      GpioDrv->OutLineFd = -1;
+   }
+   GpioDrv->OutLineCnt = 0;
+   
+   if (PinMask == 0)
+   {
+      return true;
+   }
+   
+   GpioDrv->OutLineFd = ChipRequestLines(PinMask, GPIO_V2_LINE_FLAG_OUTPUT, 
+                                         &GpioDrv->OutLineCnt, GpioDrv->OutLineIdx);
+   if (GpioDrv->OutLineFd < 0)
+   {
+      CFE_EVS_SendEvent (GPIO_DRV_CONFIG_OUT_EID, CFE_EVS_EventType_ERROR, 
+                         "GPIO chip %s output line request failed, errno %d", GpioDrv->ChipDev, errno);
+      return false;
+   }
+   
+   return true;
+   
+} /* End ChipConfigOut() */
+
+
+/******************************************************************************
+** Function: ChipConfigIn
+**
+** Request all input pins as lines of a single line request.
+**
+** Notes:
+**   1. An empty PinMask releases the lines without a new request.
+**
+*/
+static bool ChipConfigIn(uint64 PinMask)
+{
+   
+   if (GpioDrv->InLineFd >= 0)
+   {
+      close(GpioDrv->InLineFd);
+      GpioDrv->InLineFd = -1;
+   }
+   GpioDrv->InLineCnt = 0;
+   
+   if (PinMask == 0)
+   {
+      return true;
+   }
+   
+   GpioDrv->InLineFd = ChipRequestLines(PinMask, GPIO_V2_LINE_FLAG_INPUT, 
+                                        &GpioDrv->InLineCnt, GpioDrv->InLineIdx);
+   if (GpioDrv->InLineFd < 0)
+   {
+      CFE_EVS_SendEvent (GPIO_DRV_CONFIG_IN_EID, CFE_EVS_EventType_ERROR, 
+                         "GPIO chip %s input line request failed, errno %d", GpioDrv->ChipDev, errno);
+      return false;
+   }
+   
+   return true;
+   
+} /* End ChipConfigIn() */
+
+
+/******************************************************************************
+** Function: ChipWrite
+**
+** Notes:
+**   1. Set and cleared lines go out in one GPIO_V2_LINE_SET_VALUES_IOCTL.
+**   2. A failed ioctl is counted in WriteErrCnt, an event per write could
+**      flood EVS at the edge rate.
+**
+*/
+static void ChipWrite(uint64 SetMask, uint64 ClrMask)
+{
+   
+   struct gpio_v2_line_values Values;
+   
+   Values.bits = ChipLineBits(SetMask);
+   Values.mask = ChipLineBits(SetMask | ClrMask);
+   
+   if (ioctl(GpioDrv->OutLineFd, GPIO_V2_LINE_SET_VALUES_IOCTL, &Values) < 0)
+   {
+      GpioDrv->WriteErrCnt++;
+   }
+   
+} /* End ChipWrite() */
+
+
+/******************************************************************************
+** Function: ChipRead
+**
+*/
+static uint64 ChipRead(void)
+{
+   
+   return ChipGetLines(GpioDrv->OutLineFd, GpioDrv->OutLineCnt, GpioDrv->OutLineIdx, GpioDrv->OutMask);
+   
+} /* End ChipRead() */
+
+
+/******************************************************************************
+** Function: ChipReadIn
+**
+*/
+static uint64 ChipReadIn(void)
+{
+   
+   return ChipGetLines(GpioDrv->InLineFd, GpioDrv->InLineCnt, GpioDrv->InLineIdx, GpioDrv->InMask);
+   
+} /* End ChipReadIn() */
+
+
+/******************************************************************************
+** Function: ChipReadAll
+**
+*/
+static uint64 ChipReadAll(void)
+{
+   
+   return (ChipRead() | ChipReadIn());
+   
+} /* End ChipReadAll() */
+
+
+/******************************************************************************
+** Function: ChipLineBits
+**
+** Convert a pin mask into a line request bit mask
+**
+*/
+static uint64 ChipLineBits(uint64 PinMask)
+{
+   
+   uint64 LineBits = 0;
+   uint64 Pins = PinMask & GpioDrv->OutMask;
+   
+   while (Pins != 0)
+   {
+      LineBits |= GPIO_DRV_PIN_MASK(GpioDrv->OutLineIdx[__builtin_ctzll(Pins)]);
+      Pins &= Pins - 1;
+   }
+   
+   return LineBits;
+   
+} /* End ChipLineBits() */
+
+
+/******************************************************************************
+** Function: ChipGetLines
+**
+** Read a line request's values and return them as a pin mask
+**
+*/
+static uint64 ChipGetLines(int LineFd, uint8 LineCnt, const uint8* LineIdx, uint64 PinMask)
+{
+   
+   struct gpio_v2_line_values Values;
+   uint64 Level = 0;
+   uint64 Pins  = PinMask;
+   uint8  Pin;
+   
+   Values.bits = 0;
+   Values.mask = (LineCnt < 64) ? ((((uint64)1) << LineCnt) - 1) : UINT64_MAX;
+   
+   if (ioctl(LineFd, GPIO_V2_LINE_GET_VALUES_IOCTL, &Values) == 0)
+   {
+      while (Pins != 0)
+      {
+         Pin = __builtin_ctzll(Pins);
+         if (Values.bits & GPIO_DRV_PIN_MASK(LineIdx[Pin]))
+         {
+            Level |= GPIO_DRV_PIN_MASK(Pin);
+         }
+         Pins &= Pins - 1;
+      }
+   }
+   
+   return Level;
+   
+} /* End ChipGetLines() */
+
+
+/******************************************************************************
+** Function: ChipRequestLines
+**
+** Request the pins in PinMask as one line request and return its fd
+**
+** Notes:
+**   1. The GPIO number is used as the chip line offset which holds for the
+**      Pi's main GPIO chip.
+**   2. Lines are requested in ascending pin order and LineIdx maps each
+**      pin to its bit in the request's line value masks.
+**   3. Returns -1 with errno set on failure.
+**
+*/
+static int ChipRequestLines(uint64 PinMask, uint64 Flags, uint8* LineCnt, uint8* LineIdx)
+{
+   
+   struct gpio_v2_line_request LineReq;
+   uint64 Pins = PinMask;
+   uint8  Pin;
+   
+   memset(&LineReq, 0, sizeof(LineReq));
+   strncpy(LineReq.consumer, GPIO_DRV_CONSUMER, sizeof(LineReq.consumer)-1);
+   LineReq.config.flags = Flags;
+   
+   *LineCnt = 0;
+   while (Pins != 0)
+   {
+      Pin = __builtin_ctzll(Pins);
+      LineIdx[Pin] = *LineCnt;
+      LineReq.offsets[(*LineCnt)++] = Pin;
+      Pins &= Pins - 1;
+   }
+   LineReq.num_lines = *LineCnt;
+   
+   if (ioctl(GpioDrv->ChipFd, GPIO_V2_GET_LINE_IOCTL, &LineReq) < 0)
+   {
+      return -1;
+   }
+   
+   return LineReq.fd;
+   
+} /* End ChipRequestLines() */
+
+
+/******************************************************************************
+** Function: GatedRead
+**
+** Call a backend read function unless the backend is being mapped
+**
+** Notes:
+**   1. Level is set to 0 when the read is skipped.
+**
+*/
+static bool GatedRead(uint64 (*ReadFunc)(void), uint64* Level)
+{
+   
+   bool RetStatus = false;
+   
+   *Level = 0;
+   
+   __atomic_add_fetch(&GpioDrv->ReaderCnt, 1, __ATOMIC_SEQ_CST);
+   if (!__atomic_load_n(&GpioDrv->Mapping, __ATOMIC_SEQ_CST) && GpioDrv->IsMapped)
+   {
+      *Level = ReadFunc();
+      RetStatus = true;
+   }
+   __atomic_sub_fetch(&GpioDrv->ReaderCnt, 1, __ATOMIC_RELEASE);
+   
+   return RetStatus;
+   
+} /* End GatedRead() */
+
+
+/******************************************************************************
+** Function: MockMap
+**
+*/
+static bool MockMap(void)
+{
+   
+   GpioDrv->MockLevel = 0;
+   
+   return true;
+   
+} /* End MockMap() */
+
+
+/******************************************************************************
+** Function: MockUnmap
+**
+*/
+static void MockUnmap(void)
+{
+   
+   return;
+   
+} /* End MockUnmap() */
+
+
+/******************************************************************************
+** Function: MockConfigOut
+**
+*/
+static bool MockConfigOut(uint64 PinMask)
+{
+   
+   return true;
+   
+} /* End MockConfigOut() */
+
+
+/******************************************************************************
+** Function: MockConfigIn
+**
+*/
+static bool MockConfigIn(uint64 PinMask)
+{
+   
+   return true;
+   
+} /* End MockConfigIn() */
+
+
+/******************************************************************************
+** Function: MockWrite
+**
+*/
+static void MockWrite(uint64 SetMask, uint64 ClrMask)
+{
+   
+   GpioDrv->MockLevel = (GpioDrv->MockLevel | SetMask) & ~ClrMask;
+   
+} /* End MockWrite() */
+
+
+/******************************************************************************
+** Function: MockRead
+**
+*/
+static uint64 MockRead(void)
+{
+   
+   return GpioDrv->MockLevel;
+   
+} /* End MockRead() */
+
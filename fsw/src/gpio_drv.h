@@ -0,0 +1,305 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Define the GPIO Driver class
+**
+**  Notes:
+**    1. The driver hides the GPIO backend behind pin bit masks so the
+**       controller never deals with a specific interface. Bit N of a mask
+**       is GPIO N.
+**    2. Backends are selected by CTRL_GPIO_BACKEND in the ini file:
+**       - PI:   pi_iolib maps the peripherals and configures the pins.
+**               Writes go directly to the BCM283x GPSETn/GPCLRn registers
+**               mapped from /dev/gpiomem.
+**       - SIM:  CTRL_SIM_FILE is mapped in place of the register block. See
+**               GPIO_DRV_SimStatus_t.
+**       - CHIP: Linux GPIO character device (v2 uAPI) on CTRL_GPIO_CHIP.
+**               All output lines are held by one line request so a write
+**               of any number of pins is a single ioctl. No root access is
+**               needed.
+**       - MOCK: In-memory levels with no external side effects.
+**    3. Every write is timed and its latency is recorded in WriteHist so
+**       the backends can be compared on a target.
+**    4. Input pins are read by tasks other than the one that maps the
+**       backend. GPIO_DRV_Map() waits for in-progress GPIO_DRV_ReadIn() and
+**       GPIO_DRV_ReadAll() calls to finish before unmapping and reads that
+**       start during a map fail instead of waiting, so readers never block.
+**
+**  References:
+**    1. OpenSatKit Object-based Application Developer's Guide.
+**    2. cFS Application Developer's Guide.
+**    3. BCM2835 ARM Peripherals, Section 6 General Purpose I/O (GPIO)
+**    4. Linux include/uapi/linux/gpio.h
+**
+*/
+
+#ifndef _gpio_drv_
+#define _gpio_drv_
+
+/*
+** Includes
+*/
+
+#include "app_cfg.h"
+#include "lat_hist.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define GPIO_DRV_MAX_PIN   53    /* BCM283x exposes GPIO 0..53 in two 32-bit banks */
+
+#define GPIO_DRV_PIN_MASK(Pin)  (((uint64)1) << (Pin))
+
+#define GPIO_DRV_BACKEND_PI    0
+#define GPIO_DRV_BACKEND_SIM   1
+#define GPIO_DRV_BACKEND_CHIP  2
+#define GPIO_DRV_BACKEND_MOCK  3
+#define GPIO_DRV_BACKEND_CNT   4
+
+/*
+** Simulated register file
+** - Keeps the BCM283x register offsets, updates GPLEVn with the output
+**   levels and adds a GPIO_DRV_SimStatus_t at GPIO_DRV_SIM_STATUS_OFFSET
+*/
+
+#define GPIO_DRV_SIM_FILE_LEN       4096
+#define GPIO_DRV_SIM_STATUS_OFFSET  0x100
+#define GPIO_DRV_SIM_MAGIC          0x4750494F   /* "GPIO" */
+
+#define GPIO_DRV_CONSUMER  "gpio_demo"   /* GPIO chip line label */
+
+/*
+** Event Message IDs
+*/
+
+#define GPIO_DRV_CONSTRUCTOR_EID  (GPIO_DRV_BASE_EID + 0)
+#define GPIO_DRV_MAP_EID          (GPIO_DRV_BASE_EID + 1)
+#define GPIO_DRV_CONFIG_OUT_EID   (GPIO_DRV_BASE_EID + 2)
+#define GPIO_DRV_CONFIG_IN_EID    (GPIO_DRV_BASE_EID + 3)
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+
+/******************************************************************************
+** GPIO_DRV_SimStatus
+**
+** - Written by the simulated backend after each write
+** - Seq is odd while an update is in progress. Readers retry when Seq is odd
+**   or changes across their read.
+*/
+
+typedef struct
+{
+
+   uint32  Magic;
+   uint32  Seq;
+   uint32  WriteCnt;
+   uint32  Spare;
+   uint64  Level;        /* Output levels, bit N is GPIO N */
+   uint64  EdgeTimeNs;   /* CLOCK_MONOTONIC time of the last write */
+   
+} GPIO_DRV_SimStatus_t;
+
+
+/******************************************************************************
+** GPIO_DRV_Class
+*/
+
+typedef struct
+{
+
+   /*
+   ** Configuration
+   */
+   
+   uint8   Backend;
+   char    SimFile[OS_MAX_PATH_LEN];
+   char    ChipDev[OS_MAX_PATH_LEN];
+
+   /*
+   ** Class State Data
+   */
+
+   bool    IsMapped;
+   uint64  OutMask;       /* Configured output pins */
+   uint64  InMask;        /* Configured input pins, restored by each map */
+   bool    Mapping;       /* GPIO_DRV_Map() in progress */
+   uint32  ReaderCnt;     /* GPIO_DRV_ReadIn()/ReadAll() calls in progress */
+   uint32  WriteCnt;
+   uint32  WriteErrCnt;   /* Writes the backend reported as failed */
+   uint32  MapNs;         /* Duration of the last map */
+   
+   /* PI & SIM */
+   bool    PiIoMapped;    /* pi_iolib peripheral map, kept until the app exits */
+   volatile uint32* Reg;
+   volatile GPIO_DRV_SimStatus_t* SimStatus;
+
+   /* CHIP */
+   int     ChipFd;
+   int     OutLineFd;
+   uint8   OutLineCnt;
+   uint8   OutLineIdx[GPIO_DRV_MAX_PIN+1];  /* Line request index of each pin */
+   int     InLineFd;
+   uint8   InLineCnt;
+   uint8   InLineIdx[GPIO_DRV_MAX_PIN+1];
+
+   /* MOCK */
+   uint64  MockLevel;
+
+   LAT_HIST_Class_t WriteHist;
+   
+} GPIO_DRV_Class_t;
+
+
+/************************/
+/** Exported Functions **/
+/************************/
+
+
+/******************************************************************************
+** Function: GPIO_DRV_Constructor
+**
+** Initialize the GPIO Driver object and map the configured backend
+**
+** Notes:
+**   1. This must be called prior to any other function.
+**
+*/
+void GPIO_DRV_Constructor(GPIO_DRV_Class_t *GpioDrvPtr, INITBL_Class_t* IniTbl);
+
+
+/******************************************************************************
+** Function: GPIO_DRV_BackendStr
+**
+*/
+const char* GPIO_DRV_BackendStr(uint8 Backend);
+
+
+/******************************************************************************
+** Function: GPIO_DRV_ConfigIn
+**
+** Configure the pins in PinMask as inputs
+**
+** Notes:
+**   1. Replaces any previous input configuration. The pins are configured
+**      again after each GPIO_DRV_Map() so they may be set before the
+**      backend is mapped.
+**
+*/
+bool GPIO_DRV_ConfigIn(uint64 PinMask);
+
+
+/******************************************************************************
+** Function: GPIO_DRV_ConfigOut
+**
+** Configure the pins in PinMask as outputs
+**
+** Notes:
+**   1. Replaces any previous output configuration.
+**
+*/
+bool GPIO_DRV_ConfigOut(uint64 PinMask);
+
+
+/******************************************************************************
+** Function: GPIO_DRV_GetInMask
+**
+** Return the pins configured by GPIO_DRV_ConfigIn()
+**
+*/
+uint64 GPIO_DRV_GetInMask(void);
+
+
+/******************************************************************************
+** Function: GPIO_DRV_Map
+**
+** Map the backend's GPIO interface
+**
+** Notes:
+**   1. An already mapped backend is released and mapped again. The output
+**      pins must then be configured again with GPIO_DRV_ConfigOut().
+**
+*/
+bool GPIO_DRV_Map(void);
+
+
+/******************************************************************************
+** Function: GPIO_DRV_Read
+**
+** Return the pin levels, bit N is GPIO N
+**
+*/
+uint64 GPIO_DRV_Read(void);
+
+
+/******************************************************************************
+** Function: GPIO_DRV_ReadAll
+**
+** Read the level of every pin the backend can see into Level
+**
+** Notes:
+**   1. The register backends return the whole GPLEV register. The CHIP
+**      backend can only read requested lines so it returns the configured
+**      output and input pins.
+**   2. Same task and mapping rules as GPIO_DRV_ReadIn().
+**
+*/
+bool GPIO_DRV_ReadAll(uint64* Level);
+
+
+/******************************************************************************
+** Function: GPIO_DRV_ReadIn
+**
+** Read the input pin levels into Level, bit N is GPIO N
+**
+** Notes:
+**   1. Safe to call from a task other than the one that maps the backend.
+**   2. Returns false without waiting while the backend is being mapped or
+**      is unmapped.
+**
+*/
+bool GPIO_DRV_ReadIn(uint64* Level);
+
+
+/******************************************************************************
+** Function: GPIO_DRV_ResetStatus
+**
+** Notes:
+**   1. Must be called from the task that writes the GPIO.
+**
+*/
+void GPIO_DRV_ResetStatus(void);
+
+
+/******************************************************************************
+** Function: GPIO_DRV_Write
+**
+** Raise the pins in SetMask and lower the pins in ClrMask
+**
+** Notes:
+**   1. The caller must ensure the backend is mapped and the pins are
+**      configured outputs.
+**   2. Returns the monotonic time the write started.
+**
+*/
+uint64 GPIO_DRV_Write(uint64 SetMask, uint64 ClrMask);
+
+
+#endif /* _gpio_drv_ */
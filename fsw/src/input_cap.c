@@ -0,0 +1,402 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Implement the Input Capture class
+**
+**  Notes:
+**    1. Head and Tail are free running uint32 counters that are masked to
+**       index the ring so a full ring (Head - Tail == INPUT_CAP_RING_LEN)
+**       and an empty ring (Head == Tail) are distinguished without a
+**       spare entry.
+**    2. The sampler writes a record and then stores Head with release, the
+**       main task loads Head with acquire before reading records. The main
+**       task stores Tail with release after it has copied the records so
+**       the sampler's acquire load of Tail never lets it overwrite a
+**       record that is still being read.
+**    3. Records hold debounced levels. The first successful sample seeds
+**       the filter and is always recorded.
+**
+**  References:
+**    1. OpenSatKit Object-based Application Developer's Guide.
+**    2. cFS Application Developer's Guide.
+**
+*/
+
+/*
+** Include Files:
+*/
+
+#define _GNU_SOURCE    /* pthread_setaffinity_np() */
+
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/prctl.h>
+
+#include "gpio_drv.h"
+#include "input_cap.h"
+#include "mono_time.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define RING_MASK  (INPUT_CAP_RING_LEN - 1)
+
+
+/**********************/
+/** Global File Data **/
+/**********************/
+
+static INPUT_CAP_Class_t*  InputCap = NULL;
+
+
+/*******************************/
+/** Local Function Prototypes **/
+/*******************************/
+
+static bool ConfigPins(const char* PinList, uint64 OutPinMask);
+static void ConfigRealTime(void);
+static void PushRecord(uint64 TimeNs, uint64 Level);
+static void SendPkt(uint32 Tail);
+
+
+/******************************************************************************
+** Function: INPUT_CAP_Constructor
+**
+*/
+bool INPUT_CAP_Constructor(INPUT_CAP_Class_t *InputCapPtr, INITBL_Class_t* IniTbl,
+                           uint64 OutPinMask)
+{
+   
+   InputCap = InputCapPtr;
+   
+   memset(InputCap, 0, sizeof(INPUT_CAP_Class_t));
+   
+   InputCap->IniTbl    = IniTbl;
+   InputCap->Cpu       = INITBL_GetIntConfig(IniTbl, CFG_CAP_CPU);
+   InputCap->SampleNs  = INITBL_GetIntConfig(IniTbl, CFG_CAP_SAMPLE_US) * 1000;
+   InputCap->DebounceSamples = INITBL_GetIntConfig(IniTbl, CFG_CAP_DEBOUNCE_SAMPLES);
+   if (InputCap->SampleNs == 0)
+   {
+      InputCap->SampleNs = 1000;
+   }
+   
+   InputCap->InputEdgeTlmMid = CFE_SB_ValueToMsgId(INITBL_GetIntConfig(IniTbl, CFG_GPIO_DEMO_INPUT_EDGE_TLM_TOPICID));
+   
+   if (ConfigPins(INITBL_GetStrConfig(IniTbl, CFG_CAP_IN_PINS), OutPinMask))
+   {
+      GPIO_DRV_ConfigIn(InputCap->InMask);
+   }
+   else
+   {
+      InputCap->InMask   = 0;
+      InputCap->InPinCnt = 0;
+   }
+   
+   return (InputCap->InPinCnt > 0);
+   
+} /* End INPUT_CAP_Constructor() */
+
+
+/******************************************************************************
+** Function: INPUT_CAP_ResetStatus
+**
+** Notes:
+**   1. The sampler owns its counters so it is asked to clear them before
+**      its next sample instead of racing its increments from this task.
+**
+*/
+void INPUT_CAP_ResetStatus(void)
+{
+   
+   InputCap->RecordCnt = 0;
+   __atomic_store_n(&InputCap->ResetRequested, true, __ATOMIC_RELEASE);
+   
+} /* End INPUT_CAP_ResetStatus() */
+
+
+/******************************************************************************
+** Function: INPUT_CAP_SamplerTask
+**
+** Notes:
+**   1. Sample times are absolute deadlines. A sampler that wakes a full
+**      period or more late skips the missed samples instead of taking them
+**      back to back and counts them in OverrunCnt.
+**   2. GPIO_DRV_ReadIn() fails while the backend is being remapped. The
+**      sample is skipped and the next successful one records any change.
+**   3. A record is pushed when any debounced level changes. Raw changes
+**      that don't last CAP_DEBOUNCE_SAMPLES samples are only counted as
+**      glitches.
+**   4. A reset requested by INPUT_CAP_ResetStatus() is applied before the
+**      next sample.
+**
+*/
+bool INPUT_CAP_SamplerTask(CHILDMGR_Class_t* ChildMgr)
+{
+   
+   uint64 Level;
+   uint64 NowNs;
+   uint64 LateNs;
+   uint64 MissedCnt;
+   
+   if (!InputCap->SamplerStarted)
+   {
+      ConfigRealTime();
+      InputCap->NextSampleNs   = MONO_TIME_GetNs();
+      InputCap->SamplerStarted = true;
+   }
+   
+   MONO_TIME_SleepUntilNs(InputCap->NextSampleNs);
+   
+   if (__atomic_exchange_n(&InputCap->ResetRequested, false, __ATOMIC_ACQ_REL))
+   {
+      InputCap->SampleCnt   = 0;
+      InputCap->OverflowCnt = 0;
+      InputCap->OverrunCnt  = 0;
+      InputCap->Debounce.ChangeCnt = 0;
+      InputCap->Debounce.GlitchCnt = 0;
+   }
+   
+   NowNs = MONO_TIME_GetNs();
+   if (GPIO_DRV_ReadIn(&Level))
+   {
+      InputCap->SampleCnt++;
+      if (!InputCap->LevelValid)
+      {
+         DEBOUNCE_Constructor(&InputCap->Debounce, InputCap->DebounceSamples, Level);
+         PushRecord(NowNs, Level);
+         InputCap->LevelValid = true;
+      }
+      else if (DEBOUNCE_Update(&InputCap->Debounce, Level) != 0)
+      {
+         PushRecord(NowNs, InputCap->Debounce.Level);
+      }
+   }
+   
+   InputCap->NextSampleNs += InputCap->SampleNs;
+   if (NowNs >= InputCap->NextSampleNs)
+   {
+      LateNs    = NowNs - InputCap->NextSampleNs;
+      MissedCnt = LateNs / InputCap->SampleNs + 1;
+      InputCap->OverrunCnt   += MissedCnt;
+      InputCap->NextSampleNs += MissedCnt * InputCap->SampleNs;
+   }
+   
+   return !InputCap->StopRequested;
+   
+} /* End INPUT_CAP_SamplerTask() */
+
+
+/******************************************************************************
+** Function: INPUT_CAP_SendEdgeTlm
+**
+*/
+void INPUT_CAP_SendEdgeTlm(void)
+{
+   
+   GPIO_DEMO_InputEdgeTlm_Payload_t *Payload;
+   const INPUT_CAP_Record_t *Record;
+   uint32 Tail = InputCap->Tail;
+   uint32 Head = __atomic_load_n(&InputCap->Head, __ATOMIC_ACQUIRE);
+   
+   if (InputCap->PinErrno != 0 && !InputCap->PinReported)
+   {
+      CFE_EVS_SendEvent (INPUT_CAP_RT_CONFIG_EID, CFE_EVS_EventType_ERROR,
+                         "Failed to pin sampler task to CPU %u, errno %d", InputCap->Cpu, InputCap->PinErrno);
+      InputCap->PinReported = true;
+   }
+   
+   while (Tail != Head)
+   {
+      
+      Record = &InputCap->Ring[Tail & RING_MASK];
+      
+      if (InputCap->InputEdgeTlm == NULL)
+      {
+         InputCap->InputEdgeTlm = (GPIO_DEMO_InputEdgeTlm_t*)TLM_BUF_Alloc(TLM_BUF_MAIN_TASK, InputCap->InputEdgeTlmMid, sizeof(GPIO_DEMO_InputEdgeTlm_t));
+         InputCap->InputEdgeTlm->Payload.InPinCnt   = InputCap->InPinCnt;
+         InputCap->InputEdgeTlm->Payload.BaseTimeNs = Record->TimeNs;
+      }
+      Payload = &InputCap->InputEdgeTlm->Payload;
+      
+      if (Record->TimeNs - Payload->BaseTimeNs > UINT32_MAX)
+      {
+         SendPkt(Tail);
+         continue;
+      }
+      
+      Payload->Level[Payload->RecordCnt]    = Record->Level;
+      Payload->OffsetNs[Payload->RecordCnt] = (uint32)(Record->TimeNs - Payload->BaseTimeNs);
+      Payload->RecordCnt++;
+      Tail++;
+      
+      if (Payload->RecordCnt == INPUT_CAP_TLM_RECORDS)
+      {
+         SendPkt(Tail);
+      }
+   
+   } /* End record loop */
+   
+   if (InputCap->InputEdgeTlm != NULL)
+   {
+      SendPkt(Tail);
+   }
+   
+} /* End INPUT_CAP_SendEdgeTlm() */
+
+
+/******************************************************************************
+** Function: INPUT_CAP_Stop
+**
+*/
+void INPUT_CAP_Stop(void)
+{
+   
+   InputCap->StopRequested = true;
+   
+} /* End INPUT_CAP_Stop() */
+
+
+/******************************************************************************
+** Function: ConfigPins
+**
+** Parse the comma separated input pin list from the ini file.
+**
+** Notes:
+**   1. A pin may not be listed twice or be an output pin.
+**
+*/
+static bool ConfigPins(const char* PinList, uint64 OutPinMask)
+{
+   
+   const char* Next = PinList;
+   char*  End;
+   uint32 Pin;
+   
+   while (*Next != '\0')
+   {
+      
+      Pin = strtoul(Next, &End, 10);
+      if (End == Next || Pin > GPIO_DRV_MAX_PIN ||
+          ((InputCap->InMask | OutPinMask) & GPIO_DRV_PIN_MASK(Pin)) != 0)
+      {
+         CFE_EVS_SendEvent (INPUT_CAP_CONSTRUCTOR_EID, CFE_EVS_EventType_ERROR,
+                            "Invalid, duplicate or output pin in input pin list entry %d: '%s'",
+                            InputCap->InPinCnt, Next);
+         return false;
+      }
+      
+      InputCap->InMask |= GPIO_DRV_PIN_MASK(Pin);
+      InputCap->InPinCnt++;
+      
+      Next = End;
+      while (*Next == ',' || *Next == ' ')
+      {
+         Next++;
+      }
+   
+   } /* End pin list loop */
+   
+   return true;
+   
+} /* End ConfigPins() */
+
+
+/******************************************************************************
+** Function: ConfigRealTime
+**
+** Pin the calling (sampler) task to CAP_CPU and reduce its timer slack
+**
+** Notes:
+**   1. A failure is saved in PinErrno for the main task to report.
+**
+*/
+static void ConfigRealTime(void)
+{
+   
+   cpu_set_t CpuSet;
+   
+   prctl(PR_SET_TIMERSLACK, 1UL, 0UL, 0UL, 0UL);
+   
+   if (InputCap->Cpu < INPUT_CAP_CPU_ANY)
+   {
+      CPU_ZERO(&CpuSet);
+      CPU_SET(InputCap->Cpu, &CpuSet);
+      InputCap->PinErrno = pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &CpuSet);
+      if (InputCap->PinErrno == 0)
+      {
+         InputCap->RtStatus |= INPUT_CAP_RT_PINNED;
+      }
+   }
+   
+} /* End ConfigRealTime() */
+
+
+/******************************************************************************
+** Function: PushRecord
+**
+** Add a record to the ring or count it as an overflow if the ring is full
+**
+*/
+static void PushRecord(uint64 TimeNs, uint64 Level)
+{
+   
+   uint32 Head = InputCap->Head;
+   INPUT_CAP_Record_t *Record;
+   
+   if (Head - __atomic_load_n(&InputCap->Tail, __ATOMIC_ACQUIRE) >= INPUT_CAP_RING_LEN)
+   {
+      InputCap->OverflowCnt++;
+      return;
+   }
+   
+   Record = &InputCap->Ring[Head & RING_MASK];
+   Record->TimeNs = TimeNs;
+   Record->Level  = Level;
+   
+   __atomic_store_n(&InputCap->Head, Head + 1, __ATOMIC_RELEASE);
+   
+} /* End PushRecord() */
+
+
+/******************************************************************************
+** Function: SendPkt
+**
+** Send the current InputEdgeTlm packet and release its records
+**
+** Notes:
+**   1. Tail is the index after the packet's last record. The records have
+**      been copied so the sampler may reuse their ring entries.
+**   2. The packet belongs to the SB once it's sent so its record count is
+**      read first.
+**
+*/
+static void SendPkt(uint32 Tail)
+{
+   
+   GPIO_DEMO_InputEdgeTlm_Payload_t *Payload = &InputCap->InputEdgeTlm->Payload;
+   
+   __atomic_store_n(&InputCap->Tail, Tail, __ATOMIC_RELEASE);
+   
+   Payload->OverflowCnt = InputCap->OverflowCnt;
+   InputCap->RecordCnt += Payload->RecordCnt;
+   
+   TLM_BUF_Send((CFE_SB_Buffer_t*)InputCap->InputEdgeTlm);
+   InputCap->InputEdgeTlm = NULL;
+   
+} /* End SendPkt() */
@@ -0,0 +1,225 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Define the Input Capture class
+**
+**  Notes:
+**    1. A sampler child task reads the input pins every CAP_SAMPLE_US and
+**       pushes a timestamped record into a ring whenever a level changes.
+**       The main task drains the ring into InputEdgeTlm packets.
+**    2. The ring has a single producer (sampler) and a single consumer
+**       (main task). Each side owns its index and publishes it with a
+**       release store so neither side takes a lock or waits on the other.
+**    3. A full ring drops the new edge and counts it in OverflowCnt so the
+**       records that are sent are never overwritten. Up to
+**       INPUT_CAP_RING_LEN edges between drains are never lost.
+**
+**  References:
+**    1. OpenSatKit Object-based Application Developer's Guide.
+**    2. cFS Application Developer's Guide.
+**
+*/
+
+#ifndef _input_cap_
+#define _input_cap_
+
+/*
+** Includes
+*/
+
+#include "app_cfg.h"
+#include "childmgr.h"
+#include "debounce.h"
+#include "initbl.h"
+#include "tlm_buf.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define INPUT_CAP_RING_LEN     4096   /* Must be a power of 2 */
+#define INPUT_CAP_TLM_RECORDS  32     /* Must match the EDS InputEdgeTlm arrays */
+#define INPUT_CAP_CACHE_LINE   64
+
+#define INPUT_CAP_CPU_ANY      255
+#define INPUT_CAP_RT_PINNED    0x01   /* RtStatus bits */
+
+/*
+** Event Message IDs
+*/
+
+#define INPUT_CAP_CONSTRUCTOR_EID  (INPUT_CAP_BASE_EID + 0)
+#define INPUT_CAP_RT_CONFIG_EID    (INPUT_CAP_BASE_EID + 1)
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+
+/******************************************************************************
+** Edge record
+*/
+
+typedef struct
+{
+
+   uint64  TimeNs;   /* CLOCK_MONOTONIC time of the sample that saw the edge */
+   uint64  Level;    /* Input levels, bit N is GPIO N */
+
+} INPUT_CAP_Record_t;
+
+
+/******************************************************************************
+** Class
+**
+** - Head is only written by the sampler and Tail only by the main task.
+**   They are kept on separate cache lines so each side's stores don't
+**   invalidate the line the other side polls.
+*/
+
+typedef struct
+{
+
+   /*
+   ** Framework References
+   */
+
+   INITBL_Class_t*  IniTbl;
+
+   /*
+   ** Telemetry Packets
+   */
+
+   CFE_SB_MsgId_t  InputEdgeTlmMid;
+   GPIO_DEMO_InputEdgeTlm_t* InputEdgeTlm;   /* TLM_BUF packet being filled, NULL when none */
+
+   /*
+   ** Configuration
+   */
+
+   uint64  InMask;
+   uint16  InPinCnt;
+   uint16  Cpu;
+   uint32  SampleNs;
+   uint8   DebounceSamples;
+
+   /*
+   ** Sampler state, written by the sampler task
+   */
+
+   bool    SamplerStarted;
+   bool    StopRequested;
+   bool    ResetRequested;   /* Set by INPUT_CAP_ResetStatus(), applied by the sampler */
+   uint8   RtStatus;
+   int     PinErrno;         /* Reported by the main task, the sampler sends no events */
+   uint64  NextSampleNs;
+   bool    LevelValid;       /* Debounce holds the levels of a sample */
+   DEBOUNCE_Class_t  Debounce;
+   uint32  SampleCnt;
+   uint32  OverflowCnt;
+   uint32  OverrunCnt;
+
+   /*
+   ** Main task state
+   */
+
+   bool    PinReported;
+   uint32  RecordCnt;
+
+   /*
+   ** Ring
+   */
+
+   uint32  Head __attribute__((aligned(INPUT_CAP_CACHE_LINE)));   /* Next record written */
+   uint32  Tail __attribute__((aligned(INPUT_CAP_CACHE_LINE)));   /* Next record read    */
+
+   INPUT_CAP_Record_t Ring[INPUT_CAP_RING_LEN] __attribute__((aligned(INPUT_CAP_CACHE_LINE)));
+
+} INPUT_CAP_Class_t;
+
+
+/************************/
+/** Exported Functions **/
+/************************/
+
+
+/******************************************************************************
+** Function: INPUT_CAP_Constructor
+**
+** Initialize the Input Capture object to a known state
+**
+** Notes:
+**   1. This must be called prior to any other function.
+**   2. OutPinMask are the controller's output pins, an input pin may not
+**      be one of them.
+**   3. Returns true if CAP_IN_PINS lists any valid input pins. The sampler
+**      task should only be created if it does.
+**
+*/
+bool INPUT_CAP_Constructor(INPUT_CAP_Class_t *InputCapPtr, INITBL_Class_t* IniTbl,
+                           uint64 OutPinMask);
+
+
+/******************************************************************************
+** Function: INPUT_CAP_ResetStatus
+**
+** Reset counters and status flags to a known reset state.
+**
+** Notes:
+**   1. Any counter or variable that is reported in HK telemetry that doesn't
+**      change the functional behavior should be reset.
+**
+*/
+void INPUT_CAP_ResetStatus(void);
+
+
+/******************************************************************************
+** Function: INPUT_CAP_SamplerTask
+**
+** Take one input sample, called in a loop by the sampler child task
+**
+** Notes:
+**   1. Returns false when the task should exit.
+**
+*/
+bool INPUT_CAP_SamplerTask(CHILDMGR_Class_t* ChildMgr);
+
+
+/******************************************************************************
+** Function: INPUT_CAP_SendEdgeTlm
+**
+** Drain the ring into InputEdgeTlm packets
+**
+** Notes:
+**   1. Only called from the main task.
+**   2. A packet holds up to INPUT_CAP_TLM_RECORDS records that are within
+**      a uint32 nanosecond offset of its first record.
+**
+*/
+void INPUT_CAP_SendEdgeTlm(void);
+
+
+/******************************************************************************
+** Function: INPUT_CAP_Stop
+**
+** Request the sampler task to exit after its next sample
+**
+*/
+void INPUT_CAP_Stop(void);
+
+
+#endif /* _input_cap_ */
@@ -0,0 +1,178 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Implement the latency histogram methods
+**
+**  Notes:
+**    1. See lat_hist.h for the bucket layout.
+**
+**  References:
+**    1. OpenSatKit Object-based Application Developer's Guide.
+**    2. cFS Application Developer's Guide.
+**
+*/
+
+/*
+** Include Files:
+*/
+
+#include <string.h>
+
+#include "lat_hist.h"
+
+
+/*******************************/
+/** Local Function Prototypes **/
+/*******************************/
+
+static uint16 BucketIndex(uint64 ValueNs);
+
+
+/******************************************************************************
+** Function: LAT_HIST_Constructor
+**
+*/
+void LAT_HIST_Constructor(LAT_HIST_Class_t* LatHist)
+{
+   
+   LAT_HIST_Reset(LatHist);
+   
+} /* End LAT_HIST_Constructor() */
+
+
+/******************************************************************************
+** Function: LAT_HIST_AddSample
+**
+*/
+void LAT_HIST_AddSample(LAT_HIST_Class_t* LatHist, int64 ValueNs)
+{
+   
+   uint64 Value = 0;
+   
+   if (ValueNs < 0)
+   {
+      LatHist->NegativeCnt++;
+   }
+   else
+   {
+      Value = (uint64)ValueNs;
+   }
+   
+   if (Value < LatHist->MinNs)
+   {
+      LatHist->MinNs = Value;
+   }
+   if (Value > LatHist->MaxNs)
+   {
+      LatHist->MaxNs = Value;
+   }
+   
+   LatHist->Bucket[BucketIndex(Value)]++;
+   LatHist->SampleCnt++;
+   
+} /* End LAT_HIST_AddSample() */
+
+
+/******************************************************************************
+** Function: LAT_HIST_BucketLowerNs
+**
+*/
+uint64 LAT_HIST_BucketLowerNs(uint16 BucketIdx)
+{
+   
+   uint64 LowerNs = BucketIdx;
+   uint16 Group   = BucketIdx >> LAT_HIST_SUB_BITS;
+   
+   if (Group > 0)
+   {
+      LowerNs = ((uint64)(LAT_HIST_SUB_CNT + (BucketIdx & (LAT_HIST_SUB_CNT-1)))) << (Group-1);
+   }
+   
+   return LowerNs;
+   
+} /* End LAT_HIST_BucketLowerNs() */
+
+
+/******************************************************************************
+** Function: LAT_HIST_GetPercentile
+**
+*/
+uint64 LAT_HIST_GetPercentile(const LAT_HIST_Class_t* LatHist, uint16 PerMille)
+{
+   
+   uint64 Target;
+   uint64 CumCnt = 0;
+   uint64 UpperNs = 0;
+   uint16 i;
+   
+   if (LatHist->SampleCnt == 0)
+   {
+      return 0;
+   }
+   
+   Target = ((uint64)LatHist->SampleCnt * PerMille + 999) / 1000;
+   
+   for (i=0; i < LAT_HIST_BUCKET_CNT; i++)
+   {
+      CumCnt += LatHist->Bucket[i];
+      if (CumCnt >= Target)
+      {
+         UpperNs = (i+1 < LAT_HIST_BUCKET_CNT) ? LAT_HIST_BucketLowerNs(i+1) - 1 : LatHist->MaxNs;
+         break;
+      }
+   }
+   
+   return (UpperNs < LatHist->MaxNs) ? UpperNs : LatHist->MaxNs;
+   
+} /* End LAT_HIST_GetPercentile() */
+
+
+/******************************************************************************
+** Function: LAT_HIST_Reset
+**
+*/
+void LAT_HIST_Reset(LAT_HIST_Class_t* LatHist)
+{
+   
+   memset(LatHist, 0, sizeof(LAT_HIST_Class_t));
+   LatHist->MinNs = UINT64_MAX;
+   
+} /* End LAT_HIST_Reset() */
+
+
+/******************************************************************************
+** Function: BucketIndex
+**
+*/
+static uint16 BucketIndex(uint64 ValueNs)
+{
+   
+   uint16 Msb;
+   
+   if (ValueNs < LAT_HIST_SUB_CNT)
+   {
+      return (uint16)ValueNs;
+   }
+   if (ValueNs >= (((uint64)1) << LAT_HIST_MAX_BITS))
+   {
+      return LAT_HIST_BUCKET_CNT - 1;
+   }
+   
+   Msb = 63 - __builtin_clzll(ValueNs);
+   
+   return ((Msb - LAT_HIST_SUB_BITS + 1) << LAT_HIST_SUB_BITS) +
+          ((ValueNs >> (Msb - LAT_HIST_SUB_BITS)) & (LAT_HIST_SUB_CNT - 1));
+   
+} /* End BucketIndex() */
@@ -0,0 +1,130 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Define a fixed memory, log bucketed latency histogram
+**
+**  Notes:
+**    1. Values are nanoseconds. Values below LAT_HIST_SUB_CNT have their own
+**       bucket and each power of two above that is split into
+**       LAT_HIST_SUB_CNT linear sub-buckets, so the relative bucket error
+**       is at most 1/LAT_HIST_SUB_CNT. Values of 2^LAT_HIST_MAX_BITS or
+**       more are counted in the last bucket.
+**    2. Multiple instances can be declared. A histogram has a single writer
+**       and readers accept that a snapshot may be mid-update.
+**
+**  References:
+**    1. OpenSatKit Object-based Application Developer's Guide.
+**    2. cFS Application Developer's Guide.
+**
+*/
+
+#ifndef _lat_hist_
+#define _lat_hist_
+
+/*
+** Includes
+*/
+
+#include "app_cfg.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define LAT_HIST_SUB_BITS  3
+#define LAT_HIST_SUB_CNT   (1 << LAT_HIST_SUB_BITS)
+#define LAT_HIST_MAX_BITS  36     /* ~68 seconds */
+
+#define LAT_HIST_BUCKET_CNT  ((LAT_HIST_MAX_BITS - LAT_HIST_SUB_BITS + 1) * LAT_HIST_SUB_CNT)
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+
+/******************************************************************************
+** LAT_HIST_Class
+*/
+
+typedef struct
+{
+
+   uint32  SampleCnt;
+   uint32  NegativeCnt;   /* Samples clamped to 0 */
+   uint64  MinNs;
+   uint64  MaxNs;
+
+   uint32  Bucket[LAT_HIST_BUCKET_CNT];
+   
+} LAT_HIST_Class_t;
+
+
+/************************/
+/** Exported Functions **/
+/************************/
+
+
+/******************************************************************************
+** Function: LAT_HIST_Constructor
+**
+** Initialize a latency histogram to an empty state
+**
+*/
+void LAT_HIST_Constructor(LAT_HIST_Class_t* LatHist);
+
+
+/******************************************************************************
+** Function: LAT_HIST_AddSample
+**
+** Notes:
+**   1. Constant time with no loops so it can be used on timing paths.
+**
+*/
+void LAT_HIST_AddSample(LAT_HIST_Class_t* LatHist, int64 ValueNs);
+
+
+/******************************************************************************
+** Function: LAT_HIST_BucketLowerNs
+**
+** Return the smallest value counted in bucket BucketIdx
+**
+*/
+uint64 LAT_HIST_BucketLowerNs(uint16 BucketIdx);
+
+
+/******************************************************************************
+** Function: LAT_HIST_GetPercentile
+**
+** Return the value (nanoseconds) at or below which PerMille/1000 of the
+** samples fall.
+**
+** Notes:
+**   1. The result is the upper bound of the bucket holding the percentile
+**      limited to the maximum sample. 0 is returned for an empty histogram.
+**
+*/
+uint64 LAT_HIST_GetPercentile(const LAT_HIST_Class_t* LatHist, uint16 PerMille);
+
+
+/******************************************************************************
+** Function: LAT_HIST_Reset
+**
+*/
+void LAT_HIST_Reset(LAT_HIST_Class_t* LatHist);
+
+
+#endif /* _lat_hist_ */
@@ -0,0 +1,561 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Implement the Logic Capture class
+**
+**  Notes:
+**    1. Request is the only field both tasks write. The main task only
+**       posts a request when Request is LOGIC_CAP_REQ_NONE and stores it
+**       with release after the request parameters. The child task clears
+**       it with release after it has read the parameters.
+**    2. The arena always keeps LOGIC_CAP_MAX_RUN_LEN bytes free so the run
+**       being counted can be written when the capture stops.
+**
+**  References:
+**    1. OpenSatKit Object-based Application Developer's Guide.
+**    2. cFS Application Developer's Guide.
+**
+*/
+
+/*
+** Include Files:
+*/
+
+#include <string.h>
+#include <errno.h>
+
+#include "gpio_drv.h"
+#include "logic_cap.h"
+#include "mono_time.h"
+
+
+/**********************/
+/** Global File Data **/
+/**********************/
+
+static LOGIC_CAP_Class_t*  LogicCap = NULL;
+
+
+/*******************************/
+/** Local Function Prototypes **/
+/*******************************/
+
+static void AddSamples(uint64 Level, uint32 Samples);
+static void EndCapture(bool ArenaFull);
+static void EndDump(const char* Reason);
+static void EndRun(void);
+static bool PostRequest(uint8 Request);
+static void ProcessRequest(uint8 Request);
+static void PutVarint(uint64 Value);
+static void StartCapture(void);
+static void StartDump(void);
+static void TakeSample(void);
+static void WriteDumpChunk(void);
+
+
+/******************************************************************************
+** Function: LOGIC_CAP_Constructor
+**
+*/
+void LOGIC_CAP_Constructor(LOGIC_CAP_Class_t *LogicCapPtr, INITBL_Class_t* IniTbl)
+{
+   
+   LogicCap = LogicCapPtr;
+   
+   memset(LogicCap, 0, sizeof(LOGIC_CAP_Class_t));
+   
+   LogicCap->IniTbl = IniTbl;
+   sem_init(&LogicCap->WakeSem, 0, 0);
+   
+   memcpy(LogicCap->Hdr.Id, LOGIC_CAP_FILE_ID, sizeof(LogicCap->Hdr.Id));
+   LogicCap->Hdr.Version = LOGIC_CAP_FILE_VERSION;
+   LogicCap->Hdr.HdrLen  = sizeof(LOGIC_CAP_FileHdr_t);
+   
+} /* End LOGIC_CAP_Constructor() */
+
+
+/******************************************************************************
+** Function: LOGIC_CAP_ChildTask
+**
+*/
+bool LOGIC_CAP_ChildTask(CHILDMGR_Class_t* ChildMgr)
+{
+   
+   uint8 Request = __atomic_load_n(&LogicCap->Request, __ATOMIC_ACQUIRE);
+   
+   if (Request != LOGIC_CAP_REQ_NONE)
+   {
+      ProcessRequest(Request);
+      __atomic_store_n(&LogicCap->Request, LOGIC_CAP_REQ_NONE, __ATOMIC_RELEASE);
+   }
+   
+   if (LogicCap->State == LOGIC_CAP_RUNNING)
+   {
+      TakeSample();
+   }
+   else if (LogicCap->State == LOGIC_CAP_DUMPING)
+   {
+      WriteDumpChunk();
+   }
+   else
+   {
+      while (sem_wait(&LogicCap->WakeSem) != 0 && errno == EINTR);
+   }
+   
+   return !LogicCap->StopRequested;
+   
+} /* End LOGIC_CAP_ChildTask() */
+
+
+/******************************************************************************
+** Function: LOGIC_CAP_DumpCmd
+**
+*/
+bool LOGIC_CAP_DumpCmd(void* DataObjPtr, const CFE_MSG_Message_t *MsgPtr)
+{
+   
+   const GPIO_DEMO_DumpLogicCap_Payload_t *Cmd = CMDMGR_PAYLOAD_PTR(MsgPtr, GPIO_DEMO_DumpLogicCap_t);
+   bool RetStatus = false;
+   
+   if (__atomic_load_n(&LogicCap->State, __ATOMIC_ACQUIRE) != LOGIC_CAP_IDLE ||
+       LogicCap->Hdr.SampleCnt == 0)
+   {
+      CFE_EVS_SendEvent (LOGIC_CAP_DUMP_EID, CFE_EVS_EventType_ERROR,
+                         "Logic capture dump rejected, a capture must be stopped and not empty");
+   }
+   else if (LogicCap->Request != LOGIC_CAP_REQ_NONE)
+   {
+      CFE_EVS_SendEvent (LOGIC_CAP_DUMP_EID, CFE_EVS_EventType_ERROR,
+                         "Logic capture dump rejected, previous logic capture command still pending");
+   }
+   else
+   {
+      strncpy(LogicCap->ReqFilename, Cmd->Filename, OS_MAX_PATH_LEN-1);
+      LogicCap->ReqFilename[OS_MAX_PATH_LEN-1] = '\0';
+      RetStatus = PostRequest(LOGIC_CAP_REQ_DUMP);
+   }
+   
+   return RetStatus;
+   
+} /* End LOGIC_CAP_DumpCmd() */
+
+
+/******************************************************************************
+** Function: LOGIC_CAP_StartCmd
+**
+*/
+bool LOGIC_CAP_StartCmd(void* DataObjPtr, const CFE_MSG_Message_t *MsgPtr)
+{
+   
+   const GPIO_DEMO_StartLogicCap_Payload_t *Cmd = CMDMGR_PAYLOAD_PTR(MsgPtr, GPIO_DEMO_StartLogicCap_t);
+   bool RetStatus = false;
+   
+   if (Cmd->SampleUs == 0 || Cmd->SampleUs > LOGIC_CAP_MAX_SAMPLE_US)
+   {
+      CFE_EVS_SendEvent (LOGIC_CAP_START_EID, CFE_EVS_EventType_ERROR,
+                         "Invalid logic capture sample period %u us, must be 1 to %u",
+                         Cmd->SampleUs, LOGIC_CAP_MAX_SAMPLE_US);
+   }
+   else if (__atomic_load_n(&LogicCap->State, __ATOMIC_ACQUIRE) != LOGIC_CAP_IDLE ||
+            LogicCap->Request != LOGIC_CAP_REQ_NONE)
+   {
+      CFE_EVS_SendEvent (LOGIC_CAP_START_EID, CFE_EVS_EventType_ERROR,
+                         "Logic capture start rejected, a capture or dump is in progress");
+   }
+   else
+   {
+      LogicCap->ReqSampleNs = Cmd->SampleUs * 1000;
+      RetStatus = PostRequest(LOGIC_CAP_REQ_START);
+   }
+   
+   return RetStatus;
+   
+} /* End LOGIC_CAP_StartCmd() */
+
+
+/******************************************************************************
+** Function: LOGIC_CAP_Stop
+**
+*/
+void LOGIC_CAP_Stop(void)
+{
+   
+   LogicCap->StopRequested = true;
+   sem_post(&LogicCap->WakeSem);
+   
+} /* End LOGIC_CAP_Stop() */
+
+
+/******************************************************************************
+** Function: LOGIC_CAP_StopCmd
+**
+*/
+bool LOGIC_CAP_StopCmd(void* DataObjPtr, const CFE_MSG_Message_t *MsgPtr)
+{
+   
+   bool RetStatus = false;
+   
+   if (__atomic_load_n(&LogicCap->State, __ATOMIC_ACQUIRE) == LOGIC_CAP_IDLE &&
+       LogicCap->Request == LOGIC_CAP_REQ_NONE)
+   {
+      CFE_EVS_SendEvent (LOGIC_CAP_STOP_EID, CFE_EVS_EventType_ERROR,
+                         "Logic capture stop rejected, no capture or dump in progress");
+   }
+   else if (LogicCap->Request != LOGIC_CAP_REQ_NONE)
+   {
+      CFE_EVS_SendEvent (LOGIC_CAP_STOP_EID, CFE_EVS_EventType_ERROR,
+                         "Logic capture stop rejected, previous logic capture command still pending");
+   }
+   else
+   {
+      RetStatus = PostRequest(LOGIC_CAP_REQ_STOP);
+   }
+   
+   return RetStatus;
+   
+} /* End LOGIC_CAP_StopCmd() */
+
+
+/******************************************************************************
+** Function: AddSamples
+**
+** Count Samples samples of Level, ending the current run if Level changed
+**
+*/
+static void AddSamples(uint64 Level, uint32 Samples)
+{
+   
+   if (LogicCap->RunSamples > 0 && Level == LogicCap->RunLevel &&
+       Samples <= UINT32_MAX - LogicCap->RunSamples)
+   {
+      LogicCap->RunSamples += Samples;
+   }
+   else
+   {
+      if (LogicCap->RunSamples > 0)
+      {
+         if (LogicCap->ArenaUsed + 2*LOGIC_CAP_MAX_RUN_LEN > LOGIC_CAP_ARENA_BYTES)
+         {
+            EndCapture(true);
+            return;
+         }
+         EndRun();
+      }
+      LogicCap->RunXor     = Level ^ LogicCap->RunLevel;
+      LogicCap->RunLevel   = Level;
+      LogicCap->RunSamples = Samples;
+   }
+   
+   LogicCap->Hdr.SampleCnt += Samples;
+   
+} /* End AddSamples() */
+
+
+/******************************************************************************
+** Function: EndCapture
+**
+*/
+static void EndCapture(bool ArenaFull)
+{
+   
+   if (LogicCap->RunSamples > 0)
+   {
+      EndRun();
+   }
+   
+   LogicCap->ArenaFull   = ArenaFull;
+   LogicCap->Hdr.ByteCnt = LogicCap->ArenaUsed;
+   __atomic_store_n(&LogicCap->State, LOGIC_CAP_IDLE, __ATOMIC_RELEASE);
+   
+   CFE_EVS_SendEvent (LOGIC_CAP_STOP_EID, CFE_EVS_EventType_INFORMATION,
+                      "Logic capture %s after %llu samples, %u runs in %u bytes",
+                      ArenaFull ? "filled its arena" : "stopped",
+                      (unsigned long long)LogicCap->Hdr.SampleCnt, LogicCap->Hdr.RunCnt, LogicCap->ArenaUsed);
+   
+} /* End EndCapture() */
+
+
+/******************************************************************************
+** Function: EndDump
+**
+** Close the dump file and report why the dump ended
+**
+** Notes:
+**   1. Reason is NULL when the whole capture was written.
+**
+*/
+static void EndDump(const char* Reason)
+{
+   
+   OS_close(LogicCap->DumpFile);
+   __atomic_store_n(&LogicCap->State, LOGIC_CAP_IDLE, __ATOMIC_RELEASE);
+   
+   if (Reason == NULL)
+   {
+      LogicCap->DumpCnt++;
+      CFE_EVS_SendEvent (LOGIC_CAP_DUMP_EID, CFE_EVS_EventType_INFORMATION,
+                         "Logic capture dumped to %s, %u bytes", LogicCap->ReqFilename,
+                         (unsigned int)(LogicCap->Hdr.HdrLen + LogicCap->DumpByteCnt));
+   }
+   else
+   {
+      CFE_EVS_SendEvent (LOGIC_CAP_DUMP_EID, CFE_EVS_EventType_ERROR,
+                         "Logic capture dump to %s %s after %u bytes", LogicCap->ReqFilename,
+                         Reason, LogicCap->DumpByteCnt);
+   }
+   
+} /* End EndDump() */
+
+
+/******************************************************************************
+** Function: EndRun
+**
+** Append the run being counted to the arena
+**
+*/
+static void EndRun(void)
+{
+   
+   PutVarint(LogicCap->RunXor);
+   PutVarint(LogicCap->RunSamples);
+   LogicCap->Hdr.RunCnt++;
+   
+} /* End EndRun() */
+
+
+/******************************************************************************
+** Function: PostRequest
+**
+** Notes:
+**   1. The caller has checked that no request is pending.
+**
+*/
+static bool PostRequest(uint8 Request)
+{
+   
+   __atomic_store_n(&LogicCap->Request, Request, __ATOMIC_RELEASE);
+   sem_post(&LogicCap->WakeSem);
+   
+   return true;
+   
+} /* End PostRequest() */
+
+
+/******************************************************************************
+** Function: ProcessRequest
+**
+** Notes:
+**   1. The commands validated the state but the child task is the only
+**      task that changes it, so requests are checked again here.
+**
+*/
+static void ProcessRequest(uint8 Request)
+{
+   
+   switch (Request)
+   {
+   
+      case LOGIC_CAP_REQ_START:
+         if (LogicCap->State == LOGIC_CAP_IDLE)
+         {
+            StartCapture();
+         }
+         break;
+   
+      case LOGIC_CAP_REQ_STOP:
+         if (LogicCap->State == LOGIC_CAP_RUNNING)
+         {
+            EndCapture(false);
+         }
+         else if (LogicCap->State == LOGIC_CAP_DUMPING)
+         {
+            EndDump("aborted");
+         }
+         break;
+   
+      case LOGIC_CAP_REQ_DUMP:
+         if (LogicCap->State == LOGIC_CAP_IDLE)
+         {
+            StartDump();
+         }
+         break;
+   
+      default:
+         break;
+   
+   } /* End request switch */
+   
+} /* End ProcessRequest() */
+
+
+/******************************************************************************
+** Function: PutVarint
+**
+** Append Value to the arena as an unsigned LEB128 varint
+**
+*/
+static void PutVarint(uint64 Value)
+{
+   
+   while (Value >= 0x80)
+   {
+      LogicCap->Arena[LogicCap->ArenaUsed++] = (uint8)(Value | 0x80);
+      Value >>= 7;
+   }
+   LogicCap->Arena[LogicCap->ArenaUsed++] = (uint8)Value;
+   
+} /* End PutVarint() */
+
+
+/******************************************************************************
+** Function: StartCapture
+**
+*/
+static void StartCapture(void)
+{
+   
+   LogicCap->ArenaUsed  = 0;
+   LogicCap->ArenaFull  = false;
+   LogicCap->RunLevel   = 0;
+   LogicCap->RunXor     = 0;
+   LogicCap->RunSamples = 0;
+   
+   LogicCap->Hdr.SampleNs    = LogicCap->ReqSampleNs;
+   LogicCap->Hdr.ByteCnt     = 0;
+   LogicCap->Hdr.SampleCnt   = 0;
+   LogicCap->Hdr.RunCnt      = 0;
+   LogicCap->Hdr.OverrunCnt  = 0;
+   LogicCap->Hdr.StartTimeNs = MONO_TIME_GetNs();
+   LogicCap->NextSampleNs    = LogicCap->Hdr.StartTimeNs;
+   
+   __atomic_store_n(&LogicCap->State, LOGIC_CAP_RUNNING, __ATOMIC_RELEASE);
+   
+   CFE_EVS_SendEvent (LOGIC_CAP_START_EID, CFE_EVS_EventType_INFORMATION,
+                      "Logic capture started, %u us sample period, %u byte arena",
+                      LogicCap->ReqSampleNs/1000, LOGIC_CAP_ARENA_BYTES);
+   
+} /* End StartCapture() */
+
+
+/******************************************************************************
+** Function: StartDump
+**
+*/
+static void StartDump(void)
+{
+   
+   int32 SysStatus;
+   
+   SysStatus = OS_OpenCreate(&LogicCap->DumpFile, LogicCap->ReqFilename,
+                             OS_FILE_FLAG_CREATE | OS_FILE_FLAG_TRUNCATE, OS_READ_WRITE);
+   
+   if (SysStatus == OS_SUCCESS)
+   {
+      LogicCap->DumpByteCnt = 0;
+      __atomic_store_n(&LogicCap->State, LOGIC_CAP_DUMPING, __ATOMIC_RELEASE);
+      if (OS_write(LogicCap->DumpFile, &LogicCap->Hdr, sizeof(LOGIC_CAP_FileHdr_t)) != sizeof(LOGIC_CAP_FileHdr_t))
+      {
+         EndDump("failed writing the header");
+      }
+   }
+   else
+   {
+      CFE_EVS_SendEvent (LOGIC_CAP_DUMP_EID, CFE_EVS_EventType_ERROR,
+                         "Error creating logic capture dump file '%s', status=0x%08X",
+                         LogicCap->ReqFilename, SysStatus);
+   }
+   
+} /* End StartDump() */
+
+
+/******************************************************************************
+** Function: TakeSample
+**
+** Notes:
+**   1. Samples are taken on absolute deadlines. Periods missed because the
+**      task was late are recorded as holding the previous levels so sample
+**      N is always at StartTimeNs + N*SampleNs.
+**   2. A read that fails while the backend is being remapped also holds
+**      the previous levels.
+**
+*/
+static void TakeSample(void)
+{
+   
+   uint64 Level;
+   uint64 NowNs;
+   uint64 Missed;
+   
+   MONO_TIME_SleepUntilNs(LogicCap->NextSampleNs);
+   
+   NowNs = MONO_TIME_GetNs();
+   if (NowNs >= LogicCap->NextSampleNs + LogicCap->Hdr.SampleNs && LogicCap->RunSamples > 0)
+   {
+      Missed = (NowNs - LogicCap->NextSampleNs) / LogicCap->Hdr.SampleNs;
+      if (Missed > UINT32_MAX)
+      {
+         Missed = UINT32_MAX;
+      }
+      LogicCap->Hdr.OverrunCnt += Missed;
+      LogicCap->NextSampleNs   += Missed * LogicCap->Hdr.SampleNs;
+      AddSamples(LogicCap->RunLevel, (uint32)Missed);
+   }
+   
+   if (!GPIO_DRV_ReadAll(&Level))
+   {
+      Level = LogicCap->RunLevel;
+   }
+   
+   if (LogicCap->State == LOGIC_CAP_RUNNING)
+   {
+      AddSamples(Level, 1);
+   }
+   LogicCap->NextSampleNs += LogicCap->Hdr.SampleNs;
+   
+} /* End TakeSample() */
+
+
+/******************************************************************************
+** Function: WriteDumpChunk
+**
+** Write up to LOGIC_CAP_DUMP_CHUNK arena bytes to the dump file
+**
+*/
+static void WriteDumpChunk(void)
+{
+   
+   uint32 Len = LogicCap->Hdr.ByteCnt - LogicCap->DumpByteCnt;
+   
+   if (Len > LOGIC_CAP_DUMP_CHUNK)
+   {
+      Len = LOGIC_CAP_DUMP_CHUNK;
+   }
+   
+   if (Len > 0)
+   {
+      if (OS_write(LogicCap->DumpFile, &LogicCap->Arena[LogicCap->DumpByteCnt], Len) != (int32)Len)
+      {
+         EndDump("failed");
+         return;
+      }
+      LogicCap->DumpByteCnt += Len;
+   }
+   
+   if (LogicCap->DumpByteCnt == LogicCap->Hdr.ByteCnt)
+   {
+      EndDump(NULL);
+   }
+   
+} /* End WriteDumpChunk() */
@@ -0,0 +1,233 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Define the Logic Capture class
+**
+**  Notes:
+**    1. A logic analyzer for field debugging. While capturing, the logic
+**       child task samples every pin level (GPIO_DRV_ReadAll()) at a fixed
+**       rate and run-length encodes the samples into a fixed arena. A run
+**       is only written when the levels change so a long capture of slow
+**       signals uses little memory.
+**    2. Commands run on the main task and only post a request to the
+**       child task. Dumps are written by the child task a chunk at a time
+**       so a large capture never stalls the command pipe.
+**    3. Dump file layout, fields are in host byte order:
+**         LOGIC_CAP_FileHdr_t
+**         ByteCnt bytes of runs, each run is two LEB128 varints:
+**           Xor      Levels of this run XORed with the previous run's
+**                    levels, the levels before the first run are 0
+**           Samples  Number of samples the levels were held for
+**       The time of sample N is StartTimeNs + N*SampleNs.
+**
+**  References:
+**    1. OpenSatKit Object-based Application Developer's Guide.
+**    2. cFS Application Developer's Guide.
+**
+*/
+
+#ifndef _logic_cap_
+#define _logic_cap_
+
+/*
+** Includes
+*/
+
+#include <semaphore.h>
+
+#include "app_cfg.h"
+#include "childmgr.h"
+#include "initbl.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define LOGIC_CAP_ARENA_BYTES  (256*1024)
+#define LOGIC_CAP_DUMP_CHUNK   4096     /* Bytes written per child task pass */
+#define LOGIC_CAP_MAX_RUN_LEN  15       /* Varint Xor (10) + Samples (5) */
+#define LOGIC_CAP_MAX_SAMPLE_US  1000000
+
+#define LOGIC_CAP_FILE_ID       "GPLA"
+#define LOGIC_CAP_FILE_VERSION  1
+
+/*
+** States, owned by the child task
+*/
+
+#define LOGIC_CAP_IDLE     0
+#define LOGIC_CAP_RUNNING  1
+#define LOGIC_CAP_DUMPING  2
+
+/*
+** Requests, posted by commands
+*/
+
+#define LOGIC_CAP_REQ_NONE   0
+#define LOGIC_CAP_REQ_START  1
+#define LOGIC_CAP_REQ_STOP   2
+#define LOGIC_CAP_REQ_DUMP   3
+
+/*
+** Event Message IDs
+*/
+
+#define LOGIC_CAP_START_EID  (LOGIC_CAP_BASE_EID + 0)
+#define LOGIC_CAP_STOP_EID   (LOGIC_CAP_BASE_EID + 1)
+#define LOGIC_CAP_DUMP_EID   (LOGIC_CAP_BASE_EID + 2)
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+
+/******************************************************************************
+** Dump file header
+*/
+
+typedef struct
+{
+
+   char    Id[4];          /* LOGIC_CAP_FILE_ID */
+   uint16  Version;
+   uint16  HdrLen;         /* Offset of the first run */
+   uint32  SampleNs;
+   uint32  ByteCnt;        /* Encoded run bytes that follow the header */
+   uint64  StartTimeNs;    /* CLOCK_MONOTONIC time of the first sample */
+   uint64  SampleCnt;
+   uint32  RunCnt;
+   uint32  OverrunCnt;     /* Samples that repeat the previous level because the task was late */
+
+} LOGIC_CAP_FileHdr_t;
+
+
+/******************************************************************************
+** Class
+*/
+
+typedef struct
+{
+
+   /*
+   ** Framework References
+   */
+
+   INITBL_Class_t*  IniTbl;
+
+   /*
+   ** Command requests, written by the main task
+   */
+
+   sem_t   WakeSem;
+   uint8   Request;
+   uint32  ReqSampleNs;
+   char    ReqFilename[OS_MAX_PATH_LEN];
+
+   /*
+   ** Child task state
+   */
+
+   uint8   State;
+   bool    StopRequested;
+   bool    ArenaFull;       /* Last capture stopped because the arena filled */
+   uint16  DumpCnt;
+
+   uint64  NextSampleNs;
+   uint64  RunLevel;        /* Levels of the run being counted */
+   uint64  RunXor;
+   uint32  RunSamples;
+
+   LOGIC_CAP_FileHdr_t  Hdr;
+
+   osal_id_t  DumpFile;
+   uint32     DumpByteCnt;  /* Arena bytes written by the current or last dump */
+
+   uint32  ArenaUsed;
+   uint8   Arena[LOGIC_CAP_ARENA_BYTES];
+
+} LOGIC_CAP_Class_t;
+
+
+/************************/
+/** Exported Functions **/
+/************************/
+
+
+/******************************************************************************
+** Function: LOGIC_CAP_Constructor
+**
+** Initialize the Logic Capture object to a known state
+**
+** Notes:
+**   1. This must be called prior to any other function.
+**
+*/
+void LOGIC_CAP_Constructor(LOGIC_CAP_Class_t *LogicCapPtr, INITBL_Class_t* IniTbl);
+
+
+/******************************************************************************
+** Function: LOGIC_CAP_ChildTask
+**
+** Run one pass of the logic capture child task
+**
+** Notes:
+**   1. Returns false when the task should exit.
+**
+*/
+bool LOGIC_CAP_ChildTask(CHILDMGR_Class_t* ChildMgr);
+
+
+/******************************************************************************
+** Function: LOGIC_CAP_DumpCmd
+**
+** Write the last capture to a file
+**
+** Notes:
+**   1. Rejected while a capture is running or being dumped.
+**
+*/
+bool LOGIC_CAP_DumpCmd(void* DataObjPtr, const CFE_MSG_Message_t *MsgPtr);
+
+
+/******************************************************************************
+** Function: LOGIC_CAP_StartCmd
+**
+** Start a new capture, discarding the previous one
+**
+*/
+bool LOGIC_CAP_StartCmd(void* DataObjPtr, const CFE_MSG_Message_t *MsgPtr);
+
+
+/******************************************************************************
+** Function: LOGIC_CAP_Stop
+**
+** Request the child task to exit
+**
+*/
+void LOGIC_CAP_Stop(void);
+
+
+/******************************************************************************
+** Function: LOGIC_CAP_StopCmd
+**
+** Stop a running capture or abort a dump
+**
+*/
+bool LOGIC_CAP_StopCmd(void* DataObjPtr, const CFE_MSG_Message_t *MsgPtr);
+
+
+#endif /* _logic_cap_ */
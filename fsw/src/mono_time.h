@@ -0,0 +1,108 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Define monotonic clock utilities shared by the GPIO Demo objects
+**
+**  Notes:
+**    1. Defined inline because they are called on the edge timing paths.
+**    2. All times are CLOCK_MONOTONIC nanoseconds so timestamps taken by
+**       different tasks and by external tools can be compared.
+**
+**  References:
+**    1. OpenSatKit Object-based Application Developer's Guide.
+**    2. cFS Application Developer's Guide.
+**
+*/
+
+#ifndef _mono_time_
+#define _mono_time_
+
+/*
+** Includes
+*/
+
+#include <errno.h>
+#include <time.h>
+
+#include "app_cfg.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define MONO_TIME_NS_PER_MS   1000000ULL
+#define MONO_TIME_NS_PER_SEC  1000000000ULL
+
+
+/************************/
+/** Exported Functions **/
+/************************/
+
+
+/******************************************************************************
+** Function: MONO_TIME_GetNs
+**
+*/
+static inline uint64 MONO_TIME_GetNs(void)
+{
+   
+   struct timespec Now;
+   
+   clock_gettime(CLOCK_MONOTONIC, &Now);
+   
+   return ((uint64)Now.tv_sec * MONO_TIME_NS_PER_SEC + (uint64)Now.tv_nsec);
+   
+} /* End MONO_TIME_GetNs() */
+
+
+/******************************************************************************
+** Function: MONO_TIME_ToTimespec
+**
+*/
+static inline struct timespec MONO_TIME_ToTimespec(uint64 TimeNs)
+{
+   
+   struct timespec Time;
+   
+   Time.tv_sec  = TimeNs / MONO_TIME_NS_PER_SEC;
+   Time.tv_nsec = TimeNs % MONO_TIME_NS_PER_SEC;
+   
+   return Time;
+   
+} /* End MONO_TIME_ToTimespec() */
+
+
+/******************************************************************************
+** Function: MONO_TIME_SleepUntilNs
+**
+** Sleep until the monotonic clock reaches DeadlineNs
+**
+** Notes:
+**   1. Returns immediately if the deadline has passed.
+**
+*/
+static inline void MONO_TIME_SleepUntilNs(uint64 DeadlineNs)
+{
+   
+   struct timespec Deadline = MONO_TIME_ToTimespec(DeadlineNs);
+   
+   while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &Deadline, NULL) == EINTR);
+   
+} /* End MONO_TIME_SleepUntilNs() */
+
+
+
+#endif /* _mono_time_ */
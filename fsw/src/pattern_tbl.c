@@ -0,0 +1,482 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Implement the Pattern Table
+**
+**  Notes:
+**    1. The JSON table has the following format. The set and clr arrays
+**       hold GPIO pin numbers and either may be empty.
+**
+**         "step-array": [
+**            {"step": {"hold-us": 100000, "set": [18], "clr": [] }},
+**            ...
+**         ]
+**
+**    2. The table is parsed with coreJSON queries through CJSON.
+**    3. PubIdx and UseIdx use sequentially consistent atomics. The child
+**       task stores UseIdx and then re-reads PubIdx so a load that checked
+**       UseIdx before the store never compiles into the entry the child
+**       task ends up reading.
+**
+**  References:
+**    1. OpenSatKit Object-based Application Developer's Guide.
+**    2. cFS Application Developer's Guide.
+**
+*/
+
+/*
+** Include Files:
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "cjson.h"
+#include "gpio_drv.h"
+#include "pattern_tbl.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define PATTERN_TBL_MAX_HOLD_US  (UINT32_MAX/1000)   /* HoldNs must fit a uint32 */
+
+#define QUERY_MAX_LEN    64
+#define PIN_LIST_MAX_LEN (4*(GPIO_DRV_MAX_PIN+1))
+
+
+/*******************************/
+/** Local Function Prototypes **/
+/*******************************/
+
+static bool GetJsonUint(const char* Query, uint32* Value);
+static bool GetPinList(uint16 JsonStep, const char* Key, uint64* PinMask);
+static bool LoadJsonData(size_t JsonFileLen);
+static void PinListStr(char* PinList, uint64 PinMask);
+static bool Withdraw(uint32 PubIdx);
+
+
+/**********************/
+/** Global File Data **/
+/**********************/
+
+static PATTERN_TBL_Class_t* PatternTbl = NULL;
+
+
+/******************************************************************************
+** Function: PATTERN_TBL_Constructor
+**
+*/
+void PATTERN_TBL_Constructor(PATTERN_TBL_Class_t *PatternTblPtr, uint64 OutPinMask)
+{
+   
+   PatternTbl = PatternTblPtr;
+   
+   memset(PatternTbl, 0, sizeof(PATTERN_TBL_Class_t));
+   
+   PatternTbl->OutPinMask = OutPinMask;
+   PatternTbl->UseIdx     = PATTERN_TBL_IDLE;
+   PatternTbl->LastLoadStatus = TBLMGR_STATUS_UNDEF;
+   
+} /* End PATTERN_TBL_Constructor() */
+
+
+/******************************************************************************
+** Function: PATTERN_TBL_DumpCmd
+**
+*/
+bool PATTERN_TBL_DumpCmd(TBLMGR_Tbl_t* Tbl, uint8 DumpType, const char* Filename)
+{
+   
+   const PATTERN_TBL_Pattern_t* Pattern = &PatternTbl->Pattern[PatternTbl->PubIdx];
+   const PATTERN_TBL_Step_t* Step;
+   bool      RetStatus = false;
+   int32     SysStatus;
+   osal_id_t FileHandle;
+   char      DumpRecord[2*PIN_LIST_MAX_LEN+80];
+   char      SetList[PIN_LIST_MAX_LEN];
+   char      ClrList[PIN_LIST_MAX_LEN];
+   uint16    i;
+   
+   SysStatus = OS_OpenCreate(&FileHandle, Filename, OS_FILE_FLAG_CREATE | OS_FILE_FLAG_TRUNCATE, OS_READ_WRITE);
+   
+   if (SysStatus == OS_SUCCESS)
+   {
+   
+      sprintf(DumpRecord,"{\n   \"name\": \"GPIO Demo Pattern Table\",\n");
+      OS_write(FileHandle, DumpRecord, strlen(DumpRecord));
+   
+      sprintf(DumpRecord,"   \"description\": \"Compiled pattern, %u steps, %u us period\",\n   \"step-array\": [\n",
+              Pattern->StepCnt, Pattern->PeriodUs);
+      OS_write(FileHandle, DumpRecord, strlen(DumpRecord));
+   
+      for (i=0; i < Pattern->StepCnt; i++)
+      {
+   
+         Step = &Pattern->Step[i];
+         PinListStr(SetList, Step->SetMask);
+         PinListStr(ClrList, Step->ClrMask);
+         sprintf(DumpRecord,"      {\"step\": {\"hold-us\": %u, \"set\": [%s], \"clr\": [%s]}}%s\n",
+                 Step->HoldNs/1000, SetList, ClrList, (i < Pattern->StepCnt-1) ? "," : "");
+         OS_write(FileHandle, DumpRecord, strlen(DumpRecord));
+   
+      }
+   
+      sprintf(DumpRecord,"   ]\n}\n");
+      OS_write(FileHandle, DumpRecord, strlen(DumpRecord));
+   
+      OS_close(FileHandle);
+      RetStatus = true;
+   
+   } /* End if file create */
+   else
+   {
+      CFE_EVS_SendEvent(PATTERN_TBL_DUMP_EID, CFE_EVS_EventType_ERROR,
+                        "Error creating pattern dump file '%s', status=0x%08X", Filename, SysStatus);
+   }
+   
+   return RetStatus;
+   
+} /* End PATTERN_TBL_DumpCmd() */
+
+
+/******************************************************************************
+** Function: PATTERN_TBL_GetPattern
+**
+*/
+const PATTERN_TBL_Pattern_t* PATTERN_TBL_GetPattern(void)
+{
+   
+   uint32 Idx;
+   
+   do
+   {
+      Idx = __atomic_load_n(&PatternTbl->PubIdx, __ATOMIC_SEQ_CST);
+      __atomic_store_n(&PatternTbl->UseIdx, Idx, __ATOMIC_SEQ_CST);
+   } while (__atomic_load_n(&PatternTbl->PubIdx, __ATOMIC_SEQ_CST) != Idx);
+   
+   return &PatternTbl->Pattern[Idx];
+   
+} /* End PATTERN_TBL_GetPattern() */
+
+
+/******************************************************************************
+** Function: PATTERN_TBL_IsLoaded
+**
+*/
+bool PATTERN_TBL_IsLoaded(void)
+{
+   
+   return (PatternTbl->Pattern[PatternTbl->PubIdx].StepCnt > 0);
+   
+} /* End PATTERN_TBL_IsLoaded() */
+
+
+/******************************************************************************
+** Function: PATTERN_TBL_LoadCmd
+**
+** Notes:
+**   1. The new pattern is compiled into the unpublished Pattern[] entry so
+**      a failed load leaves the current pattern untouched.
+**   2. A published pattern the child task hasn't started, e.g. because the
+**      GPIO is unmapped, is withdrawn and replaced by the new load.
+**
+*/
+bool PATTERN_TBL_LoadCmd(TBLMGR_Tbl_t* Tbl, uint8 LoadType, const char* Filename)
+{
+   
+   bool   RetStatus = false;
+   uint32 PubIdx = PatternTbl->PubIdx;
+   uint32 UseIdx = __atomic_load_n(&PatternTbl->UseIdx, __ATOMIC_SEQ_CST);
+   uint32 LoadIdx;
+   const PATTERN_TBL_Pattern_t* Pattern;
+   
+   if (LoadType != TBLMGR_LOAD_TBL_REPLACE)
+   {
+      CFE_EVS_SendEvent(PATTERN_TBL_LOAD_EID, CFE_EVS_EventType_ERROR,
+                        "Pattern table only supports replace loads, load type %d rejected", LoadType);
+   }
+   else if (UseIdx != PubIdx && UseIdx != PATTERN_TBL_IDLE && !Withdraw(PubIdx))
+   {
+      CFE_EVS_SendEvent(PATTERN_TBL_LOAD_EID, CFE_EVS_EventType_ERROR,
+                        "Pattern table load rejected, the controller started the previous pattern during the load, retry");
+   }
+   else if (CJSON_ProcessFile(Filename, PatternTbl->JsonBuf, PATTERN_TBL_JSON_FILE_MAX_CHAR, LoadJsonData))
+   {
+   
+      LoadIdx = PatternTbl->PubIdx ^ 1;
+      __atomic_store_n(&PatternTbl->PubIdx, LoadIdx, __ATOMIC_SEQ_CST);
+      PatternTbl->LoadCnt++;
+   
+      Pattern = &PatternTbl->Pattern[LoadIdx];
+      CFE_EVS_SendEvent(PATTERN_TBL_LOAD_EID, CFE_EVS_EventType_INFORMATION,
+                        "Pattern table loaded from %s: %u steps, %u us period, pins 0x%016llX",
+                        Filename, Pattern->StepCnt, Pattern->PeriodUs, (unsigned long long)Pattern->PinMask);
+      RetStatus = true;
+   
+   }
+   
+   PatternTbl->LastLoadStatus = RetStatus ? TBLMGR_STATUS_VALID : TBLMGR_STATUS_INVALID;
+   
+   return RetStatus;
+   
+} /* End PATTERN_TBL_LoadCmd() */
+
+
+/******************************************************************************
+** Function: PATTERN_TBL_Release
+**
+*/
+void PATTERN_TBL_Release(void)
+{
+   
+   __atomic_store_n(&PatternTbl->UseIdx, PATTERN_TBL_IDLE, __ATOMIC_SEQ_CST);
+   
+} /* End PATTERN_TBL_Release() */
+
+
+/******************************************************************************
+** Function: PATTERN_TBL_ResetStatus
+**
+*/
+void PATTERN_TBL_ResetStatus(void)
+{
+   
+   PatternTbl->LoadCnt = 0;
+   
+} /* End PATTERN_TBL_ResetStatus() */
+
+
+/******************************************************************************
+** Function: GetJsonUint
+**
+*/
+static bool GetJsonUint(const char* Query, uint32* Value)
+{
+   
+   char*  JsonVal;
+   size_t JsonValLen;
+   char   NumStr[16];
+   char*  End;
+   
+   if (JSON_Search(PatternTbl->JsonBuf, PatternTbl->JsonFileLen, Query, strlen(Query),
+                   &JsonVal, &JsonValLen) != JSONSuccess)
+   {
+      return false;
+   }
+   
+   if (JsonValLen == 0 || JsonValLen >= sizeof(NumStr))
+   {
+      return false;
+   }
+   
+   memcpy(NumStr, JsonVal, JsonValLen);
+   NumStr[JsonValLen] = '\0';
+   *Value = strtoul(NumStr, &End, 10);
+   
+   return (*End == '\0');
+   
+} /* End GetJsonUint() */
+
+
+/******************************************************************************
+** Function: GetPinList
+**
+** Convert a step's pin array into a pin mask
+**
+*/
+static bool GetPinList(uint16 JsonStep, const char* Key, uint64* PinMask)
+{
+   
+   char   Query[QUERY_MAX_LEN];
+   uint32 Pin;
+   uint16 i;
+   
+   *PinMask = 0;
+   
+   for (i=0; i <= GPIO_DRV_MAX_PIN; i++)
+   {
+   
+      snprintf(Query, sizeof(Query), "step-array[%u].step.%s[%u]", JsonStep, Key, i);
+      if (!GetJsonUint(Query, &Pin))
+      {
+         break;
+      }
+   
+      if (Pin > GPIO_DRV_MAX_PIN || (PatternTbl->OutPinMask & GPIO_DRV_PIN_MASK(Pin)) == 0)
+      {
+         CFE_EVS_SendEvent(PATTERN_TBL_LOAD_EID, CFE_EVS_EventType_ERROR,
+                           "Pattern step %u %s pin %u is not a configured output pin", JsonStep, Key, Pin);
+         return false;
+      }
+      *PinMask |= GPIO_DRV_PIN_MASK(Pin);
+   
+   }
+   
+   return true;
+   
+} /* End GetPinList() */
+
+
+/******************************************************************************
+** Function: LoadJsonData
+**
+** Compile the JSON steps into the unpublished Pattern[] entry
+**
+** Notes:
+**   1. Steps with a zero hold time are merged into the next step. A later
+**      step's set or clear of a pin overrides an earlier one.
+**   2. The last step must have a non-zero hold so the pattern period is
+**      never zero.
+**
+*/
+static bool LoadJsonData(size_t JsonFileLen)
+{
+   
+   PATTERN_TBL_Pattern_t* Pattern = &PatternTbl->Pattern[PatternTbl->PubIdx ^ 1];
+   PATTERN_TBL_Step_t*    Step;
+   char   Query[QUERY_MAX_LEN];
+   uint16 JsonStep;
+   uint32 HoldUs;
+   uint64 PeriodUs = 0;
+   uint64 SetMask;
+   uint64 ClrMask;
+   uint64 PendSet = 0;
+   uint64 PendClr = 0;
+   
+   PatternTbl->JsonFileLen = JsonFileLen;
+   Pattern->StepCnt = 0;
+   Pattern->PinMask = 0;
+   
+   for (JsonStep=0; ; JsonStep++)
+   {
+   
+      snprintf(Query, sizeof(Query), "step-array[%u].step.hold-us", JsonStep);
+      if (!GetJsonUint(Query, &HoldUs))
+      {
+         break;
+      }
+   
+      if (!GetPinList(JsonStep, "set", &SetMask) || !GetPinList(JsonStep, "clr", &ClrMask))
+      {
+         return false;
+      }
+   
+      if ((SetMask & ClrMask) != 0 || HoldUs > PATTERN_TBL_MAX_HOLD_US)
+      {
+         CFE_EVS_SendEvent(PATTERN_TBL_LOAD_EID, CFE_EVS_EventType_ERROR,
+                           "Pattern step %u invalid: hold %u us (max %u), pins set and cleared 0x%016llX",
+                           JsonStep, HoldUs, PATTERN_TBL_MAX_HOLD_US, (unsigned long long)(SetMask & ClrMask));
+         return false;
+      }
+   
+      PendSet = (PendSet & ~ClrMask) | SetMask;
+      PendClr = (PendClr & ~SetMask) | ClrMask;
+   
+      if (HoldUs > 0)
+      {
+   
+         if (Pattern->StepCnt == PATTERN_TBL_MAX_STEPS)
+         {
+            CFE_EVS_SendEvent(PATTERN_TBL_LOAD_EID, CFE_EVS_EventType_ERROR,
+                              "Pattern exceeds %u compiled steps at JSON step %u", PATTERN_TBL_MAX_STEPS, JsonStep);
+            return false;
+         }
+   
+         Step = &Pattern->Step[Pattern->StepCnt++];
+         Step->SetMask = PendSet;
+         Step->ClrMask = PendClr;
+         Step->HoldNs  = HoldUs * 1000;
+         Step->Spare   = 0;
+   
+         Pattern->PinMask |= PendSet | PendClr;
+         PeriodUs += HoldUs;
+         PendSet = 0;
+         PendClr = 0;
+   
+      }
+   
+   } /* End JSON step loop */
+   
+   if (Pattern->StepCnt == 0 || (PendSet | PendClr) != 0)
+   {
+      CFE_EVS_SendEvent(PATTERN_TBL_LOAD_EID, CFE_EVS_EventType_ERROR,
+                        "Pattern table must have at least one step and end with a non-zero hold time");
+      Pattern->StepCnt = 0;
+      return false;
+   }
+   
+   Pattern->PeriodUs = (PeriodUs > UINT32_MAX) ? UINT32_MAX : (uint32)PeriodUs;
+   
+   return true;
+   
+} /* End LoadJsonData() */
+
+
+/******************************************************************************
+** Function: PinListStr
+**
+** Write PinMask as a comma separated pin list. PinList must hold
+** PIN_LIST_MAX_LEN characters.
+**
+*/
+static void PinListStr(char* PinList, uint64 PinMask)
+{
+   
+   uint64 Pins = PinMask;
+   int    Len  = 0;
+   
+   PinList[0] = '\0';
+   while (Pins != 0)
+   {
+      Len += sprintf(&PinList[Len], (Len == 0) ? "%u" : ", %u", __builtin_ctzll(Pins));
+      Pins &= Pins - 1;
+   }
+   
+} /* End PinListStr() */
+
+
+/******************************************************************************
+** Function: Withdraw
+**
+** Publish the pattern the child task is running again in place of the
+** unstarted pattern in PubIdx. Returns false if the child task started it
+** first.
+**
+** Notes:
+**   1. Same handshake as PATTERN_TBL_GetPattern(). If UseIdx isn't PubIdx
+**      after the store the child task can only settle on the other entry.
+**      Otherwise it is using PubIdx, which is published again.
+**
+*/
+static bool Withdraw(uint32 PubIdx)
+{
+   
+   __atomic_store_n(&PatternTbl->PubIdx, PubIdx ^ 1, __ATOMIC_SEQ_CST);
+   
+   if (__atomic_load_n(&PatternTbl->UseIdx, __ATOMIC_SEQ_CST) == PubIdx)
+   {
+      __atomic_store_n(&PatternTbl->PubIdx, PubIdx, __ATOMIC_SEQ_CST);
+      return false;
+   }
+   
+   CFE_EVS_SendEvent(PATTERN_TBL_LOAD_EID, CFE_EVS_EventType_INFORMATION,
+                     "Pattern table load replaces the previous load, which the controller hasn't started (GPIO unmapped?)");
+   
+   return true;
+   
+} /* End Withdraw() */
@@ -0,0 +1,210 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Define the Pattern Table
+**
+**  Notes:
+**    1. A pattern is a JSON table of steps that each set and clear a list
+**       of pins and then hold for a time. The pattern repeats after its
+**       last step.
+**    2. A load compiles the JSON steps into an array of PATTERN_TBL_Step_t
+**       so the child task walks the array without any parsing. Steps with a
+**       zero hold time are merged into the following step so every compiled
+**       step is one bank write.
+**    3. Two compiled patterns are kept. A load compiles into the entry that
+**       the child task isn't using and then publishes it, see
+**       PATTERN_TBL_GetPattern().
+**
+**  References:
+**    1. OpenSatKit Object-based Application Developer's Guide.
+**    2. cFS Application Developer's Guide.
+**
+*/
+
+#ifndef _pattern_tbl_
+#define _pattern_tbl_
+
+/*
+** Includes
+*/
+
+#include "app_cfg.h"
+#include "tblmgr.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define PATTERN_TBL_MAX_STEPS            256
+#define PATTERN_TBL_JSON_FILE_MAX_CHAR  (PATTERN_TBL_MAX_STEPS*80)
+
+#define PATTERN_TBL_IDLE  2   /* UseIdx when the child task isn't running a pattern */
+
+/*
+** Event Message IDs
+*/
+
+#define PATTERN_TBL_LOAD_EID  (PATTERN_TBL_BASE_EID + 0)
+#define PATTERN_TBL_DUMP_EID  (PATTERN_TBL_BASE_EID + 1)
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+
+/******************************************************************************
+** Compiled pattern
+** - 24 byte steps keep a pattern in a few contiguous cache lines
+*/
+
+typedef struct
+{
+
+   uint64  SetMask;
+   uint64  ClrMask;
+   uint32  HoldNs;    /* Time from this step's write to the next step */
+   uint32  Spare;
+
+} PATTERN_TBL_Step_t;
+
+typedef struct
+{
+
+   uint16  StepCnt;   /* 0 when no pattern has been loaded */
+   uint16  Spare;
+   uint32  PeriodUs;
+   uint64  PinMask;   /* All pins written by the pattern */
+   PATTERN_TBL_Step_t Step[PATTERN_TBL_MAX_STEPS];
+
+} PATTERN_TBL_Pattern_t;
+
+
+/******************************************************************************
+** Class
+*/
+
+typedef struct
+{
+
+   /*
+   ** Configuration
+   */
+
+   uint64  OutPinMask;   /* Pins a pattern may write */
+
+   /*
+   ** Class State Data
+   */
+
+   uint8   LastLoadStatus;
+   uint16  LoadCnt;
+
+   size_t  JsonFileLen;
+   char    JsonBuf[PATTERN_TBL_JSON_FILE_MAX_CHAR];
+
+   uint32  PubIdx;   /* Pattern[] entry published to the child task */
+   uint32  UseIdx;   /* Pattern[] entry read by the child task or PATTERN_TBL_IDLE */
+   PATTERN_TBL_Pattern_t Pattern[2];
+
+} PATTERN_TBL_Class_t;
+
+
+/************************/
+/** Exported Functions **/
+/************************/
+
+
+/******************************************************************************
+** Function: PATTERN_TBL_Constructor
+**
+** Initialize the Pattern Table object to a known state
+**
+** Notes:
+**   1. This must be called prior to any other function.
+**   2. OutPinMask limits the pins a table may use to the configured outputs.
+**
+*/
+void PATTERN_TBL_Constructor(PATTERN_TBL_Class_t *PatternTblPtr, uint64 OutPinMask);
+
+
+/******************************************************************************
+** Function: PATTERN_TBL_DumpCmd
+**
+** Write the compiled pattern to a JSON file
+**
+** Notes:
+**   1. Function signature must match TBLMGR_DumpTblFuncPtr_t.
+**   2. Merged steps are dumped as one step.
+**
+*/
+bool PATTERN_TBL_DumpCmd(TBLMGR_Tbl_t* Tbl, uint8 DumpType, const char* Filename);
+
+
+/******************************************************************************
+** Function: PATTERN_TBL_GetPattern
+**
+** Return the published pattern for the child task
+**
+** Notes:
+**   1. Only the child task may call this. The returned pattern is not
+**      modified until the next call or PATTERN_TBL_Release().
+**
+*/
+const PATTERN_TBL_Pattern_t* PATTERN_TBL_GetPattern(void);
+
+
+/******************************************************************************
+** Function: PATTERN_TBL_IsLoaded
+**
+*/
+bool PATTERN_TBL_IsLoaded(void);
+
+
+/******************************************************************************
+** Function: PATTERN_TBL_LoadCmd
+**
+** Load and compile a pattern JSON file
+**
+** Notes:
+**   1. Function signature must match TBLMGR_LoadTblFuncPtr_t.
+**   2. Only complete replacement loads are supported.
+**   3. A load is rejected while the child task is still reading the
+**      pattern from the previous load.
+**
+*/
+bool PATTERN_TBL_LoadCmd(TBLMGR_Tbl_t* Tbl, uint8 LoadType, const char* Filename);
+
+
+/******************************************************************************
+** Function: PATTERN_TBL_Release
+**
+** Called by the child task when it stops running a pattern
+**
+*/
+void PATTERN_TBL_Release(void);
+
+
+/******************************************************************************
+** Function: PATTERN_TBL_ResetStatus
+**
+** Reset counters and status flags to a known reset state.
+**
+*/
+void PATTERN_TBL_ResetStatus(void);
+
+
+#endif /* _pattern_tbl_ */
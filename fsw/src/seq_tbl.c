@@ -0,0 +1,958 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Implement the Sequence Table
+**
+**  Notes:
+**    1. The JSON table holds the script as an array of statement strings.
+**       Arguments are separated by spaces or commas, empty strings and
+**       strings starting with '#' are ignored.
+**
+**         "program": [
+**            "loop 3",
+**            "   set 18",
+**            "   wait 100000",
+**            "   clr 18",
+**            "   wait 100000",
+**            "next",
+**            "poll:",
+**            "   wait 1000",
+**            "   if-low 23 poll",
+**            "stop"
+**         ]
+**
+**    2. Statements:
+**         name:                  Label, up to SEQ_TBL_LABEL_MAX_LEN characters
+**         set <pin> ...          Set output pins
+**         clr <pin> ...          Clear output pins
+**         wait <us>              Hold until <us> after the previous wait
+**         loop <n> ... next      Run the enclosed statements n times
+**         goto <label>
+**         if-high <pin> <label>  Branch if the pin reads high
+**         if-low <pin> <label>   Branch if the pin reads low
+**         stop                   End the sequence, also implied at the end
+**       Branch pins must be configured output or input pins, the CHIP
+**       backend can't read any other pin. A goto or branch may leave a loop
+**       but not enter one, only the loop statement sets its counter.
+**    3. Adjacent set and clr statements compile to one bank write. A later
+**       statement's set or clear of a pin overrides an earlier one.
+**    4. Waits are on an absolute timeline so the time taken by the ops
+**       between waits doesn't accumulate.
+**    5. PubIdx and UseIdx are handed over the same way as the pattern
+**       table's, see pattern_tbl.c.
+**
+**  References:
+**    1. OpenSatKit Object-based Application Developer's Guide.
+**    2. cFS Application Developer's Guide.
+**
+*/
+
+/*
+** Include Files:
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "cjson.h"
+#include "gpio_drv.h"
+#include "seq_tbl.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define QUERY_MAX_LEN    32
+#define PIN_LIST_MAX_LEN (3*(GPIO_DRV_MAX_PIN+1))
+
+#define SEQ_TBL_LABEL_MAX_LEN  15
+#define SEQ_TBL_LINE_MAX_LEN   (PIN_LIST_MAX_LEN+16)   /* Fits a dumped statement with every pin */
+#define TOKEN_SEPARATORS " \t,"
+
+#define NO_LOOP  0xFF   /* Compiler loop index outside every loop */
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+/* LoadJsonData() compiler state */
+
+typedef struct
+{
+
+   char    Name[SEQ_TBL_LABEL_MAX_LEN+1];
+   bool    Defined;
+   uint8   Loop;    /* Innermost loop around the label or NO_LOOP */
+   uint16  Op;
+
+} Label_t;
+
+typedef struct
+{
+
+   SEQ_TBL_Program_t* Program;
+   uint16  Statement;     /* JSON statement being compiled */
+   char    Line[SEQ_TBL_LINE_MAX_LEN];
+
+   bool    WritePending;  /* Set and clear statements not yet compiled */
+   uint64  PendSet;
+   uint64  PendClr;
+
+   uint16  LabelCnt;
+   Label_t Label[SEQ_TBL_MAX_LABELS];
+
+   uint16  LoopDepth;
+   uint8   LoopCounter[SEQ_TBL_MAX_LOOPS];   /* Open loops, innermost last */
+   uint16  LoopBody[SEQ_TBL_MAX_LOOPS];
+   uint8   LoopParent[SEQ_TBL_MAX_LOOPS];    /* Loop around each loop or NO_LOOP */
+   uint8   BranchLoop[SEQ_TBL_MAX_OPS];      /* Innermost loop around each goto and branch op */
+
+} Compiler_t;
+
+
+/*******************************/
+/** Local Function Prototypes **/
+/*******************************/
+
+static bool AddOp(Compiler_t* Cmp, uint8 Op, uint8 A, uint16 B);
+static bool CompileError(const Compiler_t* Cmp, const char* Reason);
+static bool CompileStatement(Compiler_t* Cmp, char* Line);
+static bool FlushWrite(Compiler_t* Cmp);
+static bool GetLabel(Compiler_t* Cmp, const char* Name, uint16* Label);
+static bool GetPin(const char* Token, uint32* Pin);
+static bool GetUint(const char* Token, uint32 Max, uint32* Value);
+static bool InLoop(const Compiler_t* Cmp, uint8 Loop, uint8 Outer);
+static uint8 InnerLoop(const Compiler_t* Cmp);
+static bool LoadJsonData(size_t JsonFileLen);
+static const char* OpStr(uint8 Op);
+static void PinListStr(char* PinList, uint64 PinMask);
+static bool Withdraw(uint32 PubIdx);
+static void WriteStatement(osal_id_t FileHandle, const char* Statement, bool* First);
+
+
+/**********************/
+/** Global File Data **/
+/**********************/
+
+static SEQ_TBL_Class_t* SeqTbl = NULL;
+
+
+/******************************************************************************
+** Function: SEQ_TBL_Constructor
+**
+*/
+void SEQ_TBL_Constructor(SEQ_TBL_Class_t *SeqTblPtr, uint64 OutPinMask)
+{
+   
+   SeqTbl = SeqTblPtr;
+   
+   memset(SeqTbl, 0, sizeof(SEQ_TBL_Class_t));
+   
+   SeqTbl->OutPinMask = OutPinMask;
+   SeqTbl->UseIdx     = SEQ_TBL_IDLE;
+   SeqTbl->LastLoadStatus = TBLMGR_STATUS_UNDEF;
+   
+} /* End SEQ_TBL_Constructor() */
+
+
+/******************************************************************************
+** Function: SEQ_TBL_DumpCmd
+**
+** Notes:
+**   1. Ops that are jump or branch targets get an "L<op>:" label. Loop
+**      bodies need no labels because next always closes the innermost
+**      loop.
+**   2. The STOP op that ends every program isn't dumped, a label on it is
+**      dumped last.
+**
+*/
+bool SEQ_TBL_DumpCmd(TBLMGR_Tbl_t* Tbl, uint8 DumpType, const char* Filename)
+{
+   
+   const SEQ_TBL_Program_t* Program = &SeqTbl->Program[SeqTbl->PubIdx];
+   const SEQ_TBL_Op_t* Op;
+   bool      RetStatus = false;
+   bool      First = true;
+   int32     SysStatus;
+   osal_id_t FileHandle;
+   uint64    Target[SEQ_TBL_MAX_OPS/64];
+   char      DumpRecord[PIN_LIST_MAX_LEN+80];
+   char      Statement[PIN_LIST_MAX_LEN+16];
+   char      PinList[PIN_LIST_MAX_LEN];
+   uint16    i;
+   
+   memset(Target, 0, sizeof(Target));
+   for (i=0; i < Program->OpCnt; i++)
+   {
+      Op = &Program->Op[i];
+      if (Op->Op == SEQ_TBL_OP_JUMP || Op->Op == SEQ_TBL_OP_IF_HIGH || Op->Op == SEQ_TBL_OP_IF_LOW)
+      {
+         Target[Op->B/64] |= 1ULL << (Op->B % 64);
+      }
+   }
+   
+   SysStatus = OS_OpenCreate(&FileHandle, Filename, OS_FILE_FLAG_CREATE | OS_FILE_FLAG_TRUNCATE, OS_READ_WRITE);
+   
+   if (SysStatus == OS_SUCCESS)
+   {
+   
+      sprintf(DumpRecord,"{\n   \"name\": \"GPIO Demo Sequence Table\",\n");
+      OS_write(FileHandle, DumpRecord, strlen(DumpRecord));
+   
+      sprintf(DumpRecord,"   \"description\": \"Compiled sequence, %u ops, %u writes, %u loops\",\n   \"program\": [",
+              Program->OpCnt, Program->WriteCnt, Program->LoopCnt);
+      OS_write(FileHandle, DumpRecord, strlen(DumpRecord));
+   
+      for (i=0; i < Program->OpCnt; i++)
+      {
+   
+         if (Target[i/64] & (1ULL << (i % 64)))
+         {
+            sprintf(Statement, "L%u:", i);
+            WriteStatement(FileHandle, Statement, &First);
+         }
+   
+         Op = &Program->Op[i];
+         switch (Op->Op)
+         {
+            case SEQ_TBL_OP_WRITE:
+               if (Program->Write[Op->B].SetMask != 0)
+               {
+                  PinListStr(PinList, Program->Write[Op->B].SetMask);
+                  sprintf(Statement, "   set %s", PinList);
+                  WriteStatement(FileHandle, Statement, &First);
+               }
+               if (Program->Write[Op->B].ClrMask != 0)
+               {
+                  PinListStr(PinList, Program->Write[Op->B].ClrMask);
+                  sprintf(Statement, "   clr %s", PinList);
+                  WriteStatement(FileHandle, Statement, &First);
+               }
+               break;
+            case SEQ_TBL_OP_WAIT:
+               sprintf(Statement, "   wait %u", SEQ_TBL_WAIT_US(Op));
+               break;
+            case SEQ_TBL_OP_LOOP:
+               sprintf(Statement, "   loop %u", Op->B);
+               break;
+            case SEQ_TBL_OP_JUMP:
+               sprintf(Statement, "   goto L%u", Op->B);
+               break;
+            case SEQ_TBL_OP_IF_HIGH:
+            case SEQ_TBL_OP_IF_LOW:
+               sprintf(Statement, "   %s %u L%u", OpStr(Op->Op), Op->A, Op->B);
+               break;
+            default:
+               sprintf(Statement, "   %s", OpStr(Op->Op));
+               break;
+         }
+         if (Op->Op != SEQ_TBL_OP_WRITE && i < Program->OpCnt-1)
+         {
+            WriteStatement(FileHandle, Statement, &First);
+         }
+   
+      } /* End op loop */
+   
+      sprintf(DumpRecord,"\n   ]\n}\n");
+      OS_write(FileHandle, DumpRecord, strlen(DumpRecord));
+   
+      OS_close(FileHandle);
+      RetStatus = true;
+   
+   } /* End if file create */
+   else
+   {
+      CFE_EVS_SendEvent(SEQ_TBL_DUMP_EID, CFE_EVS_EventType_ERROR,
+                        "Error creating sequence dump file '%s', status=0x%08X", Filename, SysStatus);
+   }
+   
+   return RetStatus;
+   
+} /* End SEQ_TBL_DumpCmd() */
+
+
+/******************************************************************************
+** Function: SEQ_TBL_GetProgram
+**
+*/
+const SEQ_TBL_Program_t* SEQ_TBL_GetProgram(void)
+{
+   
+   uint32 Idx;
+   
+   do
+   {
+      Idx = __atomic_load_n(&SeqTbl->PubIdx, __ATOMIC_SEQ_CST);
+      __atomic_store_n(&SeqTbl->UseIdx, Idx, __ATOMIC_SEQ_CST);
+   } while (__atomic_load_n(&SeqTbl->PubIdx, __ATOMIC_SEQ_CST) != Idx);
+   
+   return &SeqTbl->Program[Idx];
+   
+} /* End SEQ_TBL_GetProgram() */
+
+
+/******************************************************************************
+** Function: SEQ_TBL_IsLoaded
+**
+*/
+bool SEQ_TBL_IsLoaded(void)
+{
+   
+   return (SeqTbl->Program[SeqTbl->PubIdx].OpCnt > 0);
+   
+} /* End SEQ_TBL_IsLoaded() */
+
+
+/******************************************************************************
+** Function: SEQ_TBL_LoadCmd
+**
+** Notes:
+**   1. The new program is compiled into the unpublished Program[] entry so
+**      a failed load leaves the current program untouched.
+**   2. A published program the child task hasn't started, e.g. because the
+**      GPIO is unmapped, is withdrawn and replaced by the new load.
+**
+*/
+bool SEQ_TBL_LoadCmd(TBLMGR_Tbl_t* Tbl, uint8 LoadType, const char* Filename)
+{
+   
+   bool   RetStatus = false;
+   uint32 PubIdx = SeqTbl->PubIdx;
+   uint32 UseIdx = __atomic_load_n(&SeqTbl->UseIdx, __ATOMIC_SEQ_CST);
+   uint32 LoadIdx;
+   const SEQ_TBL_Program_t* Program;
+   
+   if (LoadType != TBLMGR_LOAD_TBL_REPLACE)
+   {
+      CFE_EVS_SendEvent(SEQ_TBL_LOAD_EID, CFE_EVS_EventType_ERROR,
+                        "Sequence table only supports replace loads, load type %d rejected", LoadType);
+   }
+   else if (UseIdx != PubIdx && UseIdx != SEQ_TBL_IDLE && !Withdraw(PubIdx))
+   {
+      CFE_EVS_SendEvent(SEQ_TBL_LOAD_EID, CFE_EVS_EventType_ERROR,
+                        "Sequence table load rejected, the controller started the previous sequence during the load, retry");
+   }
+   else if (CJSON_ProcessFile(Filename, SeqTbl->JsonBuf, SEQ_TBL_JSON_FILE_MAX_CHAR, LoadJsonData))
+   {
+   
+      LoadIdx = SeqTbl->PubIdx ^ 1;
+      __atomic_store_n(&SeqTbl->PubIdx, LoadIdx, __ATOMIC_SEQ_CST);
+      SeqTbl->LoadCnt++;
+   
+      Program = &SeqTbl->Program[LoadIdx];
+      CFE_EVS_SendEvent(SEQ_TBL_LOAD_EID, CFE_EVS_EventType_INFORMATION,
+                        "Sequence table loaded from %s: %u ops, %u writes, %u loops, pins 0x%016llX",
+                        Filename, Program->OpCnt, Program->WriteCnt, Program->LoopCnt,
+                        (unsigned long long)Program->PinMask);
+      RetStatus = true;
+   
+   }
+   
+   SeqTbl->LastLoadStatus = RetStatus ? TBLMGR_STATUS_VALID : TBLMGR_STATUS_INVALID;
+   
+   return RetStatus;
+   
+} /* End SEQ_TBL_LoadCmd() */
+
+
+/******************************************************************************
+** Function: SEQ_TBL_Release
+**
+*/
+void SEQ_TBL_Release(void)
+{
+   
+   __atomic_store_n(&SeqTbl->UseIdx, SEQ_TBL_IDLE, __ATOMIC_SEQ_CST);
+   
+} /* End SEQ_TBL_Release() */
+
+
+/******************************************************************************
+** Function: SEQ_TBL_ResetStatus
+**
+*/
+void SEQ_TBL_ResetStatus(void)
+{
+   
+   SeqTbl->LoadCnt = 0;
+   
+} /* End SEQ_TBL_ResetStatus() */
+
+
+/******************************************************************************
+** Function: AddOp
+**
+** Notes:
+**   1. The last op is reserved for the STOP that ends every program.
+**
+*/
+static bool AddOp(Compiler_t* Cmp, uint8 Op, uint8 A, uint16 B)
+{
+   
+   SEQ_TBL_Op_t* NewOp;
+   
+   if (Cmp->Program->OpCnt >= SEQ_TBL_MAX_OPS-1)
+   {
+      return CompileError(Cmp, "program exceeds the op limit");
+   }
+   
+   NewOp = &Cmp->Program->Op[Cmp->Program->OpCnt++];
+   NewOp->Op = Op;
+   NewOp->A  = A;
+   NewOp->B  = B;
+   
+   return true;
+   
+} /* End AddOp() */
+
+
+/******************************************************************************
+** Function: CompileError
+**
+** Report a compile error in the current statement and return false
+**
+*/
+static bool CompileError(const Compiler_t* Cmp, const char* Reason)
+{
+   
+   CFE_EVS_SendEvent(SEQ_TBL_LOAD_EID, CFE_EVS_EventType_ERROR,
+                     "Sequence statement %u '%s': %s", Cmp->Statement, Cmp->Line, Reason);
+   
+   return false;
+   
+} /* End CompileError() */
+
+
+/******************************************************************************
+** Function: CompileStatement
+**
+** Compile one statement, Line is modified
+**
+*/
+static bool CompileStatement(Compiler_t* Cmp, char* Line)
+{
+   
+   char*   Save;
+   char*   Token = strtok_r(Line, TOKEN_SEPARATORS, &Save);
+   char*   Arg;
+   size_t  Len;
+   uint16  Label;
+   uint32  Pin;
+   uint32  Value;
+   uint64  PinMask = 0;
+   
+   if (Token == NULL || Token[0] == '#')
+   {
+      return true;
+   }
+   
+   if (strcmp(Token, "set") == 0 || strcmp(Token, "clr") == 0)
+   {
+   
+      while ((Arg = strtok_r(NULL, TOKEN_SEPARATORS, &Save)) != NULL)
+      {
+         if (!GetPin(Arg, &Pin) || (SeqTbl->OutPinMask & GPIO_DRV_PIN_MASK(Pin)) == 0)
+         {
+            return CompileError(Cmp, "pin is not a configured output pin");
+         }
+         PinMask |= GPIO_DRV_PIN_MASK(Pin);
+      }
+      if (PinMask == 0)
+      {
+         return CompileError(Cmp, "no pins");
+      }
+   
+      if (Token[0] == 's')
+      {
+         Cmp->PendSet |= PinMask;
+         Cmp->PendClr &= ~PinMask;
+      }
+      else
+      {
+         Cmp->PendClr |= PinMask;
+         Cmp->PendSet &= ~PinMask;
+      }
+      Cmp->WritePending = true;
+      return true;
+   
+   } /* End if set or clr */
+   
+   if (!FlushWrite(Cmp))
+   {
+      return false;
+   }
+   
+   Arg = strtok_r(NULL, TOKEN_SEPARATORS, &Save);
+   Len = strlen(Token);
+   
+   if (Token[Len-1] == ':')
+   {
+   
+      Token[Len-1] = '\0';
+      if (Arg != NULL || Len == 1 || !GetLabel(Cmp, Token, &Label))
+      {
+         return CompileError(Cmp, "invalid label");
+      }
+      if (Cmp->Label[Label].Defined)
+      {
+         return CompileError(Cmp, "label defined twice");
+      }
+      Cmp->Label[Label].Defined = true;
+      Cmp->Label[Label].Loop    = InnerLoop(Cmp);
+      Cmp->Label[Label].Op      = Cmp->Program->OpCnt;
+      return true;
+   
+   }
+   else if (strcmp(Token, "wait") == 0)
+   {
+   
+      if (Arg == NULL || !GetUint(Arg, UINT32_MAX, &Value))
+      {
+         return CompileError(Cmp, "invalid wait time");
+      }
+      do
+      {
+         Pin = (Value > SEQ_TBL_MAX_WAIT_US) ? SEQ_TBL_MAX_WAIT_US : Value;
+         if (!AddOp(Cmp, SEQ_TBL_OP_WAIT, Pin >> 16, Pin & 0xFFFF))
+         {
+            return false;
+         }
+         Value -= Pin;
+      } while (Value > 0);
+      return true;
+   
+   }
+   else if (strcmp(Token, "loop") == 0)
+   {
+   
+      if (Arg == NULL || !GetUint(Arg, UINT16_MAX, &Value) || Value == 0)
+      {
+         return CompileError(Cmp, "invalid loop count, 1 to 65535");
+      }
+      if (Cmp->Program->LoopCnt >= SEQ_TBL_MAX_LOOPS)
+      {
+         return CompileError(Cmp, "too many loop statements");
+      }
+      if (!AddOp(Cmp, SEQ_TBL_OP_LOOP, Cmp->Program->LoopCnt, Value))
+      {
+         return false;
+      }
+      Cmp->LoopParent[Cmp->Program->LoopCnt] = InnerLoop(Cmp);
+      Cmp->LoopCounter[Cmp->LoopDepth] = Cmp->Program->LoopCnt++;
+      Cmp->LoopBody[Cmp->LoopDepth++]  = Cmp->Program->OpCnt;
+      return true;
+   
+   }
+   else if (strcmp(Token, "next") == 0)
+   {
+   
+      if (Cmp->LoopDepth == 0)
+      {
+         return CompileError(Cmp, "next without loop");
+      }
+      Cmp->LoopDepth--;
+      return AddOp(Cmp, SEQ_TBL_OP_NEXT, Cmp->LoopCounter[Cmp->LoopDepth], Cmp->LoopBody[Cmp->LoopDepth]);
+   
+   }
+   else if (strcmp(Token, "goto") == 0)
+   {
+   
+      if (Arg == NULL || !GetLabel(Cmp, Arg, &Label))
+      {
+         return CompileError(Cmp, "invalid label");
+      }
+      Cmp->BranchLoop[Cmp->Program->OpCnt] = InnerLoop(Cmp);
+      return AddOp(Cmp, SEQ_TBL_OP_JUMP, 0, Label);
+   
+   }
+   else if (strcmp(Token, "if-high") == 0 || strcmp(Token, "if-low") == 0)
+   {
+   
+      if (Arg == NULL || !GetPin(Arg, &Pin))
+      {
+         return CompileError(Cmp, "invalid pin");
+      }
+      if (((SeqTbl->OutPinMask | GPIO_DRV_GetInMask()) & GPIO_DRV_PIN_MASK(Pin)) == 0)
+      {
+         return CompileError(Cmp, "pin is not a configured output or input pin");
+      }
+      Arg = strtok_r(NULL, TOKEN_SEPARATORS, &Save);
+      if (Arg == NULL || !GetLabel(Cmp, Arg, &Label))
+      {
+         return CompileError(Cmp, "invalid label");
+      }
+      Cmp->BranchLoop[Cmp->Program->OpCnt] = InnerLoop(Cmp);
+      return AddOp(Cmp, (Token[3] == 'h') ? SEQ_TBL_OP_IF_HIGH : SEQ_TBL_OP_IF_LOW, Pin, Label);
+   
+   }
+   else if (strcmp(Token, "stop") == 0)
+   {
+   
+      return AddOp(Cmp, SEQ_TBL_OP_STOP, 0, 0);
+   
+   }
+   
+   return CompileError(Cmp, "unknown statement");
+   
+} /* End CompileStatement() */
+
+
+/******************************************************************************
+** Function: FlushWrite
+**
+** Compile the pending set and clear statements into one write op
+**
+** Notes:
+**   1. Writes with the same masks share a Write[] entry.
+**
+*/
+static bool FlushWrite(Compiler_t* Cmp)
+{
+   
+   SEQ_TBL_Program_t* Program = Cmp->Program;
+   uint16 i;
+   
+   if (!Cmp->WritePending)
+   {
+      return true;
+   }
+   Cmp->WritePending = false;
+   
+   for (i=0; i < Program->WriteCnt; i++)
+   {
+      if (Program->Write[i].SetMask == Cmp->PendSet && Program->Write[i].ClrMask == Cmp->PendClr)
+      {
+         break;
+      }
+   }
+   
+   if (i == Program->WriteCnt)
+   {
+      if (Program->WriteCnt == SEQ_TBL_MAX_WRITES)
+      {
+         return CompileError(Cmp, "too many distinct pin writes");
+      }
+      Program->Write[i].SetMask = Cmp->PendSet;
+      Program->Write[i].ClrMask = Cmp->PendClr;
+      Program->WriteCnt++;
+   }
+   
+   Program->PinMask |= Cmp->PendSet | Cmp->PendClr;
+   Cmp->PendSet = 0;
+   Cmp->PendClr = 0;
+   
+   return AddOp(Cmp, SEQ_TBL_OP_WRITE, 0, i);
+   
+} /* End FlushWrite() */
+
+
+/******************************************************************************
+** Function: GetLabel
+**
+** Return the index of a label, adding it if it hasn't been used before
+**
+*/
+static bool GetLabel(Compiler_t* Cmp, const char* Name, uint16* Label)
+{
+   
+   uint16 i;
+   
+   if (strlen(Name) > SEQ_TBL_LABEL_MAX_LEN)
+   {
+      return false;
+   }
+   
+   for (i=0; i < Cmp->LabelCnt; i++)
+   {
+      if (strcmp(Cmp->Label[i].Name, Name) == 0)
+      {
+         *Label = i;
+         return true;
+      }
+   }
+   
+   if (Cmp->LabelCnt == SEQ_TBL_MAX_LABELS)
+   {
+      return false;
+   }
+   
+   strcpy(Cmp->Label[Cmp->LabelCnt].Name, Name);
+   Cmp->Label[Cmp->LabelCnt].Defined = false;
+   *Label = Cmp->LabelCnt++;
+   
+   return true;
+   
+} /* End GetLabel() */
+
+
+/******************************************************************************
+** Function: GetPin
+**
+*/
+static bool GetPin(const char* Token, uint32* Pin)
+{
+   
+   return GetUint(Token, GPIO_DRV_MAX_PIN, Pin);
+   
+} /* End GetPin() */
+
+
+/******************************************************************************
+** Function: GetUint
+**
+*/
+static bool GetUint(const char* Token, uint32 Max, uint32* Value)
+{
+   
+   char* End;
+   unsigned long Num;
+   
+   if (Token[0] < '0' || Token[0] > '9')
+   {
+      return false;
+   }
+   
+   Num = strtoul(Token, &End, 10);
+   *Value = (uint32)Num;
+   
+   return (*End == '\0' && Num <= Max);
+   
+} /* End GetUint() */
+
+
+/******************************************************************************
+** Function: InLoop
+**
+** Return true if Loop is Outer or nested in Outer. Every loop is in
+** NO_LOOP.
+**
+*/
+static bool InLoop(const Compiler_t* Cmp, uint8 Loop, uint8 Outer)
+{
+   
+   while (Loop != Outer && Loop != NO_LOOP)
+   {
+      Loop = Cmp->LoopParent[Loop];
+   }
+   
+   return (Loop == Outer);
+   
+} /* End InLoop() */
+
+
+/******************************************************************************
+** Function: InnerLoop
+**
+** Return the innermost open loop or NO_LOOP
+**
+*/
+static uint8 InnerLoop(const Compiler_t* Cmp)
+{
+   
+   return (Cmp->LoopDepth > 0) ? Cmp->LoopCounter[Cmp->LoopDepth-1] : NO_LOOP;
+   
+} /* End InnerLoop() */
+
+
+/******************************************************************************
+** Function: LoadJsonData
+**
+** Compile the JSON statements into the unpublished Program[] entry
+**
+** Notes:
+**   1. Jump and branch ops hold label indices until every statement has
+**      been compiled and are then resolved to op indices.
+**   2. A jump or branch into a loop it isn't in is rejected. It would reach
+**      the loop's next op without the loop op setting the counter, which
+**      could then wrap and repeat the body 65535 more times.
+**
+*/
+static bool LoadJsonData(size_t JsonFileLen)
+{
+   
+   SEQ_TBL_Program_t* Program = &SeqTbl->Program[SeqTbl->PubIdx ^ 1];
+   SEQ_TBL_Op_t* Op;
+   Compiler_t Cmp;
+   char   Query[QUERY_MAX_LEN];
+   char   Line[SEQ_TBL_LINE_MAX_LEN];
+   char*  JsonVal;
+   size_t JsonValLen;
+   bool   RetStatus = true;
+   uint16 i;
+   
+   SeqTbl->JsonFileLen = JsonFileLen;
+   memset(Program, 0, sizeof(SEQ_TBL_Program_t));
+   memset(&Cmp, 0, sizeof(Compiler_t));
+   Cmp.Program = Program;
+   
+   for (Cmp.Statement=0; RetStatus; Cmp.Statement++)
+   {
+   
+      snprintf(Query, sizeof(Query), "program[%u]", Cmp.Statement);
+      if (JSON_Search(SeqTbl->JsonBuf, SeqTbl->JsonFileLen, Query, strlen(Query),
+                      &JsonVal, &JsonValLen) != JSONSuccess)
+      {
+         break;
+      }
+   
+      if (JsonValLen >= SEQ_TBL_LINE_MAX_LEN)
+      {
+         JsonValLen = SEQ_TBL_LINE_MAX_LEN - 1;
+         strncpy(Cmp.Line, JsonVal, JsonValLen);
+         Cmp.Line[JsonValLen] = '\0';
+         RetStatus = CompileError(&Cmp, "statement too long");
+      }
+      else
+      {
+         memcpy(Cmp.Line, JsonVal, JsonValLen);
+         Cmp.Line[JsonValLen] = '\0';
+         strcpy(Line, Cmp.Line);
+         RetStatus = CompileStatement(&Cmp, Line);
+      }
+   
+   } /* End JSON statement loop */
+   
+   if (RetStatus)
+   {
+      strcpy(Cmp.Line, "end of program");
+      RetStatus = FlushWrite(&Cmp);
+   }
+   if (RetStatus && Cmp.LoopDepth > 0)
+   {
+      RetStatus = CompileError(&Cmp, "loop without next");
+   }
+   
+   if (RetStatus)
+   {
+      Program->Op[Program->OpCnt++].Op = SEQ_TBL_OP_STOP;
+      for (i=0; i < Program->OpCnt && RetStatus; i++)
+      {
+         Op = &Program->Op[i];
+         if (Op->Op == SEQ_TBL_OP_JUMP || Op->Op == SEQ_TBL_OP_IF_HIGH || Op->Op == SEQ_TBL_OP_IF_LOW)
+         {
+            snprintf(Cmp.Line, sizeof(Cmp.Line), "%s", Cmp.Label[Op->B].Name);
+            if (!Cmp.Label[Op->B].Defined)
+            {
+               RetStatus = CompileError(&Cmp, "undefined label");
+            }
+            else if (!InLoop(&Cmp, Cmp.BranchLoop[i], Cmp.Label[Op->B].Loop))
+            {
+               RetStatus = CompileError(&Cmp, "branch into loop body");
+            }
+            Op->B = Cmp.Label[Op->B].Op;
+         }
+      }
+   }
+   
+   if (!RetStatus)
+   {
+      Program->OpCnt = 0;
+   }
+   
+   return RetStatus;
+   
+} /* End LoadJsonData() */
+
+
+/******************************************************************************
+** Function: OpStr
+**
+*/
+static const char* OpStr(uint8 Op)
+{
+   
+   static const char* Str[SEQ_TBL_OP_CNT] =
+   {
+      "stop", "write", "wait", "loop", "next", "goto", "if-high", "if-low"
+   };
+   
+   return (Op < SEQ_TBL_OP_CNT) ? Str[Op] : "unknown";
+   
+} /* End OpStr() */
+
+
+/******************************************************************************
+** Function: PinListStr
+**
+** Write PinMask as a comma separated pin list without spaces. PinList must
+** hold PIN_LIST_MAX_LEN characters.
+**
+*/
+static void PinListStr(char* PinList, uint64 PinMask)
+{
+   
+   uint64 Pins = PinMask;
+   int    Len  = 0;
+   
+   PinList[0] = '\0';
+   while (Pins != 0)
+   {
+      Len += sprintf(&PinList[Len], (Len == 0) ? "%u" : ",%u", __builtin_ctzll(Pins));
+      Pins &= Pins - 1;
+   }
+   
+} /* End PinListStr() */
+
+
+/******************************************************************************
+** Function: Withdraw
+**
+** Publish the program the child task is running again in place of the
+** unstarted program in PubIdx. Returns false if the child task started it
+** first.
+**
+** Notes:
+**   1. Same handshake as SEQ_TBL_GetProgram(), see PATTERN_TBL's
+**      Withdraw().
+**
+*/
+static bool Withdraw(uint32 PubIdx)
+{
+   
+   __atomic_store_n(&SeqTbl->PubIdx, PubIdx ^ 1, __ATOMIC_SEQ_CST);
+   
+   if (__atomic_load_n(&SeqTbl->UseIdx, __ATOMIC_SEQ_CST) == PubIdx)
+   {
+      __atomic_store_n(&SeqTbl->PubIdx, PubIdx, __ATOMIC_SEQ_CST);
+      return false;
+   }
+   
+   CFE_EVS_SendEvent(SEQ_TBL_LOAD_EID, CFE_EVS_EventType_INFORMATION,
+                     "Sequence table load replaces the previous load, which the controller hasn't started (GPIO unmapped?)");
+   
+   return true;
+   
+} /* End Withdraw() */
+
+
+/******************************************************************************
+** Function: WriteStatement
+**
+** Write one program array entry
+**
+*/
+static void WriteStatement(osal_id_t FileHandle, const char* Statement, bool* First)
+{
+   
+   char DumpRecord[PIN_LIST_MAX_LEN+32];
+   
+   sprintf(DumpRecord, "%s\n      \"%s\"", *First ? "" : ",", Statement);
+   OS_write(FileHandle, DumpRecord, strlen(DumpRecord));
+   *First = false;
+   
+} /* End WriteStatement() */
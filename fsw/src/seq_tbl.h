@@ -0,0 +1,243 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Define the Sequence Table
+**
+**  Notes:
+**    1. A sequence is a JSON table holding a small GPIO script, one
+**       statement per string, see seq_tbl.c for the language.
+**    2. A load compiles the script into 4 byte ops so the child task
+**       dispatches ops without any parsing or memory allocation. Jump
+**       targets and loop counters are resolved when the table is loaded.
+**    3. Two compiled programs are kept and handed to the child task the
+**       same way as the pattern table, see SEQ_TBL_GetProgram().
+**
+**  References:
+**    1. OpenSatKit Object-based Application Developer's Guide.
+**    2. cFS Application Developer's Guide.
+**
+*/
+
+#ifndef _seq_tbl_
+#define _seq_tbl_
+
+/*
+** Includes
+*/
+
+#include "app_cfg.h"
+#include "tblmgr.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define SEQ_TBL_MAX_OPS      1024
+#define SEQ_TBL_MAX_WRITES    256   /* Distinct set/clear mask pairs */
+#define SEQ_TBL_MAX_LOOPS      16   /* Loop statements, each has its own counter */
+#define SEQ_TBL_MAX_LABELS     64
+#define SEQ_TBL_MAX_STATEMENTS 1024
+#define SEQ_TBL_JSON_FILE_MAX_CHAR  (SEQ_TBL_MAX_STATEMENTS*40)
+
+#define SEQ_TBL_MAX_WAIT_US  0xFFFFFF   /* Longest wait op, longer waits compile to several ops */
+
+#define SEQ_TBL_IDLE  2   /* UseIdx when the child task isn't running a sequence */
+
+/*
+** Opcodes
+** - Op fields A and B are described for each opcode, targets are op
+**   indices
+*/
+
+#define SEQ_TBL_OP_STOP     0   /* End the sequence */
+#define SEQ_TBL_OP_WRITE    1   /* B: Write[] index */
+#define SEQ_TBL_OP_WAIT     2   /* A:B: 24-bit microseconds */
+#define SEQ_TBL_OP_LOOP     3   /* A: counter, B: iterations */
+#define SEQ_TBL_OP_NEXT     4   /* A: counter, B: first op of the loop body */
+#define SEQ_TBL_OP_JUMP     5   /* B: target */
+#define SEQ_TBL_OP_IF_HIGH  6   /* A: pin, B: target */
+#define SEQ_TBL_OP_IF_LOW   7   /* A: pin, B: target */
+#define SEQ_TBL_OP_CNT      8
+
+#define SEQ_TBL_WAIT_US(Op)  (((uint32)(Op)->A << 16) | (Op)->B)
+
+/*
+** Event Message IDs
+*/
+
+#define SEQ_TBL_LOAD_EID  (SEQ_TBL_BASE_EID + 0)
+#define SEQ_TBL_DUMP_EID  (SEQ_TBL_BASE_EID + 1)
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+
+/******************************************************************************
+** Compiled program
+** - A program always ends with a STOP op so the child task never checks
+**   the op index against OpCnt
+*/
+
+typedef struct
+{
+
+   uint8   Op;
+   uint8   A;
+   uint16  B;
+
+} SEQ_TBL_Op_t;
+
+typedef struct
+{
+
+   uint64  SetMask;
+   uint64  ClrMask;
+
+} SEQ_TBL_Write_t;
+
+typedef struct
+{
+
+   uint16  OpCnt;      /* 0 when no sequence has been loaded */
+   uint16  WriteCnt;
+   uint16  LoopCnt;
+   uint16  Spare;
+   uint64  PinMask;    /* All pins written by the sequence */
+   SEQ_TBL_Op_t    Op[SEQ_TBL_MAX_OPS];
+   SEQ_TBL_Write_t Write[SEQ_TBL_MAX_WRITES];
+
+} SEQ_TBL_Program_t;
+
+
+/******************************************************************************
+** Class
+*/
+
+typedef struct
+{
+
+   /*
+   ** Configuration
+   */
+
+   uint64  OutPinMask;   /* Pins a sequence may write */
+
+   /*
+   ** Class State Data
+   */
+
+   uint8   LastLoadStatus;
+   uint16  LoadCnt;
+
+   size_t  JsonFileLen;
+   char    JsonBuf[SEQ_TBL_JSON_FILE_MAX_CHAR];
+
+   uint32  PubIdx;   /* Program[] entry published to the child task */
+   uint32  UseIdx;   /* Program[] entry read by the child task or SEQ_TBL_IDLE */
+   SEQ_TBL_Program_t Program[2];
+
+} SEQ_TBL_Class_t;
+
+
+/************************/
+/** Exported Functions **/
+/************************/
+
+
+/******************************************************************************
+** Function: SEQ_TBL_Constructor
+**
+** Initialize the Sequence Table object to a known state
+**
+** Notes:
+**   1. This must be called prior to any other function.
+**   2. OutPinMask limits the pins a table may write to the configured
+**      outputs. A branch may test an output or a GPIO_DRV_ConfigIn() pin.
+**
+*/
+void SEQ_TBL_Constructor(SEQ_TBL_Class_t *SeqTblPtr, uint64 OutPinMask);
+
+
+/******************************************************************************
+** Function: SEQ_TBL_DumpCmd
+**
+** Write the compiled program to a JSON file
+**
+** Notes:
+**   1. Function signature must match TBLMGR_DumpTblFuncPtr_t.
+**   2. The program is dumped as statements that compile to the same ops,
+**      labels are named after their op index.
+**
+*/
+bool SEQ_TBL_DumpCmd(TBLMGR_Tbl_t* Tbl, uint8 DumpType, const char* Filename);
+
+
+/******************************************************************************
+** Function: SEQ_TBL_GetProgram
+**
+** Return the published program for the child task
+**
+** Notes:
+**   1. Only the child task may call this. The returned program is not
+**      modified until the next call or SEQ_TBL_Release().
+**
+*/
+const SEQ_TBL_Program_t* SEQ_TBL_GetProgram(void);
+
+
+/******************************************************************************
+** Function: SEQ_TBL_IsLoaded
+**
+*/
+bool SEQ_TBL_IsLoaded(void);
+
+
+/******************************************************************************
+** Function: SEQ_TBL_LoadCmd
+**
+** Load and compile a sequence JSON file
+**
+** Notes:
+**   1. Function signature must match TBLMGR_LoadTblFuncPtr_t.
+**   2. Only complete replacement loads are supported.
+**   3. A load is rejected while the child task is still reading the
+**      program from the previous load.
+**
+*/
+bool SEQ_TBL_LoadCmd(TBLMGR_Tbl_t* Tbl, uint8 LoadType, const char* Filename);
+
+
+/******************************************************************************
+** Function: SEQ_TBL_Release
+**
+** Called by the child task when it stops running a sequence
+**
+*/
+void SEQ_TBL_Release(void);
+
+
+/******************************************************************************
+** Function: SEQ_TBL_ResetStatus
+**
+** Reset counters and status flags to a known reset state.
+**
+*/
+void SEQ_TBL_ResetStatus(void);
+
+
+#endif /* _seq_tbl_ */
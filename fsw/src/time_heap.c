@@ -0,0 +1,178 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Implement the bounded min-heap methods
+**
+**  Notes:
+**    1. The heap is stored in the node array with the children of node i
+**       at 2i+1 and 2i+2. Sifts move a hole instead of swapping so each
+**       level costs one node copy.
+**
+*/
+
+/*
+** Include Files:
+*/
+
+#include <string.h>
+
+#include "time_heap.h"
+
+
+/*******************************/
+/** Local Function Prototypes **/
+/*******************************/
+
+static bool Before(const TIME_HEAP_Node_t *A, const TIME_HEAP_Node_t *B);
+
+
+/******************************************************************************
+** Function: TIME_HEAP_Constructor
+**
+*/
+void TIME_HEAP_Constructor(TIME_HEAP_Class_t *TimeHeap, TIME_HEAP_Node_t *Node, uint16 NodeCnt)
+{
+
+   memset(TimeHeap, 0, sizeof(TIME_HEAP_Class_t));
+
+   TimeHeap->Node    = Node;
+   TimeHeap->NodeCnt = NodeCnt;
+
+} /* End TIME_HEAP_Constructor() */
+
+
+/******************************************************************************
+** Function: TIME_HEAP_Peek
+**
+*/
+bool TIME_HEAP_Peek(const TIME_HEAP_Class_t *TimeHeap, uint64 *TimeNs)
+{
+
+   if (TimeHeap->Cnt == 0)
+   {
+      return false;
+   }
+
+   *TimeNs = TimeHeap->Node[0].TimeNs;
+
+   return true;
+
+} /* End TIME_HEAP_Peek() */
+
+
+/******************************************************************************
+** Function: TIME_HEAP_Pop
+**
+** Notes:
+**   1. The last node is sifted down from the root into the hole left by the
+**      popped node.
+**
+*/
+bool TIME_HEAP_Pop(TIME_HEAP_Class_t *TimeHeap, uint16 *Id)
+{
+
+   TIME_HEAP_Node_t *Node = TimeHeap->Node;
+   TIME_HEAP_Node_t  Last;
+   uint32 Hole = 0;
+   uint32 Child;
+
+   if (TimeHeap->Cnt == 0)
+   {
+      return false;
+   }
+
+   *Id  = Node[0].Id;
+   Last = Node[--TimeHeap->Cnt];
+
+   while ((Child = 2*Hole + 1) < TimeHeap->Cnt)
+   {
+      if (Child + 1 < TimeHeap->Cnt && Before(&Node[Child+1], &Node[Child]))
+      {
+         Child++;
+      }
+      if (!Before(&Node[Child], &Last))
+      {
+         break;
+      }
+      Node[Hole] = Node[Child];
+      Hole = Child;
+   }
+   Node[Hole] = Last;
+
+   return true;
+
+} /* End TIME_HEAP_Pop() */
+
+
+/******************************************************************************
+** Function: TIME_HEAP_Push
+**
+*/
+bool TIME_HEAP_Push(TIME_HEAP_Class_t *TimeHeap, uint64 TimeNs, uint16 Id)
+{
+
+   TIME_HEAP_Node_t *Node = TimeHeap->Node;
+   TIME_HEAP_Node_t  New;
+   uint32 Hole;
+   uint32 Parent;
+
+   if (TimeHeap->Cnt >= TimeHeap->NodeCnt)
+   {
+      return false;
+   }
+
+   New.TimeNs = TimeNs;
+   New.Seq    = TimeHeap->PushSeq++;
+   New.Id     = Id;
+
+   Hole = TimeHeap->Cnt++;
+   while (Hole > 0)
+   {
+      Parent = (Hole - 1) / 2;
+      if (!Before(&New, &Node[Parent]))
+      {
+         break;
+      }
+      Node[Hole] = Node[Parent];
+      Hole = Parent;
+   }
+   Node[Hole] = New;
+
+   return true;
+
+} /* End TIME_HEAP_Push() */
+
+
+/******************************************************************************
+** Function: Before
+**
+** Return true if node A must be popped before node B
+**
+** Notes:
+**   1. Seq is compared as a signed difference so ties stay in push order
+**      when the counter wraps.
+**
+*/
+static bool Before(const TIME_HEAP_Node_t *A, const TIME_HEAP_Node_t *B)
+{
+
+   if (A->TimeNs != B->TimeNs)
+   {
+      return (A->TimeNs < B->TimeNs);
+   }
+
+   return ((int32)(A->Seq - B->Seq) < 0);
+
+} /* End Before() */
@@ -0,0 +1,136 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Define a bounded binary min-heap of deadlines
+**
+**  Notes:
+**    1. Each entry is a nanosecond deadline and a caller defined Id, e.g.
+**       an index into the caller's array of pending actions. Push and pop
+**       are O(log n) and peek is O(1).
+**    2. Entries with equal deadlines are popped in the order they were
+**       pushed.
+**    3. The caller owns the node array, 16 bytes per entry. The heap never
+**       allocates memory and has no cFE dependencies so it can be built on
+**       a host.
+**
+*/
+
+#ifndef _time_heap_
+#define _time_heap_
+
+/*
+** Includes
+*/
+
+#include "common_types.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define TIME_HEAP_MAX_NODE  0xFFFF
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+
+/******************************************************************************
+** Heap node
+*/
+
+typedef struct
+{
+
+   uint64  TimeNs;
+   uint32  Seq;      /* Push order, breaks deadline ties */
+   uint16  Id;
+
+} TIME_HEAP_Node_t;
+
+
+/******************************************************************************
+** Class
+*/
+
+typedef struct
+{
+
+   uint16  NodeCnt;
+   uint16  Cnt;
+   uint32  PushSeq;
+
+   TIME_HEAP_Node_t* Node;
+
+} TIME_HEAP_Class_t;
+
+
+/************************/
+/** Exported Functions **/
+/************************/
+
+
+/******************************************************************************
+** Function: TIME_HEAP_Constructor
+**
+** Initialize an empty heap
+**
+** Notes:
+**   1. Node must have NodeCnt entries, at most TIME_HEAP_MAX_NODE, and stay
+**      valid for the life of the heap.
+**
+*/
+void TIME_HEAP_Constructor(TIME_HEAP_Class_t *TimeHeap, TIME_HEAP_Node_t *Node, uint16 NodeCnt);
+
+
+/******************************************************************************
+** Function: TIME_HEAP_Peek
+**
+** Return the earliest deadline without removing it
+**
+** Notes:
+**   1. Returns false when the heap is empty.
+**
+*/
+bool TIME_HEAP_Peek(const TIME_HEAP_Class_t *TimeHeap, uint64 *TimeNs);
+
+
+/******************************************************************************
+** Function: TIME_HEAP_Pop
+**
+** Remove the entry with the earliest deadline and return its Id
+**
+** Notes:
+**   1. Returns false when the heap is empty.
+**
+*/
+bool TIME_HEAP_Pop(TIME_HEAP_Class_t *TimeHeap, uint16 *Id);
+
+
+/******************************************************************************
+** Function: TIME_HEAP_Push
+**
+** Add Id with deadline TimeNs
+**
+** Notes:
+**   1. Returns false, without adding the entry, when the heap is full.
+**
+*/
+bool TIME_HEAP_Push(TIME_HEAP_Class_t *TimeHeap, uint64 TimeNs, uint16 Id);
+
+
+#endif /* _time_heap_ */
@@ -0,0 +1,365 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Implement the hierarchical timer wheel methods
+**
+**  Notes:
+**    1. See timer_wheel.h for the level layout. Slot lists are doubly
+**       linked through node indices so a timer is removed without a search.
+**
+**  References:
+**    1. G. Varghese and T. Lauck, "Hashed and Hierarchical Timing Wheels".
+**
+*/
+
+/*
+** Include Files:
+*/
+
+#include <string.h>
+
+#include "timer_wheel.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+/* First slot and tick shift of higher level N, 1..TIMER_WHEEL_LN_CNT */
+#define LN_SLOT_BASE(N)  (TIMER_WHEEL_L0_SLOTS + ((N)-1)*TIMER_WHEEL_LN_SLOTS)
+#define LN_SHIFT(N)      (TIMER_WHEEL_L0_BITS + ((N)-1)*TIMER_WHEEL_LN_BITS)
+
+
+/*******************************/
+/** Local Function Prototypes **/
+/*******************************/
+
+static void   Cascade(TIMER_WHEEL_Class_t *TimerWheel);
+static uint32 FindL0(const TIMER_WHEEL_Class_t *TimerWheel, uint32 Idx);
+static void   Insert(TIMER_WHEEL_Class_t *TimerWheel, uint16 Id);
+static uint16 TakeSlot(TIMER_WHEEL_Class_t *TimerWheel, uint16 Slot, uint16 *IdBuf);
+
+
+/******************************************************************************
+** Function: TIMER_WHEEL_Constructor
+**
+*/
+void TIMER_WHEEL_Constructor(TIMER_WHEEL_Class_t *TimerWheel, TIMER_WHEEL_Node_t *Node,
+                             uint16 NodeCnt, uint32 Now)
+{
+
+   uint16 i;
+
+   memset(TimerWheel, 0, sizeof(TIMER_WHEEL_Class_t));
+
+   TimerWheel->Now     = Now;
+   TimerWheel->Node    = Node;
+   TimerWheel->NodeCnt = (NodeCnt > TIMER_WHEEL_MAX_NODE) ? TIMER_WHEEL_MAX_NODE : NodeCnt;
+
+   for (i=0; i < TIMER_WHEEL_SLOTS; i++)
+   {
+      TimerWheel->Slot[i] = TIMER_WHEEL_NONE;
+   }
+   for (i=0; i < TimerWheel->NodeCnt; i++)
+   {
+      Node[i].Next = TIMER_WHEEL_NONE;
+      Node[i].Prev = TIMER_WHEEL_NONE;
+   }
+
+} /* End TIMER_WHEEL_Constructor() */
+
+
+/******************************************************************************
+** Function: TIMER_WHEEL_Add
+**
+*/
+void TIMER_WHEEL_Add(TIMER_WHEEL_Class_t *TimerWheel, uint16 Id, uint32 Expires)
+{
+
+   if (Id < TimerWheel->NodeCnt)
+   {
+      TIMER_WHEEL_Remove(TimerWheel, Id);
+      TimerWheel->Node[Id].Expires = Expires;
+      Insert(TimerWheel, Id);
+      TimerWheel->PendingCnt++;
+   }
+
+} /* End TIMER_WHEEL_Add() */
+
+
+/******************************************************************************
+** Function: TIMER_WHEEL_Expire
+**
+** Notes:
+**   1. Each pass either expires the slot at Now or skips straight to the
+**      next occupied level 0 slot or level 0 wrap, so the cost depends on
+**      the number of expired timers and wraps, not the number of ticks.
+**
+*/
+uint16 TIMER_WHEEL_Expire(TIMER_WHEEL_Class_t *TimerWheel, uint32 Tick, uint16 *IdBuf)
+{
+
+   uint16 Cnt = 0;
+   uint32 Idx;
+   uint32 Next;
+
+   while ((int32)(Tick - TimerWheel->Now) >= 0)
+   {
+
+      Idx = TimerWheel->Now & TIMER_WHEEL_L0_MASK;
+      if (Idx == 0)
+      {
+         Cascade(TimerWheel);
+      }
+
+      Next = FindL0(TimerWheel, Idx);
+      if (Next - Idx > Tick - TimerWheel->Now)
+      {
+         TimerWheel->Now = Tick + 1;
+         break;
+      }
+
+      TimerWheel->Now += Next - Idx;
+      if (Next < TIMER_WHEEL_L0_SLOTS)
+      {
+         Cnt += TakeSlot(TimerWheel, Next, &IdBuf[Cnt]);
+         TimerWheel->Now++;
+      }
+
+   } /* End tick loop */
+
+   TimerWheel->PendingCnt -= Cnt;
+
+   return Cnt;
+
+} /* End TIMER_WHEEL_Expire() */
+
+
+/******************************************************************************
+** Function: TIMER_WHEEL_NextTick
+**
+*/
+bool TIMER_WHEEL_NextTick(const TIMER_WHEEL_Class_t *TimerWheel, uint32 *Tick)
+{
+
+   uint32 Idx = TimerWheel->Now & TIMER_WHEEL_L0_MASK;
+
+   if (TimerWheel->PendingCnt == 0)
+   {
+      return false;
+   }
+
+   /* A level 0 wrap at Now hasn't cascaded yet so it is the next tick */
+   *Tick = (Idx == 0) ? TimerWheel->Now : TimerWheel->Now + (FindL0(TimerWheel, Idx) - Idx);
+
+   return true;
+
+} /* End TIMER_WHEEL_NextTick() */
+
+
+/******************************************************************************
+** Function: TIMER_WHEEL_Remove
+**
+*/
+void TIMER_WHEEL_Remove(TIMER_WHEEL_Class_t *TimerWheel, uint16 Id)
+{
+
+   TIMER_WHEEL_Node_t *Node;
+   uint16 Slot;
+
+   if (Id >= TimerWheel->NodeCnt || TimerWheel->Node[Id].Prev == TIMER_WHEEL_NONE)
+   {
+      return;
+   }
+
+   Node = &TimerWheel->Node[Id];
+   if (Node->Next != TIMER_WHEEL_NONE)
+   {
+      TimerWheel->Node[Node->Next].Prev = Node->Prev;
+   }
+
+   if (Node->Prev & TIMER_WHEEL_HEAD)
+   {
+      Slot = Node->Prev & ~TIMER_WHEEL_HEAD;
+      TimerWheel->Slot[Slot] = Node->Next;
+      if (Slot < TIMER_WHEEL_L0_SLOTS && Node->Next == TIMER_WHEEL_NONE)
+      {
+         TimerWheel->L0Map[Slot >> 6] &= ~(1ULL << (Slot & 63));
+      }
+   }
+   else
+   {
+      TimerWheel->Node[Node->Prev].Next = Node->Next;
+   }
+
+   Node->Next = TIMER_WHEEL_NONE;
+   Node->Prev = TIMER_WHEEL_NONE;
+   TimerWheel->PendingCnt--;
+
+} /* End TIMER_WHEEL_Remove() */
+
+
+/******************************************************************************
+** Function: Cascade
+**
+** Move the timers of the higher level slots that start at Now down a level
+**
+** Notes:
+**   1. Called when level 0 wraps. Level N+1 only cascades when level N
+**      wraps too.
+**
+*/
+static void Cascade(TIMER_WHEEL_Class_t *TimerWheel)
+{
+
+   uint16 Level;
+   uint16 Slot;
+   uint16 Id;
+   uint16 Next;
+   uint32 Idx;
+
+   for (Level=1; Level <= TIMER_WHEEL_LN_CNT; Level++)
+   {
+
+      Idx  = (TimerWheel->Now >> LN_SHIFT(Level)) & TIMER_WHEEL_LN_MASK;
+      Slot = LN_SLOT_BASE(Level) + Idx;
+
+      Id = TimerWheel->Slot[Slot];
+      TimerWheel->Slot[Slot] = TIMER_WHEEL_NONE;
+      while (Id != TIMER_WHEEL_NONE)
+      {
+         Next = TimerWheel->Node[Id].Next;
+         Insert(TimerWheel, Id);
+         TimerWheel->CascadeCnt++;
+         Id = Next;
+      }
+
+      if (Idx != 0)
+      {
+         break;
+      }
+
+   } /* End level loop */
+
+} /* End Cascade() */
+
+
+/******************************************************************************
+** Function: FindL0
+**
+** Return the first occupied level 0 slot at or after Idx
+**
+** Notes:
+**   1. Returns TIMER_WHEEL_L0_SLOTS when the rest of level 0 is empty.
+**
+*/
+static uint32 FindL0(const TIMER_WHEEL_Class_t *TimerWheel, uint32 Idx)
+{
+
+   uint32 Word = Idx >> 6;
+   uint64 Bits = TimerWheel->L0Map[Word] & (~0ULL << (Idx & 63));
+
+   while (Bits == 0)
+   {
+      if (++Word == TIMER_WHEEL_L0_WORDS)
+      {
+         return TIMER_WHEEL_L0_SLOTS;
+      }
+      Bits = TimerWheel->L0Map[Word];
+   }
+
+   return (Word << 6) + __builtin_ctzll(Bits);
+
+} /* End FindL0() */
+
+
+/******************************************************************************
+** Function: Insert
+**
+** Link timer Id into the slot for its expiry time relative to Now
+**
+** Notes:
+**   1. A timer that is already due is put in Now's level 0 slot.
+**
+*/
+static void Insert(TIMER_WHEEL_Class_t *TimerWheel, uint16 Id)
+{
+
+   TIMER_WHEEL_Node_t *Node = &TimerWheel->Node[Id];
+   uint32 Expires = Node->Expires;
+   uint32 Delta   = Expires - TimerWheel->Now;
+   uint16 Level;
+   uint16 Slot;
+
+   if ((int32)Delta < 0)
+   {
+      Expires = TimerWheel->Now;
+      Delta   = 0;
+   }
+
+   if (Delta < TIMER_WHEEL_L0_SLOTS)
+   {
+      Slot = Expires & TIMER_WHEEL_L0_MASK;
+      TimerWheel->L0Map[Slot >> 6] |= (1ULL << (Slot & 63));
+   }
+   else
+   {
+      Level = 1;
+      while (Level < TIMER_WHEEL_LN_CNT && (Delta >> LN_SHIFT(Level+1)) != 0)
+      {
+         Level++;
+      }
+      Slot = LN_SLOT_BASE(Level) + ((Expires >> LN_SHIFT(Level)) & TIMER_WHEEL_LN_MASK);
+   }
+
+   Node->Prev = TIMER_WHEEL_HEAD | Slot;
+   Node->Next = TimerWheel->Slot[Slot];
+   if (Node->Next != TIMER_WHEEL_NONE)
+   {
+      TimerWheel->Node[Node->Next].Prev = Id;
+   }
+   TimerWheel->Slot[Slot] = Id;
+
+} /* End Insert() */
+
+
+/******************************************************************************
+** Function: TakeSlot
+**
+** Unlink every timer in a level 0 slot and write their IDs to IdBuf
+**
+*/
+static uint16 TakeSlot(TIMER_WHEEL_Class_t *TimerWheel, uint16 Slot, uint16 *IdBuf)
+{
+
+   uint16 Cnt = 0;
+   uint16 Id  = TimerWheel->Slot[Slot];
+   TIMER_WHEEL_Node_t *Node;
+
+   while (Id != TIMER_WHEEL_NONE)
+   {
+      Node = &TimerWheel->Node[Id];
+      IdBuf[Cnt++] = Id;
+      Id = Node->Next;
+      Node->Next = TIMER_WHEEL_NONE;
+      Node->Prev = TIMER_WHEEL_NONE;
+   }
+
+   TimerWheel->Slot[Slot] = TIMER_WHEEL_NONE;
+   TimerWheel->L0Map[Slot >> 6] &= ~(1ULL << (Slot & 63));
+
+   return Cnt;
+
+} /* End TakeSlot() */
@@ -0,0 +1,178 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Define a hierarchical timer wheel
+**
+**  Notes:
+**    1. Timers are identified by a node index and expire on a uint32 tick
+**       timeline that may wrap. Expiry times more than 2^31 ticks ahead are
+**       treated as already expired.
+**    2. Level 0 has one slot per tick for the next TIMER_WHEEL_L0_SLOTS
+**       ticks. Each higher level has TIMER_WHEEL_LN_SLOTS slots that each
+**       cover a full lap of the level below and are cascaded down when the
+**       level below wraps. Add, remove and expire are O(1) per timer.
+**    3. A level 0 occupancy bitmap lets TIMER_WHEEL_NextTick() and
+**       TIMER_WHEEL_Expire() skip empty ticks without visiting each slot.
+**    4. The caller owns the node array, 8 bytes per timer. The wheel never
+**       allocates memory and has no cFE dependencies so it can be built on
+**       a host.
+**
+**  References:
+**    1. G. Varghese and T. Lauck, "Hashed and Hierarchical Timing Wheels".
+**
+*/
+
+#ifndef _timer_wheel_
+#define _timer_wheel_
+
+/*
+** Includes
+*/
+
+#include "common_types.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define TIMER_WHEEL_L0_BITS   10
+#define TIMER_WHEEL_L0_SLOTS  (1 << TIMER_WHEEL_L0_BITS)
+#define TIMER_WHEEL_L0_MASK   (TIMER_WHEEL_L0_SLOTS - 1)
+#define TIMER_WHEEL_L0_WORDS  (TIMER_WHEEL_L0_SLOTS / 64)
+
+#define TIMER_WHEEL_LN_BITS   6
+#define TIMER_WHEEL_LN_SLOTS  (1 << TIMER_WHEEL_LN_BITS)
+#define TIMER_WHEEL_LN_MASK   (TIMER_WHEEL_LN_SLOTS - 1)
+#define TIMER_WHEEL_LN_CNT    4    /* 10 + 4*6 bits covers the uint32 timeline */
+
+#define TIMER_WHEEL_SLOTS     (TIMER_WHEEL_L0_SLOTS + TIMER_WHEEL_LN_CNT*TIMER_WHEEL_LN_SLOTS)
+
+#define TIMER_WHEEL_MAX_NODE  0x7FFF
+#define TIMER_WHEEL_NONE      0xFFFF
+#define TIMER_WHEEL_HEAD      0x8000   /* Node Prev flag, the low bits are the slot */
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+
+/******************************************************************************
+** Timer node
+** - Prev is TIMER_WHEEL_NONE when the timer isn't pending
+*/
+
+typedef struct
+{
+
+   uint32  Expires;
+   uint16  Next;
+   uint16  Prev;
+
+} TIMER_WHEEL_Node_t;
+
+
+/******************************************************************************
+** Class
+*/
+
+typedef struct
+{
+
+   uint32  Now;          /* First tick that hasn't been expired */
+   uint16  NodeCnt;
+   uint16  PendingCnt;
+   uint32  CascadeCnt;   /* Timers moved down a level */
+
+   TIMER_WHEEL_Node_t* Node;
+
+   uint64  L0Map[TIMER_WHEEL_L0_WORDS];
+   uint16  Slot[TIMER_WHEEL_SLOTS];   /* First node in each slot */
+
+} TIMER_WHEEL_Class_t;
+
+
+/************************/
+/** Exported Functions **/
+/************************/
+
+
+/******************************************************************************
+** Function: TIMER_WHEEL_Constructor
+**
+** Initialize a timer wheel with no pending timers
+**
+** Notes:
+**   1. Node must have NodeCnt entries, at most TIMER_WHEEL_MAX_NODE, and
+**      stay valid for the life of the wheel.
+**
+*/
+void TIMER_WHEEL_Constructor(TIMER_WHEEL_Class_t *TimerWheel, TIMER_WHEEL_Node_t *Node,
+                             uint16 NodeCnt, uint32 Now);
+
+
+/******************************************************************************
+** Function: TIMER_WHEEL_Add
+**
+** Start timer Id to expire at tick Expires
+**
+** Notes:
+**   1. A pending timer is rescheduled.
+**   2. A timer that is already due expires at the next expired tick.
+**
+*/
+void TIMER_WHEEL_Add(TIMER_WHEEL_Class_t *TimerWheel, uint16 Id, uint32 Expires);
+
+
+/******************************************************************************
+** Function: TIMER_WHEEL_Expire
+**
+** Advance the wheel through Tick and return the expired timers
+**
+** Notes:
+**   1. IdBuf must hold NodeCnt entries. Returns the number of expired
+**      timers written to IdBuf, which are no longer pending.
+**   2. The expired timers may be added again while IdBuf is processed.
+**
+*/
+uint16 TIMER_WHEEL_Expire(TIMER_WHEEL_Class_t *TimerWheel, uint32 Tick, uint16 *IdBuf);
+
+
+/******************************************************************************
+** Function: TIMER_WHEEL_NextTick
+**
+** Return the next tick that TIMER_WHEEL_Expire() must be called for
+**
+** Notes:
+**   1. Returns false when no timers are pending.
+**   2. While the next timer is parked in a higher level the returned tick
+**      is the next level 0 wrap, where it is cascaded, so an expire call
+**      may return no timers at most once per TIMER_WHEEL_L0_SLOTS ticks.
+**
+*/
+bool TIMER_WHEEL_NextTick(const TIMER_WHEEL_Class_t *TimerWheel, uint32 *Tick);
+
+
+/******************************************************************************
+** Function: TIMER_WHEEL_Remove
+**
+** Stop timer Id if it is pending
+**
+*/
+void TIMER_WHEEL_Remove(TIMER_WHEEL_Class_t *TimerWheel, uint16 Id);
+
+
+#endif /* _timer_wheel_ */
@@ -0,0 +1,214 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Implement the telemetry buffer object
+**
+**  Notes:
+**    1. See tlm_buf.h for the zero-copy and copy paths.
+**
+**  References:
+**    1. OpenSatKit Object-based Application Developer's Guide.
+**    2. cFS Application Developer's Guide.
+**
+*/
+
+/*
+** Include Files:
+*/
+
+#include <string.h>
+
+#include "tlm_buf.h"
+#include "mono_time.h"
+
+
+/*******************************/
+/** Local Function Prototypes **/
+/*******************************/
+
+static bool IsScratch(const CFE_SB_Buffer_t *SbBuf);
+
+
+/**********************/
+/** Global File Data **/
+/**********************/
+
+static TLM_BUF_Class_t*  TlmBuf = NULL;
+
+
+/******************************************************************************
+** Function: TLM_BUF_Constructor
+**
+*/
+void TLM_BUF_Constructor(TLM_BUF_Class_t *TlmBufPtr, bool ZeroCopy)
+{
+   
+   TlmBuf = TlmBufPtr;
+   
+   memset(TlmBuf, 0, sizeof(TLM_BUF_Class_t));
+   
+   TlmBuf->ZeroCopy    = ZeroCopy;
+   TlmBuf->RateStartNs = MONO_TIME_GetNs();
+   
+} /* End TLM_BUF_Constructor() */
+
+
+/******************************************************************************
+** Function: TLM_BUF_Alloc
+**
+*/
+CFE_SB_Buffer_t* TLM_BUF_Alloc(uint8 Task, CFE_SB_MsgId_t MsgId, size_t Size)
+{
+   
+   CFE_SB_Buffer_t *SbBuf = NULL;
+   
+   if (TlmBuf->ZeroCopy)
+   {
+      SbBuf = CFE_SB_AllocateMessageBuffer(Size);
+      if (SbBuf == NULL)
+      {
+         __atomic_fetch_add(&TlmBuf->AllocFailCnt, 1, __ATOMIC_RELAXED);
+      }
+   }
+   if (SbBuf == NULL)
+   {
+      SbBuf = &TlmBuf->Scratch[Task].SbBuf;
+   }
+   
+   CFE_MSG_Init(&SbBuf->Msg, MsgId, Size);
+   
+   return SbBuf;
+   
+} /* End TLM_BUF_Alloc() */
+
+
+/******************************************************************************
+** Function: TLM_BUF_Release
+**
+*/
+void TLM_BUF_Release(CFE_SB_Buffer_t *SbBuf)
+{
+   
+   if (!IsScratch(SbBuf))
+   {
+      CFE_SB_ReleaseMessageBuffer(SbBuf);
+   }
+   
+} /* End TLM_BUF_Release() */
+
+
+/******************************************************************************
+** Function: TLM_BUF_ResetStatus
+**
+*/
+void TLM_BUF_ResetStatus(void)
+{
+   
+   __atomic_store_n(&TlmBuf->PktCnt, 0, __ATOMIC_RELAXED);
+   __atomic_store_n(&TlmBuf->AllocFailCnt, 0, __ATOMIC_RELAXED);
+   __atomic_store_n(&TlmBuf->SendErrCnt, 0, __ATOMIC_RELAXED);
+   __atomic_store_n(&TlmBuf->ByteCnt, 0, __ATOMIC_RELAXED);
+   __atomic_store_n(&TlmBuf->CopyByteCnt, 0, __ATOMIC_RELAXED);
+   
+   TlmBuf->RateStartNs     = MONO_TIME_GetNs();
+   TlmBuf->RateByteCnt     = 0;
+   TlmBuf->RateCopyByteCnt = 0;
+   TlmBuf->ByteRate        = 0;
+   TlmBuf->CopyByteRate    = 0;
+   
+} /* End TLM_BUF_ResetStatus() */
+
+
+/******************************************************************************
+** Function: TLM_BUF_Send
+**
+** Notes:
+**   1. A zero-copy buffer that the SB rejects is still owned by the caller
+**      so it's released here.
+**
+*/
+void TLM_BUF_Send(CFE_SB_Buffer_t *SbBuf)
+{
+   
+   int32 SysStatus;
+   CFE_MSG_Size_t Size = 0;
+   
+   CFE_MSG_GetSize(&SbBuf->Msg, &Size);
+   CFE_SB_TimeStampMsg(&SbBuf->Msg);
+   
+   if (IsScratch(SbBuf))
+   {
+      SysStatus = CFE_SB_TransmitMsg(&SbBuf->Msg, true);
+      __atomic_fetch_add(&TlmBuf->CopyByteCnt, Size, __ATOMIC_RELAXED);
+   }
+   else
+   {
+      SysStatus = CFE_SB_TransmitBuffer(SbBuf, true);
+      if (SysStatus != CFE_SUCCESS)
+      {
+         CFE_SB_ReleaseMessageBuffer(SbBuf);
+      }
+   }
+   
+   if (SysStatus == CFE_SUCCESS)
+   {
+      __atomic_fetch_add(&TlmBuf->PktCnt, 1, __ATOMIC_RELAXED);
+      __atomic_fetch_add(&TlmBuf->ByteCnt, Size, __ATOMIC_RELAXED);
+   }
+   else
+   {
+      __atomic_fetch_add(&TlmBuf->SendErrCnt, 1, __ATOMIC_RELAXED);
+   }
+   
+} /* End TLM_BUF_Send() */
+
+
+/******************************************************************************
+** Function: TLM_BUF_UpdateRates
+**
+*/
+void TLM_BUF_UpdateRates(void)
+{
+   
+   uint64 NowNs = MONO_TIME_GetNs();
+   uint64 WindowNs = NowNs - TlmBuf->RateStartNs;
+   uint64 ByteCnt     = __atomic_load_n(&TlmBuf->ByteCnt, __ATOMIC_RELAXED);
+   uint64 CopyByteCnt = __atomic_load_n(&TlmBuf->CopyByteCnt, __ATOMIC_RELAXED);
+   
+   if (WindowNs > 0)
+   {
+      TlmBuf->ByteRate     = (uint32)((ByteCnt - TlmBuf->RateByteCnt) * MONO_TIME_NS_PER_SEC / WindowNs);
+      TlmBuf->CopyByteRate = (uint32)((CopyByteCnt - TlmBuf->RateCopyByteCnt) * MONO_TIME_NS_PER_SEC / WindowNs);
+   }
+   
+   TlmBuf->RateStartNs     = NowNs;
+   TlmBuf->RateByteCnt     = ByteCnt;
+   TlmBuf->RateCopyByteCnt = CopyByteCnt;
+   
+} /* End TLM_BUF_UpdateRates() */
+
+
+/******************************************************************************
+** Function: IsScratch
+**
+*/
+static bool IsScratch(const CFE_SB_Buffer_t *SbBuf)
+{
+   
+   const TLM_BUF_Pkt_t *Pkt = (const TLM_BUF_Pkt_t*)SbBuf;
+   
+   return (Pkt >= &TlmBuf->Scratch[0] && Pkt < &TlmBuf->Scratch[TLM_BUF_TASK_CNT]);
+   
+} /* End IsScratch() */
@@ -0,0 +1,189 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Define the telemetry buffer object
+**
+**  Notes:
+**    1. Telemetry packets are filled in place in a buffer allocated from
+**       the software bus pool and handed to the SB without a copy.
+**    2. With zero-copy disabled, or when the SB pool is exhausted, packets
+**       are filled in a scratch packet and copied by CFE_SB_TransmitMsg()
+**       as before. The copied bytes are counted so the two paths can be
+**       compared in housekeeping telemetry.
+**    3. Each task that sends telemetry has its own scratch packet and may
+**       have one packet outstanding between TLM_BUF_Alloc() and
+**       TLM_BUF_Send() or TLM_BUF_Release(). Counters are updated with
+**       atomics so any of the tasks may send.
+**
+**  References:
+**    1. OpenSatKit Object-based Application Developer's Guide.
+**    2. cFS Application Developer's Guide.
+**
+*/
+
+#ifndef _tlm_buf_
+#define _tlm_buf_
+
+/*
+** Includes
+*/
+
+#include "app_cfg.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+/*
+** Sending tasks
+*/
+
+#define TLM_BUF_MAIN_TASK   0
+#define TLM_BUF_CHILD_TASK  1   /* Controller child task */
+#define TLM_BUF_TASK_CNT    2
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+
+/******************************************************************************
+** Scratch packet
+** - Every packet type sent through TLM_BUF must be a member so the scratch
+**   packet can hold it
+*/
+
+typedef union
+{
+
+   CFE_SB_Buffer_t               SbBuf;
+   GPIO_DEMO_HkTlm_t             HkTlm;
+   GPIO_DEMO_EdgeHistTlm_t       EdgeHistTlm;
+   GPIO_DEMO_PwmTlm_t            PwmTlm;
+   GPIO_DEMO_InputEdgeTlm_t      InputEdgeTlm;
+   GPIO_DEMO_SeqTlm_t            SeqTlm;
+   GPIO_DEMO_CtrlStatsTlm_t      CtrlStatsTlm;
+
+} TLM_BUF_Pkt_t;
+
+
+/******************************************************************************
+** Class
+*/
+
+typedef struct
+{
+
+   /*
+   ** Configuration
+   */
+
+   bool    ZeroCopy;
+
+   /*
+   ** Class State Data
+   */
+
+   uint32  PktCnt;
+   uint16  AllocFailCnt;   /* Zero-copy packets that fell back to the scratch packet */
+   uint16  SendErrCnt;
+   uint64  ByteCnt;        /* All telemetry bytes sent */
+   uint64  CopyByteCnt;    /* Bytes copied into the SB by CFE_SB_TransmitMsg() */
+
+   uint64  RateStartNs;
+   uint64  RateByteCnt;
+   uint64  RateCopyByteCnt;
+   uint32  ByteRate;       /* Bytes per second over the last rate window */
+   uint32  CopyByteRate;
+
+   TLM_BUF_Pkt_t Scratch[TLM_BUF_TASK_CNT];
+
+} TLM_BUF_Class_t;
+
+
+/************************/
+/** Exported Functions **/
+/************************/
+
+
+/******************************************************************************
+** Function: TLM_BUF_Constructor
+**
+** Initialize the telemetry buffer object to a known state
+**
+** Notes:
+**   1. This must be called prior to any other function.
+**
+*/
+void TLM_BUF_Constructor(TLM_BUF_Class_t *TlmBufPtr, bool ZeroCopy);
+
+
+/******************************************************************************
+** Function: TLM_BUF_Alloc
+**
+** Return a packet to be filled and passed to TLM_BUF_Send()
+**
+** Notes:
+**   1. The packet is zeroed and its header initialized with MsgId and Size.
+**   2. Never returns NULL, Task's scratch packet is used when the SB can't
+**      allocate a buffer.
+**
+*/
+CFE_SB_Buffer_t* TLM_BUF_Alloc(uint8 Task, CFE_SB_MsgId_t MsgId, size_t Size);
+
+
+/******************************************************************************
+** Function: TLM_BUF_Release
+**
+** Discard a packet returned by TLM_BUF_Alloc() without sending it
+**
+*/
+void TLM_BUF_Release(CFE_SB_Buffer_t *SbBuf);
+
+
+/******************************************************************************
+** Function: TLM_BUF_ResetStatus
+**
+** Reset counters and status flags to a known reset state.
+**
+*/
+void TLM_BUF_ResetStatus(void);
+
+
+/******************************************************************************
+** Function: TLM_BUF_Send
+**
+** Timestamp and send a packet returned by TLM_BUF_Alloc()
+**
+** Notes:
+**   1. The packet must not be accessed after this call, a zero-copy
+**      buffer is owned by the SB once it is sent.
+**
+*/
+void TLM_BUF_Send(CFE_SB_Buffer_t *SbBuf);
+
+
+/******************************************************************************
+** Function: TLM_BUF_UpdateRates
+**
+** Update ByteRate and CopyByteRate from the bytes sent since the last call
+**
+*/
+void TLM_BUF_UpdateRates(void);
+
+
+#endif /* _tlm_buf_ */
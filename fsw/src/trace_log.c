@@ -0,0 +1,349 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Implement the Trace Log class
+**
+**  Notes:
+**    1. A ring's owner stores an event's fields and then Head with release.
+**       The dump loads Head with acquire, copies the whole ring and loads
+**       Head again after an acquire fence. If N events were recorded
+**       during the copy, the owner may have been writing the oldest N+1
+**       copied slots so they're discarded.
+**    2. The dump skips end events whose begin was overwritten so every
+**       span in the file is balanced except the ones still open.
+**
+**  References:
+**    1. OpenSatKit Object-based Application Developer's Guide.
+**    2. cFS Application Developer's Guide.
+**
+*/
+
+/*
+** Include Files:
+*/
+
+#include <stdio.h>
+#include <string.h>
+
+#include "mono_time.h"
+#include "trace_log.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define TRACE_LOG_PID  1   /* One process holds both task threads */
+
+
+/**********************/
+/** Global File Data **/
+/**********************/
+
+static TRACE_LOG_Class_t*  TraceLog = NULL;
+
+static const char* PointStr[TRACE_LOG_POINTS] =
+{
+   "SbReceive",
+   "Dispatch",
+   "HkBuild",
+   "EdgeWrite",
+   "Sleep",
+   "Spin"
+};
+
+
+/*******************************/
+/** Local Function Prototypes **/
+/*******************************/
+
+static bool   AppendChunk(osal_id_t File, bool Flush);
+static uint32 CopyRing(const TRACE_LOG_Ring_t* Ring);
+static void   Record(uint8 Task, uint8 Point, bool Begin, uint32 Arg, uint64 TimeNs);
+static bool   WriteRing(osal_id_t File, const TRACE_LOG_Ring_t* Ring, uint32* EventCnt);
+
+
+/******************************************************************************
+** Function: TRACE_LOG_Constructor
+**
+*/
+void TRACE_LOG_Constructor(TRACE_LOG_Class_t *TraceLogPtr, INITBL_Class_t* IniTbl)
+{
+
+   TraceLog = TraceLogPtr;
+
+   memset(TraceLog, 0, sizeof(TRACE_LOG_Class_t));
+
+   TraceLog->Enabled = (INITBL_GetIntConfig(IniTbl, CFG_TRACE_ENABLE) != 0);
+   TraceLog->AppName = INITBL_GetStrConfig(IniTbl, CFG_APP_CFE_NAME);
+
+   TraceLog->Ring[TRACE_LOG_MAIN].Tid   = INITBL_GetIntConfig(IniTbl, CFG_APP_PERF_ID);
+   TraceLog->Ring[TRACE_LOG_MAIN].Name  = TraceLog->AppName;
+   TraceLog->Ring[TRACE_LOG_CHILD].Tid  = INITBL_GetIntConfig(IniTbl, CFG_CHILD_PERF_ID);
+   TraceLog->Ring[TRACE_LOG_CHILD].Name = INITBL_GetStrConfig(IniTbl, CFG_CHILD_NAME);
+
+} /* End TRACE_LOG_Constructor() */
+
+
+/******************************************************************************
+** Function: TRACE_LOG_Begin
+**
+*/
+void TRACE_LOG_Begin(uint8 Task, uint8 Point, uint32 Arg)
+{
+
+   Record(Task, Point, true, Arg, MONO_TIME_GetNs());
+
+} /* End TRACE_LOG_Begin() */
+
+
+/******************************************************************************
+** Function: TRACE_LOG_DumpCmd
+**
+*/
+bool TRACE_LOG_DumpCmd(void* DataObjPtr, const CFE_MSG_Message_t *MsgPtr)
+{
+
+   const GPIO_DEMO_DumpTrace_Payload_t *Cmd = CMDMGR_PAYLOAD_PTR(MsgPtr, GPIO_DEMO_DumpTrace_t);
+   char      Filename[OS_MAX_PATH_LEN];
+   osal_id_t File;
+   int32     SysStatus;
+   uint32    EventCnt[TRACE_LOG_TASKS] = { 0 };
+   bool      RetStatus;
+   uint8     i;
+
+   strncpy(Filename, Cmd->Filename, OS_MAX_PATH_LEN-1);
+   Filename[OS_MAX_PATH_LEN-1] = '\0';
+
+   SysStatus = OS_OpenCreate(&File, Filename, OS_FILE_FLAG_CREATE | OS_FILE_FLAG_TRUNCATE, OS_READ_WRITE);
+   if (SysStatus != OS_SUCCESS)
+   {
+      CFE_EVS_SendEvent (TRACE_LOG_DUMP_EID, CFE_EVS_EventType_ERROR,
+                         "Error creating trace dump file '%s', status=0x%08X", Filename, SysStatus);
+      return false;
+   }
+
+   TraceLog->ChunkLen = snprintf(TraceLog->Chunk, TRACE_LOG_MAX_LINE,
+                                 "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n"
+                                 "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%u,\"tid\":0,\"args\":{\"name\":\"%s\"}}",
+                                 TRACE_LOG_PID, TraceLog->AppName);
+
+   RetStatus = true;
+   for (i=0; i < TRACE_LOG_TASKS && RetStatus; i++)
+   {
+      RetStatus = WriteRing(File, &TraceLog->Ring[i], &EventCnt[i]);
+   }
+
+   if (RetStatus)
+   {
+      TraceLog->ChunkLen += snprintf(&TraceLog->Chunk[TraceLog->ChunkLen], TRACE_LOG_MAX_LINE, "\n]}\n");
+      RetStatus = AppendChunk(File, true);
+   }
+   OS_close(File);
+
+   if (RetStatus)
+   {
+      TraceLog->DumpCnt++;
+      CFE_EVS_SendEvent (TRACE_LOG_DUMP_EID, CFE_EVS_EventType_INFORMATION,
+                         "Trace dumped to %s, %u main and %u child task events",
+                         Filename, EventCnt[TRACE_LOG_MAIN], EventCnt[TRACE_LOG_CHILD]);
+   }
+   else
+   {
+      CFE_EVS_SendEvent (TRACE_LOG_DUMP_EID, CFE_EVS_EventType_ERROR,
+                         "Trace dump to %s failed writing the file", Filename);
+   }
+
+   return RetStatus;
+
+} /* End TRACE_LOG_DumpCmd() */
+
+
+/******************************************************************************
+** Function: TRACE_LOG_End
+**
+*/
+void TRACE_LOG_End(uint8 Task, uint8 Point)
+{
+
+   Record(Task, Point, false, 0, MONO_TIME_GetNs());
+
+} /* End TRACE_LOG_End() */
+
+
+/******************************************************************************
+** Function: TRACE_LOG_Span
+**
+*/
+void TRACE_LOG_Span(uint8 Task, uint8 Point, uint32 Arg, uint64 BeginNs, uint64 EndNs)
+{
+
+   Record(Task, Point, true,  Arg, BeginNs);
+   Record(Task, Point, false, 0,   EndNs);
+
+} /* End TRACE_LOG_Span() */
+
+
+/******************************************************************************
+** Function: AppendChunk
+**
+** Write the formatted chunk once it holds TRACE_LOG_WRITE_CHUNK bytes, or
+** whatever it holds when Flush is true
+**
+*/
+static bool AppendChunk(osal_id_t File, bool Flush)
+{
+
+   bool RetStatus = true;
+
+   if (TraceLog->ChunkLen >= TRACE_LOG_WRITE_CHUNK || (Flush && TraceLog->ChunkLen > 0))
+   {
+      RetStatus = (OS_write(File, TraceLog->Chunk, TraceLog->ChunkLen) == (int32)TraceLog->ChunkLen);
+      TraceLog->ChunkLen = 0;
+   }
+
+   return RetStatus;
+
+} /* End AppendChunk() */
+
+
+/******************************************************************************
+** Function: CopyRing
+**
+** Copy the ring into Snapshot, oldest first, and return the Snapshot index
+** of the oldest valid event
+**
+** Notes:
+**   1. See file prologue for the slots that are discarded.
+**
+*/
+static uint32 CopyRing(const TRACE_LOG_Ring_t* Ring)
+{
+
+   uint32 Head = __atomic_load_n(&Ring->Head, __ATOMIC_ACQUIRE);
+   uint32 Recorded;
+   uint32 First;
+   uint32 i;
+
+   for (i=0; i < TRACE_LOG_RING_LEN; i++)
+   {
+      TraceLog->Snapshot[i] = Ring->Event[(Head + i) & (TRACE_LOG_RING_LEN-1)];
+   }
+   __atomic_thread_fence(__ATOMIC_ACQUIRE);
+   Recorded = __atomic_load_n(&Ring->Head, __ATOMIC_RELAXED) - Head;
+
+   First = (Recorded >= TRACE_LOG_RING_LEN) ? TRACE_LOG_RING_LEN : Recorded + 1;
+   while (First < TRACE_LOG_RING_LEN && TraceLog->Snapshot[First].TimeNs == 0)
+   {
+      First++;   /* Never written */
+   }
+
+   return First;
+
+} /* End CopyRing() */
+
+
+/******************************************************************************
+** Function: Record
+**
+*/
+static void Record(uint8 Task, uint8 Point, bool Begin, uint32 Arg, uint64 TimeNs)
+{
+
+   TRACE_LOG_Ring_t*  Ring;
+   TRACE_LOG_Event_t* Event;
+   uint32 Head;
+
+   if (TraceLog == NULL || !TraceLog->Enabled)
+   {
+      return;
+   }
+
+   Ring  = &TraceLog->Ring[Task];
+   Head  = __atomic_load_n(&Ring->Head, __ATOMIC_RELAXED);
+   Event = &Ring->Event[Head & (TRACE_LOG_RING_LEN-1)];
+
+   Event->TimeNs = TimeNs;
+   Event->Arg    = Arg;
+   Event->Point  = Point;
+   Event->Begin  = Begin;
+
+   __atomic_store_n(&Ring->Head, Head + 1, __ATOMIC_RELEASE);
+
+} /* End Record() */
+
+
+/******************************************************************************
+** Function: WriteRing
+**
+** Write a task's thread name and events
+**
+*/
+static bool WriteRing(osal_id_t File, const TRACE_LOG_Ring_t* Ring, uint32* EventCnt)
+{
+
+   const TRACE_LOG_Event_t* Event;
+   uint32 First;
+   uint32 Depth[TRACE_LOG_POINTS] = { 0 };
+   uint32 i;
+
+   TraceLog->ChunkLen += snprintf(&TraceLog->Chunk[TraceLog->ChunkLen], TRACE_LOG_MAX_LINE,
+                                  ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%u,\"tid\":%u,\"args\":{\"name\":\"%s\"}}",
+                                  TRACE_LOG_PID, (unsigned int)Ring->Tid, Ring->Name);
+
+   First = CopyRing(Ring);
+
+   for (i=First; i < TRACE_LOG_RING_LEN; i++)
+   {
+
+      Event = &TraceLog->Snapshot[i];
+      if (Event->Point >= TRACE_LOG_POINTS)
+      {
+         continue;
+      }
+
+      if (Event->Begin)
+      {
+         Depth[Event->Point]++;
+         TraceLog->ChunkLen += snprintf(&TraceLog->Chunk[TraceLog->ChunkLen], TRACE_LOG_MAX_LINE,
+                                        ",\n{\"name\":\"%s\",\"ph\":\"B\",\"pid\":%u,\"tid\":%u,\"ts\":%llu.%03u,\"args\":{\"arg\":%u}}",
+                                        PointStr[Event->Point], TRACE_LOG_PID, (unsigned int)Ring->Tid,
+                                        (unsigned long long)(Event->TimeNs / 1000), (unsigned int)(Event->TimeNs % 1000),
+                                        (unsigned int)Event->Arg);
+      }
+      else if (Depth[Event->Point] > 0)
+      {
+         Depth[Event->Point]--;
+         TraceLog->ChunkLen += snprintf(&TraceLog->Chunk[TraceLog->ChunkLen], TRACE_LOG_MAX_LINE,
+                                        ",\n{\"name\":\"%s\",\"ph\":\"E\",\"pid\":%u,\"tid\":%u,\"ts\":%llu.%03u}",
+                                        PointStr[Event->Point], TRACE_LOG_PID, (unsigned int)Ring->Tid,
+                                        (unsigned long long)(Event->TimeNs / 1000), (unsigned int)(Event->TimeNs % 1000));
+      }
+      else
+      {
+         continue;   /* Begin was overwritten */
+      }
+      (*EventCnt)++;
+
+      if (!AppendChunk(File, false))
+      {
+         return false;
+      }
+
+   } /* End event loop */
+
+   return true;
+
+} /* End WriteRing() */
@@ -0,0 +1,204 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Define the Trace Log class
+**
+**  Notes:
+**    1. Records timestamped begin/end events at trace points on the main
+**       task and the controller child task, finer grained than the perf
+**       log markers that bracket the main loop.
+**    2. Each task has its own ring of the last TRACE_LOG_RING_LEN events.
+**       Only the owning task writes a ring: it fills the slot and then
+**       publishes it by incrementing Head, so recording takes no lock and
+**       never waits on the other task.
+**    3. The dump command copies each ring and discards the oldest slots
+**       that the owner may have overwritten during the copy, then writes
+**       Chrome trace event JSON ("JSON Object Format") that trace viewers
+**       such as Perfetto or chrome://tracing open directly. Each task is
+**       a thread whose tid is its perf ID, timestamps are CLOCK_MONOTONIC
+**       microseconds.
+**
+**  References:
+**    1. OpenSatKit Object-based Application Developer's Guide.
+**    2. cFS Application Developer's Guide.
+**
+*/
+
+#ifndef _trace_log_
+#define _trace_log_
+
+/*
+** Includes
+*/
+
+#include "app_cfg.h"
+#include "initbl.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define TRACE_LOG_RING_LEN     4096   /* Events per task, must be a power of 2 */
+#define TRACE_LOG_WRITE_CHUNK  4096   /* Bytes formatted before each file write */
+#define TRACE_LOG_MAX_LINE     256    /* Longest formatted event */
+
+/*
+** Tasks
+*/
+
+#define TRACE_LOG_MAIN   0
+#define TRACE_LOG_CHILD  1
+#define TRACE_LOG_TASKS  2
+
+/*
+** Trace points
+*/
+
+#define TRACE_LOG_SB_RECEIVE  0   /* Main: CFE_SB_ReceiveBuffer(), Arg = timeout */
+#define TRACE_LOG_DISPATCH    1   /* Main: command function, Arg = function code */
+#define TRACE_LOG_HK_BUILD    2   /* Main: housekeeping request telemetry */
+#define TRACE_LOG_EDGE_WRITE  3   /* Child: bank write, Arg = pins changed */
+#define TRACE_LOG_SLEEP       4   /* Child: wait for a deadline or wakeup */
+#define TRACE_LOG_SPIN        5   /* Child: PWM edge busy-wait */
+#define TRACE_LOG_POINTS      6
+
+/*
+** Event Message IDs
+*/
+
+#define TRACE_LOG_DUMP_EID  (TRACE_LOG_BASE_EID + 0)
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+typedef struct
+{
+
+   uint64  TimeNs;   /* CLOCK_MONOTONIC, 0 for a slot never written */
+   uint32  Arg;
+   uint8   Point;
+   bool    Begin;    /* false ends the point's span */
+   uint16  Spare;
+
+} TRACE_LOG_Event_t;
+
+typedef struct
+{
+
+   uint32       Head;   /* Events recorded, only written by the owning task */
+   uint32       Tid;    /* Task's perf ID */
+   const char*  Name;
+
+   TRACE_LOG_Event_t  Event[TRACE_LOG_RING_LEN];
+
+} TRACE_LOG_Ring_t;
+
+
+/******************************************************************************
+** Class
+*/
+
+typedef struct
+{
+
+   bool    Enabled;
+   uint16  DumpCnt;
+   const char*  AppName;
+
+   TRACE_LOG_Ring_t  Ring[TRACE_LOG_TASKS];
+
+   /*
+   ** Dump buffers, only used by the dump command
+   */
+
+   TRACE_LOG_Event_t  Snapshot[TRACE_LOG_RING_LEN];
+   char    Chunk[TRACE_LOG_WRITE_CHUNK + TRACE_LOG_MAX_LINE];
+   uint32  ChunkLen;
+
+} TRACE_LOG_Class_t;
+
+
+/************************/
+/** Exported Functions **/
+/************************/
+
+
+/******************************************************************************
+** Function: TRACE_LOG_Constructor
+**
+** Initialize the Trace Log object to a known state
+**
+** Notes:
+**   1. This must be called prior to any other function and before the
+**      child task starts.
+**
+*/
+void TRACE_LOG_Constructor(TRACE_LOG_Class_t *TraceLogPtr, INITBL_Class_t* IniTbl);
+
+
+/******************************************************************************
+** Function: TRACE_LOG_Begin
+**
+** Record the start of a trace point's span on Task's ring
+**
+** Notes:
+**   1. Must only be called from Task.
+**
+*/
+void TRACE_LOG_Begin(uint8 Task, uint8 Point, uint32 Arg);
+
+
+/******************************************************************************
+** Function: TRACE_LOG_DumpCmd
+**
+** Write both task rings to a Chrome trace event JSON file
+**
+** Notes:
+**   1. Runs on the main task, recording continues during the dump.
+**
+*/
+bool TRACE_LOG_DumpCmd(void* DataObjPtr, const CFE_MSG_Message_t *MsgPtr);
+
+
+/******************************************************************************
+** Function: TRACE_LOG_End
+**
+** Record the end of a trace point's span on Task's ring
+**
+** Notes:
+**   1. Must only be called from Task.
+**
+*/
+void TRACE_LOG_End(uint8 Task, uint8 Point);
+
+
+/******************************************************************************
+** Function: TRACE_LOG_Span
+**
+** Record a completed span of a trace point with times the caller measured
+**
+** Notes:
+**   1. Must only be called from Task.
+**   2. Lets a timing critical path record its span after the critical
+**      section, reusing its own clock reads.
+**
+*/
+void TRACE_LOG_Span(uint8 Task, uint8 Point, uint32 Arg, uint64 BeginNs, uint64 EndNs);
+
+
+#endif /* _trace_log_ */
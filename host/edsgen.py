@@ -0,0 +1,62 @@
+#
+#  Copyright 2022 bitValence, Inc.
+#  All Rights Reserved.
+#
+#  Generate the EDS C headers the app includes for the host build
+#
+#  Usage: edsgen.py <eds/gpio_demo.xml> <output directory>
+#
+#  Writes <package>_eds_typedefs.h and <package>_eds_cc.h. Only the subset
+#  of SEDS used by eds/gpio_demo.xml is supported, the osk_c_fw base
+#  command code is fixed at OSK_C_FW_APP_BASE_CC from host/inc/osk_c_fw.h.
+#
+import sys, re, xml.etree.ElementTree as ET
+ns={'s':'http://www.ccsds.org/schema/sois/seds'}
+xml, out = sys.argv[1], sys.argv[2]
+root=ET.parse(xml).getroot()
+pkg=root.find('s:Package',ns); P=pkg.get('name')
+base={'uint8':'uint8','uint16':'uint16','uint32':'uint32','uint64':'uint64','int8':'int8','int16':'int16','int32':'int32','int64':'int64','float':'float','double':'double'}
+def ctype(t):
+    if t.startswith('BASE_TYPES/'): return base[t.split('/')[1]]
+    if t.startswith('CFE_HDR/CommandHeader'): return 'CFE_MSG_CommandHeader_t'
+    if t.startswith('CFE_HDR/TelemetryHeader'): return 'CFE_MSG_TelemetryHeader_t'
+    if t.startswith('OSK_C_FW/'): return 'OSK_C_FW_%s_t'%t.split('/')[1]
+    if '/' in t: raise Exception(t)
+    return '%s_%s_t'%(P,t)
+h=['#ifndef _%s_eds_typedefs_\n#define _%s_eds_typedefs_\n#include "cfe.h"\n'%(P,P)]
+cc=['#ifndef _%s_eds_cc_\n#define _%s_eds_cc_\n'%(P,P)]
+def snake(n): return re.sub(r'(?<=[a-z0-9])([A-Z])',r'_\1',n).upper()
+dts=pkg.find('s:DataTypeSet',ns)
+for el in dts:
+    tag=el.tag.split('}')[1]; name=el.get('name')
+    if tag=='EnumeratedDataType':
+        h.append('typedef enum {')
+        for e in el.find('s:EnumerationList',ns):
+            h.append('   %s_%s_%s = %s,'%(P,name,e.get('label'),e.get('value')))
+        h.append('} %s_%s_Enum_t;\ntypedef uint8 %s_%s_t;\n'%(P,name,P,name))
+    elif tag=='ArrayDataType':
+        et=ctype(el.get('dataTypeRef')); dim=el.find('s:DimensionList/s:Dimension',ns).get('size')
+        h.append('typedef %s %s_%s_t[%s];\n'%(et,P,name,dim))
+    elif tag=='StringDataType':
+        h.append('typedef char %s_%s_t[%s];\n'%(P,name,el.get('length')))
+    elif tag=='ContainerDataType':
+        fields=[]
+        bt=el.get('baseType')
+        if bt:
+            if bt=='CommandBase' or bt=='CFE_HDR/CommandHeader': fields.append('   CFE_MSG_CommandHeader_t CommandHeader;')
+            elif bt=='CFE_HDR/TelemetryHeader': fields.append('   CFE_MSG_TelemetryHeader_t TelemetryHeader;')
+        cs=el.find('s:ConstraintSet',ns)
+        if cs is not None:
+            for vc in cs:
+                v=vc.get('value'); v=v.replace('${OSK_C_FW/APP_BASE_CC}','10').replace('${OSK_C_FW/NOOP_CC}','0').replace('${OSK_C_FW/RESET_CC}','1')
+                cc.append('#define %s_%s_CC (%s)'%(P,snake(name),v))
+        el_ = el.find('s:EntryList',ns)
+        if el_ is not None:
+            for e in el_:
+                if e.get('type')=='BASE_TYPES/PathName': fields.append('   char %s[OS_MAX_PATH_LEN];'%e.get('name')); continue
+                fields.append('   %s %s;'%(ctype(e.get('type')),e.get('name')))
+        if not fields: fields.append('   uint8 Dummy;')
+        h.append('typedef struct {\n%s\n} %s_%s_t;\n'%('\n'.join(fields),P,name))
+h.append('#endif'); cc.append('#endif')
+open(out+'/%s_eds_typedefs.h'%P.lower(),'w').write('\n'.join(h)+'\n')
+open(out+'/%s_eds_cc.h'%P.lower(),'w').write('\n'.join(cc)+'\n')
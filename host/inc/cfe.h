@@ -0,0 +1,250 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Define the subset of the cFE and OSAL APIs used by the app for the
+**    host build
+**
+**  Notes:
+**    1. Declarations follow cFE 7.0 and OSAL 6.0. Implemented by
+**       host/src/cfe_stub.c, see that file for the simplifications.
+**    2. Message IDs are the topic IDs and a message header is a CCSDS
+**       primary header with the stream ID set to the message ID.
+**
+*/
+
+#ifndef _cfe_
+#define _cfe_
+
+/*
+** Includes
+*/
+
+#include "common_types.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define CFE_SUCCESS          ((int32)0)
+#define CFE_SB_BAD_ARGUMENT  ((int32)0xca000002)
+#define CFE_SB_PIPE_CR_ERR   ((int32)0xca000004)
+#define CFE_SB_PIPE_RD_ERR   ((int32)0xca000005)
+#define CFE_SB_BUF_ALOC_ERR  ((int32)0xca000007)
+#define CFE_SB_TIME_OUT      ((int32)0xca00000e)
+#define CFE_SB_NO_MESSAGE    ((int32)0xca00000f)
+
+#define CFE_SB_PEND_FOREVER  (-1)
+#define CFE_SB_POLL          0
+
+#define CFE_SB_INVALID_MSG_ID  ((CFE_SB_MsgId_t)0)
+
+#define CFE_EVS_NO_FILTER  0
+
+#define CFE_MISSION_SB_MAX_SB_MSG_SIZE   32768
+#define CFE_MISSION_EVS_MAX_MESSAGE_LENGTH 122
+
+#define CFE_ES_PerfLogEntry(Id)  CFE_ES_PerfLogAdd(Id, 0)
+#define CFE_ES_PerfLogExit(Id)   CFE_ES_PerfLogAdd(Id, 1)
+
+#define OS_SUCCESS             0
+#define OS_ERROR               (-1)
+#define OS_MAX_PATH_LEN        64
+#define OS_OBJECT_ID_UNDEFINED ((osal_id_t)0)
+#define OS_ObjectIdDefined(Id) ((Id) != OS_OBJECT_ID_UNDEFINED)
+
+#define OS_FILE_FLAG_NONE      0x00
+#define OS_FILE_FLAG_CREATE    0x01
+#define OS_FILE_FLAG_TRUNCATE  0x02
+
+#define OS_READ_ONLY   0
+#define OS_WRITE_ONLY  1
+#define OS_READ_WRITE  2
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+typedef int32   CFE_Status_t;
+typedef uint32  CFE_SB_MsgId_t;
+typedef uint32  CFE_SB_PipeId_t;
+typedef size_t  CFE_MSG_Size_t;
+typedef uint16  CFE_MSG_SequenceCount_t;
+typedef uint8   CFE_MSG_FcnCode_t;
+
+typedef void (*CFE_ES_ChildTaskMainFuncPtr_t)(void);
+
+enum
+{
+   CFE_EVS_EventType_DEBUG = 1,
+   CFE_EVS_EventType_INFORMATION,
+   CFE_EVS_EventType_ERROR,
+   CFE_EVS_EventType_CRITICAL
+};
+
+enum
+{
+   CFE_ES_RunStatus_UNDEFINED = 0,
+   CFE_ES_RunStatus_APP_RUN,
+   CFE_ES_RunStatus_APP_EXIT,
+   CFE_ES_RunStatus_APP_ERROR
+};
+
+typedef enum
+{
+   CFE_TIME_A_LT_B = -1,
+   CFE_TIME_EQUAL  = 0,
+   CFE_TIME_A_GT_B = 1
+} CFE_TIME_Compare_t;
+
+typedef struct
+{
+
+   uint32  Seconds;
+   uint32  Subseconds;
+
+} CFE_TIME_SysTime_t;
+
+
+/*
+** Message headers
+*/
+
+typedef struct
+{
+
+   uint8  Byte[6];   /* CCSDS primary header, big endian */
+
+} CFE_MSG_Message_t;
+
+typedef struct
+{
+
+   CFE_MSG_Message_t  Msg;
+   uint8  FunctionCode;
+   uint8  Checksum;
+
+} CFE_MSG_CommandHeader_t;
+
+typedef struct
+{
+
+   CFE_MSG_Message_t  Msg;
+   uint8  Time[6];
+   uint8  Spare[4];
+
+} CFE_MSG_TelemetryHeader_t;
+
+typedef union
+{
+
+   CFE_MSG_Message_t  Msg;
+   long long int      LongInt;   /* Alignment */
+   long double        LongDouble;
+
+} CFE_SB_Buffer_t;
+
+
+/*
+** OSK_C_FW EDS payloads used by the table commands
+*/
+
+typedef struct
+{
+
+   uint8  Id;
+   uint8  Type;
+   char   Filename[OS_MAX_PATH_LEN];
+
+} OSK_C_FW_LoadTbl_Payload_t;
+
+typedef struct
+{
+
+   uint8  Id;
+   uint8  Spare[3];
+   char   Filename[OS_MAX_PATH_LEN];
+
+} OSK_C_FW_DumpTbl_Payload_t;
+
+
+/************************/
+/** Exported Functions **/
+/************************/
+
+/*
+** Executive Services
+*/
+
+void CFE_ES_ExitApp(uint32 ExitStatus);
+void CFE_ES_PerfLogAdd(uint32 Marker, uint32 EntryExit);
+bool CFE_ES_RunLoop(uint32 *RunStatus);
+CFE_Status_t CFE_ES_WriteToSysLog(const char *SpecStringPtr, ...) __attribute__((format(printf,1,2)));
+
+/*
+** Event Services
+*/
+
+CFE_Status_t CFE_EVS_Register(const void *Filters, uint16 NumEventFilters, uint16 FilterScheme);
+CFE_Status_t CFE_EVS_SendEvent(uint16 EventID, uint16 EventType, const char *Spec, ...) __attribute__((format(printf,3,4)));
+
+/*
+** Messages
+*/
+
+CFE_Status_t CFE_MSG_GetFcnCode(const CFE_MSG_Message_t *MsgPtr, CFE_MSG_FcnCode_t *FcnCode);
+CFE_Status_t CFE_MSG_GetMsgId(const CFE_MSG_Message_t *MsgPtr, CFE_SB_MsgId_t *MsgId);
+CFE_Status_t CFE_MSG_GetSequenceCount(const CFE_MSG_Message_t *MsgPtr, CFE_MSG_SequenceCount_t *SeqCnt);
+CFE_Status_t CFE_MSG_GetSize(const CFE_MSG_Message_t *MsgPtr, CFE_MSG_Size_t *Size);
+CFE_Status_t CFE_MSG_Init(CFE_MSG_Message_t *MsgPtr, CFE_SB_MsgId_t MsgId, CFE_MSG_Size_t Size);
+CFE_Status_t CFE_MSG_SetFcnCode(CFE_MSG_Message_t *MsgPtr, CFE_MSG_FcnCode_t FcnCode);
+
+/*
+** Software Bus
+*/
+
+CFE_SB_Buffer_t* CFE_SB_AllocateMessageBuffer(size_t MsgSize);
+CFE_Status_t CFE_SB_CreatePipe(CFE_SB_PipeId_t *PipeIdPtr, uint16 Depth, const char *PipeName);
+bool   CFE_SB_MsgId_Equal(CFE_SB_MsgId_t MsgId1, CFE_SB_MsgId_t MsgId2);
+uint32 CFE_SB_MsgIdToValue(CFE_SB_MsgId_t MsgId);
+CFE_Status_t CFE_SB_ReceiveBuffer(CFE_SB_Buffer_t **BufPtr, CFE_SB_PipeId_t PipeId, int32 TimeOut);
+CFE_Status_t CFE_SB_ReleaseMessageBuffer(CFE_SB_Buffer_t *BufPtr);
+CFE_Status_t CFE_SB_Subscribe(CFE_SB_MsgId_t MsgId, CFE_SB_PipeId_t PipeId);
+void CFE_SB_TimeStampMsg(CFE_MSG_Message_t *MsgPtr);
+CFE_Status_t CFE_SB_TransmitBuffer(CFE_SB_Buffer_t *BufPtr, bool IncrementSequenceCount);
+CFE_Status_t CFE_SB_TransmitMsg(const CFE_MSG_Message_t *MsgPtr, bool IncrementSequenceCount);
+CFE_SB_MsgId_t CFE_SB_ValueToMsgId(uint32 MsgIdValue);
+
+/*
+** Time Services
+*/
+
+CFE_TIME_Compare_t CFE_TIME_Compare(CFE_TIME_SysTime_t TimeA, CFE_TIME_SysTime_t TimeB);
+CFE_TIME_SysTime_t CFE_TIME_GetTime(void);
+uint32 CFE_TIME_Sub2MicroSecs(uint32 SubSeconds);
+CFE_TIME_SysTime_t CFE_TIME_Subtract(CFE_TIME_SysTime_t Time1, CFE_TIME_SysTime_t Time2);
+
+/*
+** OSAL files
+*/
+
+int32 OS_close(osal_id_t FileDes);
+int32 OS_OpenCreate(osal_id_t *FileDes, const char *Path, int32 Flags, int32 AccessMode);
+int32 OS_read(osal_id_t FileDes, void *Buffer, size_t NumBytes);
+int32 OS_write(osal_id_t FileDes, const void *Buffer, size_t NumBytes);
+
+
+#endif /* _cfe_ */
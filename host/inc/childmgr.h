@@ -0,0 +1,78 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Define the OSK child task manager for the host build
+**
+**  Notes:
+**    1. Each child task is a pthread that calls the app's callback until
+**       it returns false, the ChildTaskMainFunc argument is ignored.
+**    2. Child commands aren't supported, the app doesn't use them.
+**
+*/
+
+#ifndef _childmgr_
+#define _childmgr_
+
+/*
+** Includes
+*/
+
+#include <pthread.h>
+
+#include "osk_c_fw.h"
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+struct CHILDMGR_Class;
+
+typedef bool (*CHILDMGR_TaskCallback_t)(struct CHILDMGR_Class* ChildMgr);
+
+typedef struct
+{
+
+   const char*  TaskName;
+   uint32       StackSize;
+   uint32       Priority;
+   uint32       PerfId;
+
+} CHILDMGR_TaskInit_t;
+
+typedef struct CHILDMGR_Class
+{
+
+   uint16  ValidCmdCnt;
+   uint16  InvalidCmdCnt;
+
+   bool       Started;
+   pthread_t  Thread;
+   CHILDMGR_TaskCallback_t TaskCallback;
+
+} CHILDMGR_Class_t;
+
+
+/************************/
+/** Exported Functions **/
+/************************/
+
+void  ChildMgr_TaskMainCallback(void);
+int32 CHILDMGR_Constructor(CHILDMGR_Class_t* ChildMgr, CFE_ES_ChildTaskMainFuncPtr_t ChildTaskMainFunc,
+                           CHILDMGR_TaskCallback_t AppMainCallback, CHILDMGR_TaskInit_t* TaskInit);
+void  CHILDMGR_ResetStatus(CHILDMGR_Class_t* ChildMgr);
+
+
+#endif /* _childmgr_ */
@@ -0,0 +1,45 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Define the OSK JSON file loader for the host build
+**
+*/
+
+#ifndef _cjson_
+#define _cjson_
+
+/*
+** Includes
+*/
+
+#include "osk_c_fw.h"
+#include "core_json.h"
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+typedef bool (*CJSON_LoadJsonData_t)(size_t JsonFileLen);
+
+
+/************************/
+/** Exported Functions **/
+/************************/
+
+bool CJSON_ProcessFile(const char* Filename, char* JsonBuf, size_t MaxJsonFileChar, CJSON_LoadJsonData_t LoadJsonData);
+
+
+#endif /* _cjson_ */
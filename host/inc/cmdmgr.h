@@ -0,0 +1,83 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Define the OSK command manager for the host build
+**
+**  Notes:
+**    1. Dispatches on the function code and checks the message length
+**       against the registered payload length like the framework's.
+**
+*/
+
+#ifndef _cmdmgr_
+#define _cmdmgr_
+
+/*
+** Includes
+*/
+
+#include "cfe.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define CMDMGR_CMD_FUNC_TOTAL  32
+
+#define CMDMGR_NOOP_CMD_FC   0
+#define CMDMGR_RESET_CMD_FC  1
+
+#define CMDMGR_PAYLOAD_PTR(MsgPtr, CmdType)  (&((const CmdType *)(MsgPtr))->Payload)
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+typedef bool (*CMDMGR_CmdFuncPtr_t)(void* ObjDataPtr, const CFE_MSG_Message_t *MsgPtr);
+
+typedef struct
+{
+
+   void*                ObjDataPtr;
+   CMDMGR_CmdFuncPtr_t  FuncPtr;
+   uint16               UserDataLen;
+
+} CMDMGR_Cmd_t;
+
+typedef struct
+{
+
+   uint16  ValidCmdCnt;
+   uint16  InvalidCmdCnt;
+
+   CMDMGR_Cmd_t  Cmd[CMDMGR_CMD_FUNC_TOTAL];
+
+} CMDMGR_Class_t;
+
+
+/************************/
+/** Exported Functions **/
+/************************/
+
+void CMDMGR_Constructor(CMDMGR_Class_t* CmdMgr);
+bool CMDMGR_DispatchFunc(CMDMGR_Class_t* CmdMgr, const CFE_MSG_Message_t *MsgPtr);
+bool CMDMGR_RegisterFunc(CMDMGR_Class_t* CmdMgr, uint16 FuncCode, void* ObjDataPtr,
+                         CMDMGR_CmdFuncPtr_t ObjFuncPtr, uint16 UserDataLen);
+void CMDMGR_ResetStatus(CMDMGR_Class_t* CmdMgr);
+
+
+#endif /* _cmdmgr_ */
@@ -0,0 +1,61 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Define the coreJSON search function for the host build
+**
+**  Notes:
+**    1. Queries are keys separated by '.' with "[n]" array indices, e.g.
+**       "step-array[2].step.hold-us". String values are returned without
+**       their quotes.
+**    2. Implemented by host/src/core_json_stub.c, it assumes a valid
+**       document and doesn't report JSONIllegalDocument.
+**
+*/
+
+#ifndef _core_json_
+#define _core_json_
+
+/*
+** Includes
+*/
+
+#include <stddef.h>
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+typedef enum
+{
+   JSONPartial = 0,
+   JSONSuccess,
+   JSONIllegalDocument,
+   JSONMaxDepthExceeded,
+   JSONNotFound,
+   JSONNullParameter,
+   JSONBadParameter
+} JSONStatus_t;
+
+
+/************************/
+/** Exported Functions **/
+/************************/
+
+JSONStatus_t JSON_Search(char* Buf, size_t Max, const char* Query, size_t QueryLength,
+                         char** OutValue, size_t* OutValueLength);
+
+
+#endif /* _core_json_ */
@@ -0,0 +1,32 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Define the pi_iolib GPIO functions for the host build
+**
+**  Notes:
+**    1. gpio_map() always fails so the PI backend behaves like a Pi
+**       without /dev/gpiomem. Use the SIM or MOCK backend on a host.
+**
+*/
+
+#ifndef _gpio_
+#define _gpio_
+
+int  gpio_map(void);
+void gpio_in(unsigned Pin);
+void gpio_out(unsigned Pin);
+
+
+#endif /* _gpio_ */
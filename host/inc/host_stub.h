@@ -0,0 +1,170 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Define the host build's control functions for programs that run the
+**    app, e.g. bench/gpio_demo_bench.c
+**
+**  Notes:
+**    1. The app runs unmodified: GPIO_DEMO_AppMain() is called on a thread
+**       of the host program and its child tasks are pthreads started by
+**       CHILDMGR.
+**    2. "/cf/" paths are mapped to the directory in the GPIO_DEMO_CF_DIR
+**       environment variable, or the build's cf directory when it isn't
+**       set. The build copies fsw/tables there.
+**
+*/
+
+#ifndef _host_stub_
+#define _host_stub_
+
+/*
+** Includes
+*/
+
+#include <stdio.h>
+
+#include "cfe.h"
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+typedef struct
+{
+
+   uint32  EventCnt;         /* Events formatted by CFE_EVS_SendEvent() */
+   uint32  SysLogCnt;
+   uint32  MsgCnt;           /* Messages transmitted */
+   uint64  MsgByteCnt;
+   uint32  NoSubscriberCnt;  /* Messages no pipe subscribed to */
+   uint32  PipeOverflowCnt;  /* Messages dropped because a pipe was full */
+   uint32  BufAllocCnt;      /* SB buffers allocated, including copies for TransmitMsg */
+   uint32  BufInUseCnt;
+
+} HOST_Stats_t;
+
+
+/************************/
+/** Exported Functions **/
+/************************/
+
+
+/******************************************************************************
+** Function: HOST_ES_Stop
+**
+** Make CFE_ES_RunLoop() return false and wake the app's pending receive
+**
+*/
+void HOST_ES_Stop(void);
+
+
+/******************************************************************************
+** Function: HOST_ES_WaitRunning
+**
+** Wait for the app's first CFE_ES_RunLoop() call and return whether its
+** initialization succeeded
+**
+*/
+bool HOST_ES_WaitRunning(void);
+
+
+/******************************************************************************
+** Function: HOST_GetStats
+**
+*/
+void HOST_GetStats(HOST_Stats_t* Stats);
+
+
+/******************************************************************************
+** Function: HOST_JoinChildTasks
+**
+** Wait for every child task started by CHILDMGR to return
+**
+** Notes:
+**   1. Called by CFE_ES_ExitApp() after the app has asked its child tasks
+**      to stop.
+**
+*/
+void HOST_JoinChildTasks(void);
+
+
+/******************************************************************************
+** Function: HOST_MapPath
+**
+** Return the host path for a flight file system path
+**
+*/
+const char* HOST_MapPath(const char* Path, char* HostPath, size_t HostPathLen);
+
+
+/******************************************************************************
+** Function: HOST_SB_GetMsgCnt
+**
+** Return the number of messages transmitted with MsgId
+**
+*/
+uint32 HOST_SB_GetMsgCnt(CFE_SB_MsgId_t MsgId);
+
+
+/******************************************************************************
+** Function: HOST_SB_SendWait
+**
+** Transmit a message like CFE_SB_TransmitMsg() with the sequence count
+** incremented, waiting for room in full pipes instead of dropping it
+**
+*/
+CFE_Status_t HOST_SB_SendWait(const CFE_MSG_Message_t *MsgPtr);
+
+
+/******************************************************************************
+** Function: HOST_SB_WaitIdle
+**
+** Wait until PipeId is empty and its reader is pending for the next message
+**
+** Notes:
+**   1. Every message received from the pipe has been processed when this
+**      returns.
+**
+*/
+void HOST_SB_WaitIdle(CFE_SB_PipeId_t PipeId);
+
+
+/******************************************************************************
+** Function: HOST_SetEventOutput
+**
+** Write events of EventType and above to Out, NULL disables event output
+**
+** Notes:
+**   1. Errors and critical events are written to stderr by default.
+**      Events are formatted and counted whether or not they're written.
+**
+*/
+void HOST_SetEventOutput(FILE* Out, uint16 EventType);
+
+
+/******************************************************************************
+** Function: HOST_SetIniConfig
+**
+** Override an ini file parameter
+**
+** Notes:
+**   1. Must be called before the app's INITBL_Constructor().
+**
+*/
+bool HOST_SetIniConfig(const char* Name, const char* Value);
+
+
+#endif /* _host_stub_ */
@@ -0,0 +1,73 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Define the OSK ini table for the host build
+**
+**  Notes:
+**    1. Reads each parameter from the ini file's "config" object. A
+**       parameter can be overridden with HOST_SetIniConfig() before the
+**       app is started.
+**
+*/
+
+#ifndef _initbl_
+#define _initbl_
+
+/*
+** Includes
+*/
+
+#include "osk_c_fw.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define INITBL_MAX_CFG_ITEMS    128
+#define INITBL_MAX_CFG_STR_LEN  OS_MAX_PATH_LEN
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+typedef struct
+{
+
+   uint32  Int;
+   char    Str[INITBL_MAX_CFG_STR_LEN];
+
+} INITBL_CfgItem_t;
+
+typedef struct
+{
+
+   const INILIB_CfgEnum_t* CfgEnum;
+   INITBL_CfgItem_t Item[INITBL_MAX_CFG_ITEMS];
+
+} INITBL_Class_t;
+
+
+/************************/
+/** Exported Functions **/
+/************************/
+
+bool   INITBL_Constructor(INITBL_Class_t* IniTbl, const char* IniFile, INILIB_CfgEnum_t* IniCfgEnum);
+uint32 INITBL_GetIntConfig(INITBL_Class_t* IniTbl, uint16 Param);
+const char* INITBL_GetStrConfig(INITBL_Class_t* IniTbl, uint16 Param);
+
+
+#endif /* _initbl_ */
@@ -0,0 +1,89 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Define the subset of the OpenSatKit C framework used by the app for
+**    the host build
+**
+**  Notes:
+**    1. Implemented by host/src/osk_c_fw_stub.c. The component headers
+**       are separate files like the framework's and included at the end
+**       so they can use the types defined here.
+**
+*/
+
+#ifndef _osk_c_fw_
+#define _osk_c_fw_
+
+/*
+** Includes
+*/
+
+#include <string.h>
+
+#include "cfe.h"
+#include "cmdmgr.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define OSK_C_FW_CFS_ERROR     ((int32)0xc0000001)
+#define OSK_C_FW_APP_BASE_EID  100
+
+#define OSK_C_FW_APP_BASE_CC   10
+
+
+/*
+** INILIB configuration enumeration
+** - DECLARE_ENUM() defines an enum of the ini parameter names, DEFINE_ENUM()
+**   the matching name strings INITBL looks up in the ini file
+*/
+
+#define INILIB_ENUM_VALUE(Name,Type)   Name,
+#define INILIB_ENUM_STRING(Name,Type)  #Name,
+
+#define DECLARE_ENUM(Type,List) \
+   typedef enum { Type##_START_ = 0, List(INILIB_ENUM_VALUE) Type##_ENUM_CNT } Type##_Enum_t;
+
+#define DEFINE_ENUM(Type,List) \
+   static const char* IniCfgStr[] = { "", List(INILIB_ENUM_STRING) }; \
+   static INILIB_CfgEnum_t IniCfgEnum = { Type##_ENUM_CNT, IniCfgStr };
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+typedef struct
+{
+
+   uint16        Cnt;   /* Includes the unused entry 0 */
+   const char**  Str;
+
+} INILIB_CfgEnum_t;
+
+
+/*
+** Framework components
+*/
+
+#include "childmgr.h"
+#include "cjson.h"
+#include "initbl.h"
+#include "tblmgr.h"
+
+
+#endif /* _osk_c_fw_ */
@@ -0,0 +1,91 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Define the OSK table manager for the host build
+**
+*/
+
+#ifndef _tblmgr_
+#define _tblmgr_
+
+/*
+** Includes
+*/
+
+#include "osk_c_fw.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define TBLMGR_MAX_TBL_PER_APP  5
+
+#define TBLMGR_LOAD_TBL_REPLACE  0
+#define TBLMGR_LOAD_TBL_UPDATE   1
+
+#define TBLMGR_STATUS_UNDEF    0
+#define TBLMGR_STATUS_VALID    1
+#define TBLMGR_STATUS_INVALID  2
+
+#define TBLMGR_ACTION_UNDEF  0
+#define TBLMGR_ACTION_LOAD   1
+#define TBLMGR_ACTION_DUMP   2
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+typedef struct TBLMGR_Tbl TBLMGR_Tbl_t;
+
+typedef bool (*TBLMGR_LoadTblFuncPtr_t)(TBLMGR_Tbl_t* Tbl, uint8 LoadType, const char* Filename);
+typedef bool (*TBLMGR_DumpTblFuncPtr_t)(TBLMGR_Tbl_t* Tbl, uint8 DumpType, const char* Filename);
+
+struct TBLMGR_Tbl
+{
+
+   uint8  Id;
+   bool   Loaded;
+   uint8  LastAction;
+   uint8  LastActionStatus;
+
+   TBLMGR_LoadTblFuncPtr_t LoadFuncPtr;
+   TBLMGR_DumpTblFuncPtr_t DumpFuncPtr;
+
+};
+
+typedef struct
+{
+
+   uint8         NextAvailableId;
+   TBLMGR_Tbl_t  Tbl[TBLMGR_MAX_TBL_PER_APP];
+
+} TBLMGR_Class_t;
+
+
+/************************/
+/** Exported Functions **/
+/************************/
+
+void  TBLMGR_Constructor(TBLMGR_Class_t* TblMgr);
+bool  TBLMGR_DumpTblCmd(void* ObjDataPtr, const CFE_MSG_Message_t *MsgPtr);
+bool  TBLMGR_LoadTblCmd(void* ObjDataPtr, const CFE_MSG_Message_t *MsgPtr);
+const char* TBLMGR_LoadTypeStr(int8 LoadType);
+uint8 TBLMGR_RegisterTblWithDef(TBLMGR_Class_t* TblMgr, TBLMGR_LoadTblFuncPtr_t LoadFuncPtr,
+                                TBLMGR_DumpTblFuncPtr_t DumpFuncPtr, const char* TblFilename);
+
+
+#endif /* _tblmgr_ */
@@ -0,0 +1,1179 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Implement the cFE and OSAL functions used by the app for the host
+**    build
+**
+**  Notes:
+**    1. The software bus routes messages to subscribed pipes by message
+**       ID like cFE. Buffers are reference counted heap blocks so a
+**       zero-copy buffer is queued without a copy and CFE_SB_TransmitMsg()
+**       copies once. Messages without a subscriber are counted and
+**       released.
+**    2. A received buffer is released by the reader's next receive, as in
+**       cFE.
+**    3. Events are formatted into a long event packet and sent on the
+**       software bus like cFE EVS so their cost is measured, see
+**       HOST_SetEventOutput() for output.
+**    4. Performance log markers are ignored.
+**
+*/
+
+/*
+** Include Files:
+*/
+
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "cfe.h"
+#include "host_stub.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define SB_MAX_PIPES      8
+#define SB_MAX_PIPE_DEPTH 256
+#define SB_MAX_SUBS       32
+#define SB_MAX_SEQ_CNT    64     /* Message IDs with a sequence and message counter */
+#define SB_SEQ_CNT_MASK   0x3FFF
+
+#define CCSDS_SEQ_FLAGS   0xC000   /* Unsegmented */
+#define CCSDS_LEN_OFFSET  7
+
+#define EVS_LONG_EVENT_MID  0x0808   /* cFE default CFE_EVS_LONG_EVENT_MSG_MID */
+
+#define TIME_UNIX_EPOCH_OFFSET  315964800   /* 1970 to the cFE default 1980 epoch */
+
+#ifndef HOST_CF_DIR
+#define HOST_CF_DIR  "cf"
+#endif
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+typedef struct
+{
+
+   CFE_MSG_TelemetryHeader_t TelemetryHeader;
+   char    AppName[20];
+   uint16  EventID;
+   uint16  EventType;
+   uint32  SpacecraftID;
+   uint32  ProcessorID;
+   char    Message[CFE_MISSION_EVS_MAX_MESSAGE_LENGTH];
+   uint8   Spare1;
+   uint8   Spare2;
+
+} EvsLongEventTlm_t;
+
+typedef struct
+{
+
+   uint32  RefCnt;
+   size_t  Size;
+   CFE_SB_Buffer_t Buf;   /* Must be last */
+
+} SbBufDesc_t;
+
+typedef struct
+{
+
+   bool   InUse;
+   bool   Pending;   /* Reader is waiting for a message */
+   uint16 Depth;
+   uint16 Count;
+   uint16 Head;
+   char   Name[32];
+   SbBufDesc_t*  Queue[SB_MAX_PIPE_DEPTH];
+   SbBufDesc_t*  LastRcv;   /* Released by the next receive */
+   pthread_cond_t MsgCond;
+
+} SbPipe_t;
+
+typedef struct
+{
+
+   CFE_SB_MsgId_t   MsgId;
+   CFE_SB_PipeId_t  PipeId;
+
+} SbSub_t;
+
+typedef struct
+{
+
+   CFE_SB_MsgId_t  MsgId;
+   uint16          SeqCnt;
+   uint32          MsgCnt;   /* Messages transmitted */
+
+} SbSeqCnt_t;
+
+
+/**********************/
+/** Global File Data **/
+/**********************/
+
+static pthread_mutex_t SbMutex    = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t  SpaceCond  = PTHREAD_COND_INITIALIZER;   /* A pipe entry was freed */
+static pthread_cond_t  IdleCond   = PTHREAD_COND_INITIALIZER;   /* A reader started pending */
+static pthread_cond_t  RunCond    = PTHREAD_COND_INITIALIZER;   /* The app's first CFE_ES_RunLoop() */
+
+static SbPipe_t   Pipe[SB_MAX_PIPES];
+static SbSub_t    Sub[SB_MAX_SUBS];
+static uint16     SubCnt;
+static SbSeqCnt_t SeqCnt[SB_MAX_SEQ_CNT];
+static uint16     SeqCntCnt;
+
+static volatile bool EsStop;
+static bool          EsRunSeen;
+static bool          EsRunning;
+static HOST_Stats_t  Stats;
+
+static FILE*   EventOut  = NULL;
+static uint16  EventType = CFE_EVS_EventType_ERROR;
+static bool    EventOutSet = false;
+
+
+/*******************************/
+/** Local Function Prototypes **/
+/*******************************/
+
+static SbBufDesc_t* BufDesc(const CFE_SB_Buffer_t* SbBuf);
+static SbBufDesc_t* NewBuf(size_t Size);
+static SbPipe_t*    GetPipe(CFE_SB_PipeId_t PipeId);
+static SbSeqCnt_t*  GetSeqCnt(CFE_SB_MsgId_t MsgId);
+static uint16 GetUint16(const uint8* Byte);
+static void   PutUint16(uint8* Byte, uint16 Value);
+static void   ReleaseBuf(SbBufDesc_t* Desc);
+static CFE_Status_t Route(SbBufDesc_t* Desc, bool IncrementSequenceCount, bool Wait);
+static void   SetSeqCnt(CFE_MSG_Message_t *MsgPtr, SbSeqCnt_t* Entry);
+
+
+/******************************************************************************
+** Function: CFE_ES_ExitApp
+**
+*/
+void CFE_ES_ExitApp(uint32 ExitStatus)
+{
+
+   HOST_JoinChildTasks();
+
+} /* End CFE_ES_ExitApp() */
+
+
+/******************************************************************************
+** Function: CFE_ES_PerfLogAdd
+**
+*/
+void CFE_ES_PerfLogAdd(uint32 Marker, uint32 EntryExit)
+{
+
+} /* End CFE_ES_PerfLogAdd() */
+
+
+/******************************************************************************
+** Function: CFE_ES_RunLoop
+**
+*/
+bool CFE_ES_RunLoop(uint32 *RunStatus)
+{
+
+   bool Running = (*RunStatus == CFE_ES_RunStatus_APP_RUN) && !EsStop;
+
+   if (!EsRunSeen)
+   {
+      pthread_mutex_lock(&SbMutex);
+      EsRunSeen = true;
+      EsRunning = Running;
+      pthread_cond_broadcast(&RunCond);
+      pthread_mutex_unlock(&SbMutex);
+   }
+
+   return Running;
+
+} /* End CFE_ES_RunLoop() */
+
+
+/******************************************************************************
+** Function: CFE_ES_WriteToSysLog
+**
+*/
+CFE_Status_t CFE_ES_WriteToSysLog(const char *SpecStringPtr, ...)
+{
+
+   va_list Args;
+
+   __atomic_fetch_add(&Stats.SysLogCnt, 1, __ATOMIC_RELAXED);
+
+   va_start(Args, SpecStringPtr);
+   vfprintf(stderr, SpecStringPtr, Args);
+   va_end(Args);
+
+   return CFE_SUCCESS;
+
+} /* End CFE_ES_WriteToSysLog() */
+
+
+/******************************************************************************
+** Function: CFE_EVS_Register
+**
+*/
+CFE_Status_t CFE_EVS_Register(const void *Filters, uint16 NumEventFilters, uint16 FilterScheme)
+{
+
+   if (!EventOutSet)
+   {
+      EventOut = stderr;
+   }
+
+   return CFE_SUCCESS;
+
+} /* End CFE_EVS_Register() */
+
+
+/******************************************************************************
+** Function: CFE_EVS_SendEvent
+**
+*/
+CFE_Status_t CFE_EVS_SendEvent(uint16 EventID, uint16 Type, const char *Spec, ...)
+{
+
+   EvsLongEventTlm_t Pkt;
+   va_list Args;
+
+   memset(&Pkt, 0, sizeof(Pkt));
+   CFE_MSG_Init(&Pkt.TelemetryHeader.Msg, CFE_SB_ValueToMsgId(EVS_LONG_EVENT_MID), sizeof(Pkt));
+   Pkt.EventID   = EventID;
+   Pkt.EventType = Type;
+
+   va_start(Args, Spec);
+   vsnprintf(Pkt.Message, sizeof(Pkt.Message), Spec, Args);
+   va_end(Args);
+
+   __atomic_fetch_add(&Stats.EventCnt, 1, __ATOMIC_RELAXED);
+
+   if (EventOut != NULL && Type >= EventType)
+   {
+      fprintf(EventOut, "EVS %u %u: %s\n", EventID, Type, Pkt.Message);
+   }
+
+   CFE_SB_TimeStampMsg(&Pkt.TelemetryHeader.Msg);
+   CFE_SB_TransmitMsg(&Pkt.TelemetryHeader.Msg, true);
+
+   return CFE_SUCCESS;
+
+} /* End CFE_EVS_SendEvent() */
+
+
+/******************************************************************************
+** Function: CFE_MSG_GetFcnCode
+**
+*/
+CFE_Status_t CFE_MSG_GetFcnCode(const CFE_MSG_Message_t *MsgPtr, CFE_MSG_FcnCode_t *FcnCode)
+{
+
+   *FcnCode = ((const CFE_MSG_CommandHeader_t*)MsgPtr)->FunctionCode & 0x7F;
+
+   return CFE_SUCCESS;
+
+} /* End CFE_MSG_GetFcnCode() */
+
+
+/******************************************************************************
+** Function: CFE_MSG_GetMsgId
+**
+*/
+CFE_Status_t CFE_MSG_GetMsgId(const CFE_MSG_Message_t *MsgPtr, CFE_SB_MsgId_t *MsgId)
+{
+
+   *MsgId = GetUint16(&MsgPtr->Byte[0]);
+
+   return CFE_SUCCESS;
+
+} /* End CFE_MSG_GetMsgId() */
+
+
+/******************************************************************************
+** Function: CFE_MSG_GetSequenceCount
+**
+*/
+CFE_Status_t CFE_MSG_GetSequenceCount(const CFE_MSG_Message_t *MsgPtr, CFE_MSG_SequenceCount_t *SeqCnt)
+{
+
+   *SeqCnt = GetUint16(&MsgPtr->Byte[2]) & SB_SEQ_CNT_MASK;
+
+   return CFE_SUCCESS;
+
+} /* End CFE_MSG_GetSequenceCount() */
+
+
+/******************************************************************************
+** Function: CFE_MSG_GetSize
+**
+*/
+CFE_Status_t CFE_MSG_GetSize(const CFE_MSG_Message_t *MsgPtr, CFE_MSG_Size_t *Size)
+{
+
+   *Size = (CFE_MSG_Size_t)GetUint16(&MsgPtr->Byte[4]) + CCSDS_LEN_OFFSET;
+
+   return CFE_SUCCESS;
+
+} /* End CFE_MSG_GetSize() */
+
+
+/******************************************************************************
+** Function: CFE_MSG_Init
+**
+*/
+CFE_Status_t CFE_MSG_Init(CFE_MSG_Message_t *MsgPtr, CFE_SB_MsgId_t MsgId, CFE_MSG_Size_t Size)
+{
+
+   if (Size < sizeof(CFE_MSG_Message_t) || Size > CFE_MISSION_SB_MAX_SB_MSG_SIZE)
+   {
+      return CFE_SB_BAD_ARGUMENT;
+   }
+
+   memset(MsgPtr, 0, Size);
+   PutUint16(&MsgPtr->Byte[0], MsgId);
+   PutUint16(&MsgPtr->Byte[2], CCSDS_SEQ_FLAGS);
+   PutUint16(&MsgPtr->Byte[4], Size - CCSDS_LEN_OFFSET);
+
+   return CFE_SUCCESS;
+
+} /* End CFE_MSG_Init() */
+
+
+/******************************************************************************
+** Function: CFE_MSG_SetFcnCode
+**
+*/
+CFE_Status_t CFE_MSG_SetFcnCode(CFE_MSG_Message_t *MsgPtr, CFE_MSG_FcnCode_t FcnCode)
+{
+
+   ((CFE_MSG_CommandHeader_t*)MsgPtr)->FunctionCode = FcnCode & 0x7F;
+
+   return CFE_SUCCESS;
+
+} /* End CFE_MSG_SetFcnCode() */
+
+
+/******************************************************************************
+** Function: CFE_SB_AllocateMessageBuffer
+**
+*/
+CFE_SB_Buffer_t* CFE_SB_AllocateMessageBuffer(size_t MsgSize)
+{
+
+   SbBufDesc_t* Desc = NULL;
+
+   if (MsgSize <= CFE_MISSION_SB_MAX_SB_MSG_SIZE)
+   {
+      Desc = NewBuf(MsgSize);
+   }
+
+   return (Desc == NULL) ? NULL : &Desc->Buf;
+
+} /* End CFE_SB_AllocateMessageBuffer() */
+
+
+/******************************************************************************
+** Function: CFE_SB_CreatePipe
+**
+*/
+CFE_Status_t CFE_SB_CreatePipe(CFE_SB_PipeId_t *PipeIdPtr, uint16 Depth, const char *PipeName)
+{
+
+   CFE_Status_t RetStatus = CFE_SB_PIPE_CR_ERR;
+   uint16 i;
+
+   if (Depth == 0 || Depth > SB_MAX_PIPE_DEPTH)
+   {
+      return CFE_SB_BAD_ARGUMENT;
+   }
+
+   pthread_mutex_lock(&SbMutex);
+   for (i=0; i < SB_MAX_PIPES; i++)
+   {
+      if (!Pipe[i].InUse)
+      {
+         memset(&Pipe[i], 0, sizeof(SbPipe_t));
+         Pipe[i].InUse = true;
+         Pipe[i].Depth = Depth;
+         strncpy(Pipe[i].Name, PipeName, sizeof(Pipe[i].Name)-1);
+         pthread_cond_init(&Pipe[i].MsgCond, NULL);
+         *PipeIdPtr = i + 1;
+         RetStatus = CFE_SUCCESS;
+         break;
+      }
+   }
+   pthread_mutex_unlock(&SbMutex);
+
+   return RetStatus;
+
+} /* End CFE_SB_CreatePipe() */
+
+
+/******************************************************************************
+** Function: CFE_SB_MsgId_Equal
+**
+*/
+bool CFE_SB_MsgId_Equal(CFE_SB_MsgId_t MsgId1, CFE_SB_MsgId_t MsgId2)
+{
+
+   return MsgId1 == MsgId2;
+
+} /* End CFE_SB_MsgId_Equal() */
+
+
+/******************************************************************************
+** Function: CFE_SB_MsgIdToValue
+**
+*/
+uint32 CFE_SB_MsgIdToValue(CFE_SB_MsgId_t MsgId)
+{
+
+   return MsgId;
+
+} /* End CFE_SB_MsgIdToValue() */
+
+
+/******************************************************************************
+** Function: CFE_SB_ReceiveBuffer
+**
+** Notes:
+**   1. Waits on CLOCK_REALTIME, a timeout is only used by input capture's
+**      drain period so clock changes don't matter.
+**
+*/
+CFE_Status_t CFE_SB_ReceiveBuffer(CFE_SB_Buffer_t **BufPtr, CFE_SB_PipeId_t PipeId, int32 TimeOut)
+{
+
+   SbPipe_t* SbPipe = GetPipe(PipeId);
+   CFE_Status_t RetStatus = CFE_SUCCESS;
+   struct timespec Deadline;
+   int WaitStatus = 0;
+
+   if (SbPipe == NULL || BufPtr == NULL)
+   {
+      return CFE_SB_BAD_ARGUMENT;
+   }
+
+   if (TimeOut > 0)
+   {
+      clock_gettime(CLOCK_REALTIME, &Deadline);
+      Deadline.tv_sec  += TimeOut / 1000;
+      Deadline.tv_nsec += (long)(TimeOut % 1000) * 1000000;
+      if (Deadline.tv_nsec >= 1000000000)
+      {
+         Deadline.tv_sec++;
+         Deadline.tv_nsec -= 1000000000;
+      }
+   }
+
+   pthread_mutex_lock(&SbMutex);
+
+   if (SbPipe->LastRcv != NULL)
+   {
+      ReleaseBuf(SbPipe->LastRcv);
+      SbPipe->LastRcv = NULL;
+   }
+
+   if (SbPipe->Count == 0 && TimeOut != CFE_SB_POLL)
+   {
+      SbPipe->Pending = true;
+      pthread_cond_broadcast(&IdleCond);
+      while (SbPipe->Count == 0 && !EsStop && WaitStatus != ETIMEDOUT)
+      {
+         if (TimeOut > 0)
+         {
+            WaitStatus = pthread_cond_timedwait(&SbPipe->MsgCond, &SbMutex, &Deadline);
+         }
+         else
+         {
+            pthread_cond_wait(&SbPipe->MsgCond, &SbMutex);
+         }
+      }
+      SbPipe->Pending = false;
+   }
+
+   if (SbPipe->Count > 0)
+   {
+      SbPipe->LastRcv = SbPipe->Queue[SbPipe->Head];
+      SbPipe->Head    = (SbPipe->Head + 1) % SB_MAX_PIPE_DEPTH;
+      SbPipe->Count--;
+      *BufPtr = &SbPipe->LastRcv->Buf;
+      pthread_cond_broadcast(&SpaceCond);
+   }
+   else
+   {
+      *BufPtr   = NULL;
+      RetStatus = (TimeOut == CFE_SB_POLL) ? CFE_SB_NO_MESSAGE : CFE_SB_TIME_OUT;
+   }
+
+   pthread_mutex_unlock(&SbMutex);
+
+   return RetStatus;
+
+} /* End CFE_SB_ReceiveBuffer() */
+
+
+/******************************************************************************
+** Function: CFE_SB_ReleaseMessageBuffer
+**
+*/
+CFE_Status_t CFE_SB_ReleaseMessageBuffer(CFE_SB_Buffer_t *BufPtr)
+{
+
+   pthread_mutex_lock(&SbMutex);
+   ReleaseBuf(BufDesc(BufPtr));
+   pthread_mutex_unlock(&SbMutex);
+
+   return CFE_SUCCESS;
+
+} /* End CFE_SB_ReleaseMessageBuffer() */
+
+
+/******************************************************************************
+** Function: CFE_SB_Subscribe
+**
+*/
+CFE_Status_t CFE_SB_Subscribe(CFE_SB_MsgId_t MsgId, CFE_SB_PipeId_t PipeId)
+{
+
+   CFE_Status_t RetStatus = CFE_SB_BAD_ARGUMENT;
+
+   pthread_mutex_lock(&SbMutex);
+   if (GetPipe(PipeId) != NULL && SubCnt < SB_MAX_SUBS)
+   {
+      Sub[SubCnt].MsgId  = MsgId;
+      Sub[SubCnt].PipeId = PipeId;
+      SubCnt++;
+      RetStatus = CFE_SUCCESS;
+   }
+   pthread_mutex_unlock(&SbMutex);
+
+   return RetStatus;
+
+} /* End CFE_SB_Subscribe() */
+
+
+/******************************************************************************
+** Function: CFE_SB_TimeStampMsg
+**
+*/
+void CFE_SB_TimeStampMsg(CFE_MSG_Message_t *MsgPtr)
+{
+
+   CFE_MSG_TelemetryHeader_t* TlmHdr = (CFE_MSG_TelemetryHeader_t*)MsgPtr;
+   CFE_TIME_SysTime_t Time = CFE_TIME_GetTime();
+
+   PutUint16(&TlmHdr->Time[0], Time.Seconds >> 16);
+   PutUint16(&TlmHdr->Time[2], Time.Seconds & 0xFFFF);
+   PutUint16(&TlmHdr->Time[4], Time.Subseconds >> 16);
+
+} /* End CFE_SB_TimeStampMsg() */
+
+
+/******************************************************************************
+** Function: CFE_SB_TransmitBuffer
+**
+*/
+CFE_Status_t CFE_SB_TransmitBuffer(CFE_SB_Buffer_t *BufPtr, bool IncrementSequenceCount)
+{
+
+   return Route(BufDesc(BufPtr), IncrementSequenceCount, false);
+
+} /* End CFE_SB_TransmitBuffer() */
+
+
+/******************************************************************************
+** Function: CFE_SB_TransmitMsg
+**
+*/
+CFE_Status_t CFE_SB_TransmitMsg(const CFE_MSG_Message_t *MsgPtr, bool IncrementSequenceCount)
+{
+
+   CFE_MSG_Size_t Size;
+   SbBufDesc_t* Desc;
+
+   CFE_MSG_GetSize(MsgPtr, &Size);
+   Desc = NewBuf(Size);
+   if (Desc == NULL)
+   {
+      return CFE_SB_BUF_ALOC_ERR;
+   }
+   memcpy(&Desc->Buf, MsgPtr, Size);
+
+   return Route(Desc, IncrementSequenceCount, false);
+
+} /* End CFE_SB_TransmitMsg() */
+
+
+/******************************************************************************
+** Function: CFE_SB_ValueToMsgId
+**
+*/
+CFE_SB_MsgId_t CFE_SB_ValueToMsgId(uint32 MsgIdValue)
+{
+
+   return MsgIdValue;
+
+} /* End CFE_SB_ValueToMsgId() */
+
+
+/******************************************************************************
+** Function: CFE_TIME_Compare
+**
+*/
+CFE_TIME_Compare_t CFE_TIME_Compare(CFE_TIME_SysTime_t TimeA, CFE_TIME_SysTime_t TimeB)
+{
+
+   if (TimeA.Seconds != TimeB.Seconds)
+   {
+      return (TimeA.Seconds > TimeB.Seconds) ? CFE_TIME_A_GT_B : CFE_TIME_A_LT_B;
+   }
+   if (TimeA.Subseconds != TimeB.Subseconds)
+   {
+      return (TimeA.Subseconds > TimeB.Subseconds) ? CFE_TIME_A_GT_B : CFE_TIME_A_LT_B;
+   }
+
+   return CFE_TIME_EQUAL;
+
+} /* End CFE_TIME_Compare() */
+
+
+/******************************************************************************
+** Function: CFE_TIME_GetTime
+**
+*/
+CFE_TIME_SysTime_t CFE_TIME_GetTime(void)
+{
+
+   CFE_TIME_SysTime_t Time;
+   struct timespec Now;
+
+   clock_gettime(CLOCK_REALTIME, &Now);
+   Time.Seconds    = (uint32)(Now.tv_sec - TIME_UNIX_EPOCH_OFFSET);
+   Time.Subseconds = (uint32)(((uint64)Now.tv_nsec << 32) / 1000000000);
+
+   return Time;
+
+} /* End CFE_TIME_GetTime() */
+
+
+/******************************************************************************
+** Function: CFE_TIME_Sub2MicroSecs
+**
+*/
+uint32 CFE_TIME_Sub2MicroSecs(uint32 SubSeconds)
+{
+
+   return (uint32)(((uint64)SubSeconds * 1000000) >> 32);
+
+} /* End CFE_TIME_Sub2MicroSecs() */
+
+
+/******************************************************************************
+** Function: CFE_TIME_Subtract
+**
+*/
+CFE_TIME_SysTime_t CFE_TIME_Subtract(CFE_TIME_SysTime_t Time1, CFE_TIME_SysTime_t Time2)
+{
+
+   CFE_TIME_SysTime_t Result;
+
+   Result.Subseconds = Time1.Subseconds - Time2.Subseconds;
+   Result.Seconds    = Time1.Seconds - Time2.Seconds - (Result.Subseconds > Time1.Subseconds ? 1 : 0);
+
+   return Result;
+
+} /* End CFE_TIME_Subtract() */
+
+
+/******************************************************************************
+** Function: OS_close
+**
+*/
+int32 OS_close(osal_id_t FileDes)
+{
+
+   return (close((int)FileDes - 1) == 0) ? OS_SUCCESS : OS_ERROR;
+
+} /* End OS_close() */
+
+
+/******************************************************************************
+** Function: OS_OpenCreate
+**
+*/
+int32 OS_OpenCreate(osal_id_t *FileDes, const char *Path, int32 Flags, int32 AccessMode)
+{
+
+   char HostPath[OS_MAX_PATH_LEN*2];
+   int  OpenFlags = (AccessMode == OS_WRITE_ONLY) ? O_WRONLY : (AccessMode == OS_READ_WRITE) ? O_RDWR : O_RDONLY;
+   int  Fd;
+
+   if (Flags & OS_FILE_FLAG_CREATE)
+   {
+      OpenFlags |= O_CREAT;
+   }
+   if (Flags & OS_FILE_FLAG_TRUNCATE)
+   {
+      OpenFlags |= O_TRUNC;
+   }
+
+   Fd = open(HOST_MapPath(Path, HostPath, sizeof(HostPath)), OpenFlags, 0644);
+   if (Fd < 0)
+   {
+      *FileDes = OS_OBJECT_ID_UNDEFINED;
+      return OS_ERROR;
+   }
+
+   *FileDes = (osal_id_t)Fd + 1;
+
+   return OS_SUCCESS;
+
+} /* End OS_OpenCreate() */
+
+
+/******************************************************************************
+** Function: OS_read
+**
+*/
+int32 OS_read(osal_id_t FileDes, void *Buffer, size_t NumBytes)
+{
+
+   ssize_t Len = read((int)FileDes - 1, Buffer, NumBytes);
+
+   return (Len < 0) ? OS_ERROR : (int32)Len;
+
+} /* End OS_read() */
+
+
+/******************************************************************************
+** Function: OS_write
+**
+*/
+int32 OS_write(osal_id_t FileDes, const void *Buffer, size_t NumBytes)
+{
+
+   ssize_t Len = write((int)FileDes - 1, Buffer, NumBytes);
+
+   return (Len < 0) ? OS_ERROR : (int32)Len;
+
+} /* End OS_write() */
+
+
+/******************************************************************************
+** Function: HOST_ES_Stop
+**
+*/
+void HOST_ES_Stop(void)
+{
+
+   uint16 i;
+
+   pthread_mutex_lock(&SbMutex);
+   EsStop = true;
+   for (i=0; i < SB_MAX_PIPES; i++)
+   {
+      if (Pipe[i].InUse)
+      {
+         pthread_cond_broadcast(&Pipe[i].MsgCond);
+      }
+   }
+   pthread_mutex_unlock(&SbMutex);
+
+} /* End HOST_ES_Stop() */
+
+
+/******************************************************************************
+** Function: HOST_ES_WaitRunning
+**
+*/
+bool HOST_ES_WaitRunning(void)
+{
+
+   bool Running;
+
+   pthread_mutex_lock(&SbMutex);
+   while (!EsRunSeen)
+   {
+      pthread_cond_wait(&RunCond, &SbMutex);
+   }
+   Running = EsRunning;
+   pthread_mutex_unlock(&SbMutex);
+
+   return Running;
+
+} /* End HOST_ES_WaitRunning() */
+
+
+/******************************************************************************
+** Function: HOST_GetStats
+**
+*/
+void HOST_GetStats(HOST_Stats_t* StatsOut)
+{
+
+   pthread_mutex_lock(&SbMutex);
+   *StatsOut = Stats;
+   StatsOut->EventCnt  = __atomic_load_n(&Stats.EventCnt, __ATOMIC_RELAXED);
+   StatsOut->SysLogCnt = __atomic_load_n(&Stats.SysLogCnt, __ATOMIC_RELAXED);
+   pthread_mutex_unlock(&SbMutex);
+
+} /* End HOST_GetStats() */
+
+
+/******************************************************************************
+** Function: HOST_MapPath
+**
+*/
+const char* HOST_MapPath(const char* Path, char* HostPath, size_t HostPathLen)
+{
+
+   const char* CfDir = getenv("GPIO_DEMO_CF_DIR");
+
+   if (strncmp(Path, "/cf/", 4) != 0)
+   {
+      return Path;
+   }
+
+   snprintf(HostPath, HostPathLen, "%s/%s", (CfDir != NULL) ? CfDir : HOST_CF_DIR, &Path[4]);
+
+   return HostPath;
+
+} /* End HOST_MapPath() */
+
+
+/******************************************************************************
+** Function: HOST_SB_GetMsgCnt
+**
+*/
+uint32 HOST_SB_GetMsgCnt(CFE_SB_MsgId_t MsgId)
+{
+
+   uint32 MsgCnt = 0;
+   uint16 i;
+
+   pthread_mutex_lock(&SbMutex);
+   for (i=0; i < SeqCntCnt; i++)
+   {
+      if (SeqCnt[i].MsgId == MsgId)
+      {
+         MsgCnt = SeqCnt[i].MsgCnt;
+         break;
+      }
+   }
+   pthread_mutex_unlock(&SbMutex);
+
+   return MsgCnt;
+
+} /* End HOST_SB_GetMsgCnt() */
+
+
+/******************************************************************************
+** Function: HOST_SB_SendWait
+**
+*/
+CFE_Status_t HOST_SB_SendWait(const CFE_MSG_Message_t *MsgPtr)
+{
+
+   CFE_MSG_Size_t Size;
+   SbBufDesc_t* Desc;
+
+   CFE_MSG_GetSize(MsgPtr, &Size);
+   Desc = NewBuf(Size);
+   if (Desc == NULL)
+   {
+      return CFE_SB_BUF_ALOC_ERR;
+   }
+   memcpy(&Desc->Buf, MsgPtr, Size);
+
+   return Route(Desc, true, true);
+
+} /* End HOST_SB_SendWait() */
+
+
+/******************************************************************************
+** Function: HOST_SB_WaitIdle
+**
+*/
+void HOST_SB_WaitIdle(CFE_SB_PipeId_t PipeId)
+{
+
+   SbPipe_t* SbPipe = GetPipe(PipeId);
+
+   if (SbPipe == NULL)
+   {
+      return;
+   }
+
+   pthread_mutex_lock(&SbMutex);
+   while ((SbPipe->Count > 0 || !SbPipe->Pending) && !EsStop)
+   {
+      pthread_cond_wait(&IdleCond, &SbMutex);
+   }
+   pthread_mutex_unlock(&SbMutex);
+
+} /* End HOST_SB_WaitIdle() */
+
+
+/******************************************************************************
+** Function: HOST_SetEventOutput
+**
+*/
+void HOST_SetEventOutput(FILE* Out, uint16 Type)
+{
+
+   EventOut    = Out;
+   EventType   = Type;
+   EventOutSet = true;
+
+} /* End HOST_SetEventOutput() */
+
+
+/******************************************************************************
+** Function: BufDesc
+**
+*/
+static SbBufDesc_t* BufDesc(const CFE_SB_Buffer_t* SbBuf)
+{
+
+   return (SbBufDesc_t*)((uint8*)SbBuf - offsetof(SbBufDesc_t, Buf));
+
+} /* End BufDesc() */
+
+
+/******************************************************************************
+** Function: GetPipe
+**
+*/
+static SbPipe_t* GetPipe(CFE_SB_PipeId_t PipeId)
+{
+
+   if (PipeId == 0 || PipeId > SB_MAX_PIPES || !Pipe[PipeId-1].InUse)
+   {
+      return NULL;
+   }
+
+   return &Pipe[PipeId-1];
+
+} /* End GetPipe() */
+
+
+/******************************************************************************
+** Function: GetSeqCnt
+**
+** Return MsgId's counters, adding them on its first message
+**
+** Notes:
+**   1. Caller must hold SbMutex.
+**   2. Returns NULL once SB_MAX_SEQ_CNT message IDs have counters.
+**
+*/
+static SbSeqCnt_t* GetSeqCnt(CFE_SB_MsgId_t MsgId)
+{
+
+   SbSeqCnt_t* Entry = NULL;
+   uint16 i;
+
+   for (i=0; i < SeqCntCnt; i++)
+   {
+      if (SeqCnt[i].MsgId == MsgId)
+      {
+         return &SeqCnt[i];
+      }
+   }
+   if (SeqCntCnt < SB_MAX_SEQ_CNT)
+   {
+      Entry = &SeqCnt[SeqCntCnt++];
+      Entry->MsgId  = MsgId;
+      Entry->SeqCnt = 0;
+      Entry->MsgCnt = 0;
+   }
+
+   return Entry;
+
+} /* End GetSeqCnt() */
+
+
+/******************************************************************************
+** Function: GetUint16
+**
+*/
+static uint16 GetUint16(const uint8* Byte)
+{
+
+   return (uint16)((Byte[0] << 8) | Byte[1]);
+
+} /* End GetUint16() */
+
+
+/******************************************************************************
+** Function: NewBuf
+**
+** Notes:
+**   1. The buffer has one reference, the sender's.
+**
+*/
+static SbBufDesc_t* NewBuf(size_t Size)
+{
+
+   SbBufDesc_t* Desc = malloc(offsetof(SbBufDesc_t, Buf) + (Size > sizeof(CFE_SB_Buffer_t) ? Size : sizeof(CFE_SB_Buffer_t)));
+
+   if (Desc != NULL)
+   {
+      Desc->RefCnt = 1;
+      Desc->Size   = Size;
+      __atomic_fetch_add(&Stats.BufAllocCnt, 1, __ATOMIC_RELAXED);
+      __atomic_fetch_add(&Stats.BufInUseCnt, 1, __ATOMIC_RELAXED);
+   }
+
+   return Desc;
+
+} /* End NewBuf() */
+
+
+/******************************************************************************
+** Function: PutUint16
+**
+*/
+static void PutUint16(uint8* Byte, uint16 Value)
+{
+
+   Byte[0] = Value >> 8;
+   Byte[1] = Value & 0xFF;
+
+} /* End PutUint16() */
+
+
+/******************************************************************************
+** Function: ReleaseBuf
+**
+** Notes:
+**   1. Caller must hold SbMutex.
+**
+*/
+static void ReleaseBuf(SbBufDesc_t* Desc)
+{
+
+   if (--Desc->RefCnt == 0)
+   {
+      __atomic_fetch_sub(&Stats.BufInUseCnt, 1, __ATOMIC_RELAXED);
+      free(Desc);
+   }
+
+} /* End ReleaseBuf() */
+
+
+/******************************************************************************
+** Function: Route
+**
+** Queue a buffer on every pipe subscribed to its message ID
+**
+** Notes:
+**   1. Takes the sender's reference. With Wait true the sender waits for
+**      room in a full pipe, otherwise the pipe's copy is dropped.
+**
+*/
+static CFE_Status_t Route(SbBufDesc_t* Desc, bool IncrementSequenceCount, bool Wait)
+{
+
+   CFE_SB_MsgId_t MsgId;
+   SbPipe_t*   SbPipe;
+   SbSeqCnt_t* Entry;
+   bool   Routed = false;
+   uint16 i;
+
+   CFE_MSG_GetMsgId(&Desc->Buf.Msg, &MsgId);
+
+   pthread_mutex_lock(&SbMutex);
+
+   Entry = GetSeqCnt(MsgId);
+   if (Entry != NULL)
+   {
+      Entry->MsgCnt++;
+      if (IncrementSequenceCount)
+      {
+         SetSeqCnt(&Desc->Buf.Msg, Entry);
+      }
+   }
+   Stats.MsgCnt++;
+   Stats.MsgByteCnt += Desc->Size;
+
+   for (i=0; i < SubCnt; i++)
+   {
+      if (Sub[i].MsgId != MsgId)
+      {
+         continue;
+      }
+      SbPipe = GetPipe(Sub[i].PipeId);
+      while (Wait && SbPipe->Count >= SbPipe->Depth && !EsStop)
+      {
+         pthread_cond_wait(&SpaceCond, &SbMutex);
+      }
+      if (SbPipe->Count < SbPipe->Depth)
+      {
+         SbPipe->Queue[(SbPipe->Head + SbPipe->Count) % SB_MAX_PIPE_DEPTH] = Desc;
+         SbPipe->Count++;
+         Desc->RefCnt++;
+         pthread_cond_signal(&SbPipe->MsgCond);
+      }
+      else
+      {
+         Stats.PipeOverflowCnt++;
+      }
+      Routed = true;
+   }
+   if (!Routed)
+   {
+      Stats.NoSubscriberCnt++;
+   }
+
+   ReleaseBuf(Desc);
+
+   pthread_mutex_unlock(&SbMutex);
+
+   return CFE_SUCCESS;
+
+} /* End Route() */
+
+
+/******************************************************************************
+** Function: SetSeqCnt
+**
+** Notes:
+**   1. Caller must hold SbMutex.
+**
+*/
+static void SetSeqCnt(CFE_MSG_Message_t *MsgPtr, SbSeqCnt_t* Entry)
+{
+
+   PutUint16(&MsgPtr->Byte[2], CCSDS_SEQ_FLAGS | Entry->SeqCnt);
+   Entry->SeqCnt = (Entry->SeqCnt + 1) & SB_SEQ_CNT_MASK;
+
+} /* End SetSeqCnt() */
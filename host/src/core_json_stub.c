@@ -0,0 +1,335 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Implement the coreJSON search function for the host build
+**
+**  Notes:
+**    1. Each query segment skips the values before the match, nothing is
+**       allocated or copied.
+**
+*/
+
+/*
+** Include Files:
+*/
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "core_json.h"
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+typedef struct
+{
+
+   const char*  Buf;
+   size_t       Len;
+   size_t       Pos;
+
+} Doc_t;
+
+
+/*******************************/
+/** Local Function Prototypes **/
+/*******************************/
+
+static bool FindKey(Doc_t* Doc, const char* Key, size_t KeyLen);
+static bool FindIndex(Doc_t* Doc, size_t Index);
+static bool SkipString(Doc_t* Doc);
+static bool SkipValue(Doc_t* Doc);
+static void SkipSpace(Doc_t* Doc);
+
+
+/******************************************************************************
+** Function: JSON_Search
+**
+*/
+JSONStatus_t JSON_Search(char* Buf, size_t Max, const char* Query, size_t QueryLength,
+                         char** OutValue, size_t* OutValueLength)
+{
+
+   Doc_t  Doc = { Buf, Max, 0 };
+   size_t q = 0;
+   size_t KeyStart;
+   size_t Start;
+   char*  End;
+
+   if (Buf == NULL || Query == NULL || OutValue == NULL || OutValueLength == NULL)
+   {
+      return JSONNullParameter;
+   }
+   if (Max == 0 || QueryLength == 0)
+   {
+      return JSONBadParameter;
+   }
+
+   while (q < QueryLength)
+   {
+
+      if (Query[q] == '[')
+      {
+         if (!FindIndex(&Doc, strtoul(&Query[q+1], &End, 10)) || *End != ']')
+         {
+            return JSONNotFound;
+         }
+         q = End - Query + 1;
+      }
+      else
+      {
+         KeyStart = q;
+         while (q < QueryLength && Query[q] != '.' && Query[q] != '[')
+         {
+            q++;
+         }
+         if (!FindKey(&Doc, &Query[KeyStart], q - KeyStart))
+         {
+            return JSONNotFound;
+         }
+      }
+      if (q < QueryLength && Query[q] == '.')
+      {
+         q++;
+      }
+
+   } /* End query loop */
+
+   SkipSpace(&Doc);
+   Start = Doc.Pos;
+   if (!SkipValue(&Doc))
+   {
+      return JSONIllegalDocument;
+   }
+
+   if (Buf[Start] == '"')
+   {
+      *OutValue       = &Buf[Start+1];
+      *OutValueLength = Doc.Pos - Start - 2;
+   }
+   else
+   {
+      *OutValue       = &Buf[Start];
+      *OutValueLength = Doc.Pos - Start;
+   }
+
+   return JSONSuccess;
+
+} /* End JSON_Search() */
+
+
+/******************************************************************************
+** Function: FindIndex
+**
+** Move from the start of an array to the start of its Index entry
+**
+*/
+static bool FindIndex(Doc_t* Doc, size_t Index)
+{
+
+   size_t i;
+
+   SkipSpace(Doc);
+   if (Doc->Pos >= Doc->Len || Doc->Buf[Doc->Pos] != '[')
+   {
+      return false;
+   }
+   Doc->Pos++;
+
+   for (i=0; i < Index; i++)
+   {
+      SkipSpace(Doc);
+      if (!SkipValue(Doc))
+      {
+         return false;
+      }
+      SkipSpace(Doc);
+      if (Doc->Pos >= Doc->Len || Doc->Buf[Doc->Pos] != ',')
+      {
+         return false;
+      }
+      Doc->Pos++;
+   }
+
+   SkipSpace(Doc);
+
+   return (Doc->Pos < Doc->Len && Doc->Buf[Doc->Pos] != ']');
+
+} /* End FindIndex() */
+
+
+/******************************************************************************
+** Function: FindKey
+**
+** Move from the start of an object to the value of its Key member
+**
+*/
+static bool FindKey(Doc_t* Doc, const char* Key, size_t KeyLen)
+{
+
+   size_t Start;
+   bool   Match;
+
+   SkipSpace(Doc);
+   if (Doc->Pos >= Doc->Len || Doc->Buf[Doc->Pos] != '{')
+   {
+      return false;
+   }
+   Doc->Pos++;
+
+   while (true)
+   {
+
+      SkipSpace(Doc);
+      if (Doc->Pos >= Doc->Len || Doc->Buf[Doc->Pos] != '"')
+      {
+         return false;
+      }
+      Start = Doc->Pos + 1;
+      if (!SkipString(Doc))
+      {
+         return false;
+      }
+      Match = (Doc->Pos - Start - 1 == KeyLen) && strncmp(&Doc->Buf[Start], Key, KeyLen) == 0;
+
+      SkipSpace(Doc);
+      if (Doc->Pos >= Doc->Len || Doc->Buf[Doc->Pos] != ':')
+      {
+         return false;
+      }
+      Doc->Pos++;
+      SkipSpace(Doc);
+      if (Match)
+      {
+         return true;
+      }
+
+      if (!SkipValue(Doc))
+      {
+         return false;
+      }
+      SkipSpace(Doc);
+      if (Doc->Pos >= Doc->Len || Doc->Buf[Doc->Pos] != ',')
+      {
+         return false;
+      }
+      Doc->Pos++;
+
+   } /* End member loop */
+
+} /* End FindKey() */
+
+
+/******************************************************************************
+** Function: SkipSpace
+**
+*/
+static void SkipSpace(Doc_t* Doc)
+{
+
+   while (Doc->Pos < Doc->Len && Doc->Buf[Doc->Pos] != '\0' && strchr(" \t\r\n", Doc->Buf[Doc->Pos]) != NULL)
+   {
+      Doc->Pos++;
+   }
+
+} /* End SkipSpace() */
+
+
+/******************************************************************************
+** Function: SkipString
+**
+** Move past the closing quote of the string at Pos
+**
+*/
+static bool SkipString(Doc_t* Doc)
+{
+
+   Doc->Pos++;
+   while (Doc->Pos < Doc->Len && Doc->Buf[Doc->Pos] != '"')
+   {
+      Doc->Pos += (Doc->Buf[Doc->Pos] == '\\') ? 2 : 1;
+   }
+   if (Doc->Pos >= Doc->Len)
+   {
+      return false;
+   }
+   Doc->Pos++;
+
+   return true;
+
+} /* End SkipString() */
+
+
+/******************************************************************************
+** Function: SkipValue
+**
+** Move past the value at Pos
+**
+*/
+static bool SkipValue(Doc_t* Doc)
+{
+
+   uint32_t Depth = 0;
+   char     c;
+
+   while (Doc->Pos < Doc->Len)
+   {
+
+      c = Doc->Buf[Doc->Pos];
+      if (c == '"')
+      {
+         if (!SkipString(Doc))
+         {
+            return false;
+         }
+         if (Depth == 0)
+         {
+            return true;
+         }
+         continue;
+      }
+
+      if (c == '{' || c == '[')
+      {
+         Depth++;
+      }
+      else if (c == '}' || c == ']')
+      {
+         if (Depth == 0)
+         {
+            return true;   /* Primitive ended by its container */
+         }
+         Doc->Pos++;
+         if (--Depth == 0)
+         {
+            return true;
+         }
+         continue;
+      }
+      else if (Depth == 0 && (c == ',' || strchr(" \t\r\n", c) != NULL))
+      {
+         return true;
+      }
+      Doc->Pos++;
+
+   } /* End character loop */
+
+   return (Depth == 0);
+
+} /* End SkipValue() */
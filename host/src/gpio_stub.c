@@ -0,0 +1,60 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Implement the pi_iolib GPIO functions for the host build
+**
+**  Notes:
+**    1. See gpio.h.
+**
+*/
+
+/*
+** Include Files:
+*/
+
+#include "gpio.h"
+
+
+/******************************************************************************
+** Function: gpio_in
+**
+*/
+void gpio_in(unsigned Pin)
+{
+
+} /* End gpio_in() */
+
+
+/******************************************************************************
+** Function: gpio_map
+**
+*/
+int gpio_map(void)
+{
+
+   return -1;
+
+} /* End gpio_map() */
+
+
+/******************************************************************************
+** Function: gpio_out
+**
+*/
+void gpio_out(unsigned Pin)
+{
+
+} /* End gpio_out() */
+
@@ -0,0 +1,598 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Implement the OpenSatKit C framework components used by the app for
+**    the host build
+**
+**  Notes:
+**    1. CMDMGR, TBLMGR and CJSON behave like the framework's for valid
+**       input with shorter event messages.
+**    2. INITBL reads "config.<name>" for every parameter and fails if one
+**       is missing. Every value is kept as a string and as an integer.
+**
+*/
+
+/*
+** Include Files:
+*/
+
+#define _GNU_SOURCE    /* pthread_setname_np() */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "childmgr.h"
+#include "cjson.h"
+#include "host_stub.h"
+#include "initbl.h"
+#include "tblmgr.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define OSK_STUB_EID  (OSK_C_FW_APP_BASE_EID - 1)   /* All framework events */
+
+#define MAX_CHILD_TASKS    8
+#define MAX_INI_OVERRIDES  32
+#define INI_QUERY_MAX_LEN  80
+#define INI_FILE_MAX_CHAR  16384
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+typedef struct
+{
+
+   char  Name[INI_QUERY_MAX_LEN];
+   char  Value[INITBL_MAX_CFG_STR_LEN];
+
+} IniOverride_t;
+
+
+/**********************/
+/** Global File Data **/
+/**********************/
+
+static pthread_mutex_t   ChildMutex = PTHREAD_MUTEX_INITIALIZER;
+static CHILDMGR_Class_t* ChildTask[MAX_CHILD_TASKS];
+static uint16            ChildTaskCnt;
+
+static IniOverride_t IniOverride[MAX_INI_OVERRIDES];
+static uint16        IniOverrideCnt;
+
+static char IniJsonBuf[INI_FILE_MAX_CHAR];
+
+
+/*******************************/
+/** Local Function Prototypes **/
+/*******************************/
+
+static void* ChildTaskMain(void* Arg);
+static const IniOverride_t* FindIniOverride(const char* Name);
+static size_t ReadFile(const char* Filename, char* Buf, size_t MaxChar);
+
+
+/******************************************************************************
+** Function: ChildMgr_TaskMainCallback
+**
+** Notes:
+**   1. Only its address is used, CHILDMGR_Constructor() starts the task
+**      with ChildTaskMain().
+**
+*/
+void ChildMgr_TaskMainCallback(void)
+{
+
+} /* End ChildMgr_TaskMainCallback() */
+
+
+/******************************************************************************
+** Function: CHILDMGR_Constructor
+**
+*/
+int32 CHILDMGR_Constructor(CHILDMGR_Class_t* ChildMgr, CFE_ES_ChildTaskMainFuncPtr_t ChildTaskMainFunc,
+                           CHILDMGR_TaskCallback_t AppMainCallback, CHILDMGR_TaskInit_t* TaskInit)
+{
+
+   char ThreadName[16];
+
+   memset(ChildMgr, 0, sizeof(CHILDMGR_Class_t));
+   ChildMgr->TaskCallback = AppMainCallback;
+
+   pthread_mutex_lock(&ChildMutex);
+   if (ChildTaskCnt < MAX_CHILD_TASKS &&
+       pthread_create(&ChildMgr->Thread, NULL, ChildTaskMain, ChildMgr) == 0)
+   {
+      ChildMgr->Started = true;
+      ChildTask[ChildTaskCnt++] = ChildMgr;
+      snprintf(ThreadName, sizeof(ThreadName), "%s", TaskInit->TaskName);
+      pthread_setname_np(ChildMgr->Thread, ThreadName);
+   }
+   pthread_mutex_unlock(&ChildMutex);
+
+   if (!ChildMgr->Started)
+   {
+      CFE_EVS_SendEvent(OSK_STUB_EID, CFE_EVS_EventType_ERROR,
+                        "Child task %s creation failed", TaskInit->TaskName);
+      return OSK_C_FW_CFS_ERROR;
+   }
+
+   return CFE_SUCCESS;
+
+} /* End CHILDMGR_Constructor() */
+
+
+/******************************************************************************
+** Function: CHILDMGR_ResetStatus
+**
+*/
+void CHILDMGR_ResetStatus(CHILDMGR_Class_t* ChildMgr)
+{
+
+   ChildMgr->ValidCmdCnt   = 0;
+   ChildMgr->InvalidCmdCnt = 0;
+
+} /* End CHILDMGR_ResetStatus() */
+
+
+/******************************************************************************
+** Function: CJSON_ProcessFile
+**
+*/
+bool CJSON_ProcessFile(const char* Filename, char* JsonBuf, size_t MaxJsonFileChar, CJSON_LoadJsonData_t LoadJsonData)
+{
+
+   size_t JsonFileLen = ReadFile(Filename, JsonBuf, MaxJsonFileChar);
+
+   if (JsonFileLen == 0)
+   {
+      CFE_EVS_SendEvent(OSK_STUB_EID, CFE_EVS_EventType_ERROR,
+                        "JSON file %s is empty, missing or longer than %lu characters",
+                        Filename, (unsigned long)MaxJsonFileChar);
+      return false;
+   }
+
+   return LoadJsonData(JsonFileLen);
+
+} /* End CJSON_ProcessFile() */
+
+
+/******************************************************************************
+** Function: CMDMGR_Constructor
+**
+*/
+void CMDMGR_Constructor(CMDMGR_Class_t* CmdMgr)
+{
+
+   memset(CmdMgr, 0, sizeof(CMDMGR_Class_t));
+
+} /* End CMDMGR_Constructor() */
+
+
+/******************************************************************************
+** Function: CMDMGR_DispatchFunc
+**
+*/
+bool CMDMGR_DispatchFunc(CMDMGR_Class_t* CmdMgr, const CFE_MSG_Message_t *MsgPtr)
+{
+
+   bool ValidCmd = false;
+   CFE_MSG_FcnCode_t FuncCode;
+   CFE_MSG_Size_t    MsgLen;
+   const CMDMGR_Cmd_t* Cmd;
+
+   CFE_MSG_GetFcnCode(MsgPtr, &FuncCode);
+   CFE_MSG_GetSize(MsgPtr, &MsgLen);
+
+   if (FuncCode < CMDMGR_CMD_FUNC_TOTAL && CmdMgr->Cmd[FuncCode].FuncPtr != NULL)
+   {
+      Cmd = &CmdMgr->Cmd[FuncCode];
+      if (MsgLen == sizeof(CFE_MSG_CommandHeader_t) + Cmd->UserDataLen)
+      {
+         ValidCmd = Cmd->FuncPtr(Cmd->ObjDataPtr, MsgPtr);
+      }
+      else
+      {
+         CFE_EVS_SendEvent(OSK_STUB_EID, CFE_EVS_EventType_ERROR,
+                           "Invalid command length %lu for function code %u, expected %lu", (unsigned long)MsgLen,
+                           FuncCode, (unsigned long)(sizeof(CFE_MSG_CommandHeader_t) + Cmd->UserDataLen));
+      }
+   }
+   else
+   {
+      CFE_EVS_SendEvent(OSK_STUB_EID, CFE_EVS_EventType_ERROR,
+                        "Invalid command function code %u", FuncCode);
+   }
+
+   if (ValidCmd)
+   {
+      CmdMgr->ValidCmdCnt++;
+   }
+   else
+   {
+      CmdMgr->InvalidCmdCnt++;
+   }
+
+   return ValidCmd;
+
+} /* End CMDMGR_DispatchFunc() */
+
+
+/******************************************************************************
+** Function: CMDMGR_RegisterFunc
+**
+*/
+bool CMDMGR_RegisterFunc(CMDMGR_Class_t* CmdMgr, uint16 FuncCode, void* ObjDataPtr,
+                         CMDMGR_CmdFuncPtr_t ObjFuncPtr, uint16 UserDataLen)
+{
+
+   if (FuncCode >= CMDMGR_CMD_FUNC_TOTAL)
+   {
+      CFE_EVS_SendEvent(OSK_STUB_EID, CFE_EVS_EventType_ERROR,
+                        "Attempt to register function code %u, the maximum is %u",
+                        FuncCode, CMDMGR_CMD_FUNC_TOTAL-1);
+      return false;
+   }
+
+   CmdMgr->Cmd[FuncCode].ObjDataPtr  = ObjDataPtr;
+   CmdMgr->Cmd[FuncCode].FuncPtr     = ObjFuncPtr;
+   CmdMgr->Cmd[FuncCode].UserDataLen = UserDataLen;
+
+   return true;
+
+} /* End CMDMGR_RegisterFunc() */
+
+
+/******************************************************************************
+** Function: CMDMGR_ResetStatus
+**
+*/
+void CMDMGR_ResetStatus(CMDMGR_Class_t* CmdMgr)
+{
+
+   CmdMgr->ValidCmdCnt   = 0;
+   CmdMgr->InvalidCmdCnt = 0;
+
+} /* End CMDMGR_ResetStatus() */
+
+
+/******************************************************************************
+** Function: INITBL_Constructor
+**
+*/
+bool INITBL_Constructor(INITBL_Class_t* IniTbl, const char* IniFile, INILIB_CfgEnum_t* IniCfgEnum)
+{
+
+   const IniOverride_t* Override;
+   INITBL_CfgItem_t* Item;
+   size_t JsonFileLen;
+   char   Query[INI_QUERY_MAX_LEN];
+   char*  JsonVal;
+   size_t JsonValLen;
+   bool   RetStatus = true;
+   uint16 i;
+
+   memset(IniTbl, 0, sizeof(INITBL_Class_t));
+   IniTbl->CfgEnum = IniCfgEnum;
+
+   if (IniCfgEnum->Cnt > INITBL_MAX_CFG_ITEMS)
+   {
+      CFE_EVS_SendEvent(OSK_STUB_EID, CFE_EVS_EventType_ERROR,
+                        "%u ini parameters exceeds the limit of %u", IniCfgEnum->Cnt, INITBL_MAX_CFG_ITEMS);
+      return false;
+   }
+
+   JsonFileLen = ReadFile(IniFile, IniJsonBuf, sizeof(IniJsonBuf));
+   if (JsonFileLen == 0)
+   {
+      CFE_EVS_SendEvent(OSK_STUB_EID, CFE_EVS_EventType_ERROR, "Error reading ini file %s", IniFile);
+      return false;
+   }
+
+   for (i=1; i < IniCfgEnum->Cnt; i++)
+   {
+
+      Item = &IniTbl->Item[i];
+      Override = FindIniOverride(IniCfgEnum->Str[i]);
+      if (Override != NULL)
+      {
+         strncpy(Item->Str, Override->Value, INITBL_MAX_CFG_STR_LEN-1);
+      }
+      else
+      {
+         snprintf(Query, sizeof(Query), "config.%s", IniCfgEnum->Str[i]);
+         if (JSON_Search(IniJsonBuf, JsonFileLen, Query, strlen(Query), &JsonVal, &JsonValLen) != JSONSuccess ||
+             JsonValLen >= INITBL_MAX_CFG_STR_LEN)
+         {
+            CFE_EVS_SendEvent(OSK_STUB_EID, CFE_EVS_EventType_ERROR,
+                              "Ini file %s parameter %s is missing or too long", IniFile, IniCfgEnum->Str[i]);
+            RetStatus = false;
+            continue;
+         }
+         memcpy(Item->Str, JsonVal, JsonValLen);
+         Item->Str[JsonValLen] = '\0';
+      }
+      Item->Int = strtoul(Item->Str, NULL, 10);
+
+   } /* End parameter loop */
+
+   return RetStatus;
+
+} /* End INITBL_Constructor() */
+
+
+/******************************************************************************
+** Function: INITBL_GetIntConfig
+**
+*/
+uint32 INITBL_GetIntConfig(INITBL_Class_t* IniTbl, uint16 Param)
+{
+
+   return (Param < IniTbl->CfgEnum->Cnt) ? IniTbl->Item[Param].Int : 0;
+
+} /* End INITBL_GetIntConfig() */
+
+
+/******************************************************************************
+** Function: INITBL_GetStrConfig
+**
+*/
+const char* INITBL_GetStrConfig(INITBL_Class_t* IniTbl, uint16 Param)
+{
+
+   return (Param < IniTbl->CfgEnum->Cnt) ? IniTbl->Item[Param].Str : "";
+
+} /* End INITBL_GetStrConfig() */
+
+
+/******************************************************************************
+** Function: TBLMGR_Constructor
+**
+*/
+void TBLMGR_Constructor(TBLMGR_Class_t* TblMgr)
+{
+
+   memset(TblMgr, 0, sizeof(TBLMGR_Class_t));
+
+} /* End TBLMGR_Constructor() */
+
+
+/******************************************************************************
+** Function: TBLMGR_DumpTblCmd
+**
+*/
+bool TBLMGR_DumpTblCmd(void* ObjDataPtr, const CFE_MSG_Message_t *MsgPtr)
+{
+
+   TBLMGR_Class_t* TblMgr = (TBLMGR_Class_t*)ObjDataPtr;
+   const OSK_C_FW_DumpTbl_Payload_t* Cmd = (const OSK_C_FW_DumpTbl_Payload_t*)((const uint8*)MsgPtr + sizeof(CFE_MSG_CommandHeader_t));
+   TBLMGR_Tbl_t* Tbl;
+
+   if (Cmd->Id >= TblMgr->NextAvailableId)
+   {
+      CFE_EVS_SendEvent(OSK_STUB_EID, CFE_EVS_EventType_ERROR,
+                        "Dump table command rejected, invalid table ID %u", Cmd->Id);
+      return false;
+   }
+
+   Tbl = &TblMgr->Tbl[Cmd->Id];
+   Tbl->LastAction       = TBLMGR_ACTION_DUMP;
+   Tbl->LastActionStatus = Tbl->DumpFuncPtr(Tbl, 0, Cmd->Filename) ? TBLMGR_STATUS_VALID : TBLMGR_STATUS_INVALID;
+
+   return (Tbl->LastActionStatus == TBLMGR_STATUS_VALID);
+
+} /* End TBLMGR_DumpTblCmd() */
+
+
+/******************************************************************************
+** Function: TBLMGR_LoadTblCmd
+**
+*/
+bool TBLMGR_LoadTblCmd(void* ObjDataPtr, const CFE_MSG_Message_t *MsgPtr)
+{
+
+   TBLMGR_Class_t* TblMgr = (TBLMGR_Class_t*)ObjDataPtr;
+   const OSK_C_FW_LoadTbl_Payload_t* Cmd = (const OSK_C_FW_LoadTbl_Payload_t*)((const uint8*)MsgPtr + sizeof(CFE_MSG_CommandHeader_t));
+   TBLMGR_Tbl_t* Tbl;
+
+   if (Cmd->Id >= TblMgr->NextAvailableId)
+   {
+      CFE_EVS_SendEvent(OSK_STUB_EID, CFE_EVS_EventType_ERROR,
+                        "Load table command rejected, invalid table ID %u", Cmd->Id);
+      return false;
+   }
+
+   Tbl = &TblMgr->Tbl[Cmd->Id];
+   Tbl->LastAction       = TBLMGR_ACTION_LOAD;
+   Tbl->LastActionStatus = Tbl->LoadFuncPtr(Tbl, Cmd->Type, Cmd->Filename) ? TBLMGR_STATUS_VALID : TBLMGR_STATUS_INVALID;
+   if (Tbl->LastActionStatus == TBLMGR_STATUS_VALID)
+   {
+      Tbl->Loaded = true;
+   }
+
+   return (Tbl->LastActionStatus == TBLMGR_STATUS_VALID);
+
+} /* End TBLMGR_LoadTblCmd() */
+
+
+/******************************************************************************
+** Function: TBLMGR_LoadTypeStr
+**
+*/
+const char* TBLMGR_LoadTypeStr(int8 LoadType)
+{
+
+   return (LoadType == TBLMGR_LOAD_TBL_REPLACE) ? "Replace" :
+          (LoadType == TBLMGR_LOAD_TBL_UPDATE)  ? "Update"  : "Undefined";
+
+} /* End TBLMGR_LoadTypeStr() */
+
+
+/******************************************************************************
+** Function: TBLMGR_RegisterTblWithDef
+**
+** Notes:
+**   1. The default table is loaded as a replacement and a load failure
+**      leaves the table registered but not loaded.
+**
+*/
+uint8 TBLMGR_RegisterTblWithDef(TBLMGR_Class_t* TblMgr, TBLMGR_LoadTblFuncPtr_t LoadFuncPtr,
+                                TBLMGR_DumpTblFuncPtr_t DumpFuncPtr, const char* TblFilename)
+{
+
+   TBLMGR_Tbl_t* Tbl;
+
+   if (TblMgr->NextAvailableId >= TBLMGR_MAX_TBL_PER_APP)
+   {
+      CFE_EVS_SendEvent(OSK_STUB_EID, CFE_EVS_EventType_ERROR,
+                        "Table registration rejected, %u tables already registered", TBLMGR_MAX_TBL_PER_APP);
+      return TBLMGR_MAX_TBL_PER_APP;
+   }
+
+   Tbl = &TblMgr->Tbl[TblMgr->NextAvailableId];
+   Tbl->Id          = TblMgr->NextAvailableId++;
+   Tbl->LoadFuncPtr = LoadFuncPtr;
+   Tbl->DumpFuncPtr = DumpFuncPtr;
+
+   Tbl->LastAction       = TBLMGR_ACTION_LOAD;
+   Tbl->Loaded           = LoadFuncPtr(Tbl, TBLMGR_LOAD_TBL_REPLACE, TblFilename);
+   Tbl->LastActionStatus = Tbl->Loaded ? TBLMGR_STATUS_VALID : TBLMGR_STATUS_INVALID;
+
+   return Tbl->Id;
+
+} /* End TBLMGR_RegisterTblWithDef() */
+
+
+/******************************************************************************
+** Function: HOST_JoinChildTasks
+**
+*/
+void HOST_JoinChildTasks(void)
+{
+
+   uint16 i;
+
+   pthread_mutex_lock(&ChildMutex);
+   for (i=0; i < ChildTaskCnt; i++)
+   {
+      pthread_join(ChildTask[i]->Thread, NULL);
+      ChildTask[i]->Started = false;
+   }
+   ChildTaskCnt = 0;
+   pthread_mutex_unlock(&ChildMutex);
+
+} /* End HOST_JoinChildTasks() */
+
+
+/******************************************************************************
+** Function: HOST_SetIniConfig
+**
+*/
+bool HOST_SetIniConfig(const char* Name, const char* Value)
+{
+
+   IniOverride_t* Override = (IniOverride_t*)FindIniOverride(Name);
+
+   if (Override == NULL)
+   {
+      if (IniOverrideCnt >= MAX_INI_OVERRIDES)
+      {
+         return false;
+      }
+      Override = &IniOverride[IniOverrideCnt++];
+      strncpy(Override->Name, Name, sizeof(Override->Name)-1);
+   }
+   strncpy(Override->Value, Value, sizeof(Override->Value)-1);
+
+   return true;
+
+} /* End HOST_SetIniConfig() */
+
+
+/******************************************************************************
+** Function: ChildTaskMain
+**
+*/
+static void* ChildTaskMain(void* Arg)
+{
+
+   CHILDMGR_Class_t* ChildMgr = (CHILDMGR_Class_t*)Arg;
+
+   while (ChildMgr->TaskCallback(ChildMgr))
+   {
+   }
+
+   return NULL;
+
+} /* End ChildTaskMain() */
+
+
+/******************************************************************************
+** Function: FindIniOverride
+**
+*/
+static const IniOverride_t* FindIniOverride(const char* Name)
+{
+
+   uint16 i;
+
+   for (i=0; i < IniOverrideCnt; i++)
+   {
+      if (strcmp(IniOverride[i].Name, Name) == 0)
+      {
+         return &IniOverride[i];
+      }
+   }
+
+   return NULL;
+
+} /* End FindIniOverride() */
+
+
+/******************************************************************************
+** Function: ReadFile
+**
+** Read a file into Buf and return its length
+**
+** Notes:
+**   1. Returns 0 if the file can't be read or doesn't fit in MaxChar-1
+**      characters. Buf is null terminated.
+**
+*/
+static size_t ReadFile(const char* Filename, char* Buf, size_t MaxChar)
+{
+
+   char   HostPath[OS_MAX_PATH_LEN*2];
+   FILE*  File = fopen(HOST_MapPath(Filename, HostPath, sizeof(HostPath)), "r");
+   size_t Len  = 0;
+
+   if (File != NULL)
+   {
+      Len = fread(Buf, 1, MaxChar, File);
+      fclose(File);
+      if (Len >= MaxChar)
+      {
+         Len = 0;
+      }
+      Buf[Len] = '\0';
+   }
+
+   return Len;
+
+} /* End ReadFile() */